@@ -20,6 +20,7 @@
     physical_quantities
 */
 
+#include <units/engineering.h>
 #include <units/physical/si/si.h>
 #include <units/math.h>
 #include <iostream>
@@ -40,18 +41,6 @@ int main()
   for (auto t = 0_q_ms; t <= 50_q_ms; ++t) {
     const Voltage auto Vt = V0 * units::exp(-t / (R * C));
 
-    std::cout << "at " << t << " voltage is ";
-
-    if (Vt >= 1_q_V)
-      std::cout << Vt;
-    else if (Vt >= 1_q_mV)
-      std::cout << quantity_cast<millivolt>(Vt);
-    else if (Vt >= 1_q_uV)
-      std::cout << quantity_cast<microvolt>(Vt);
-    else if (Vt >= 1_q_nV)
-      std::cout << quantity_cast<nanovolt>(Vt);
-    else
-      std::cout << quantity_cast<picovolt>(Vt);
-    std::cout << "\n";
+    std::cout << "at " << t << " voltage is " << units::to_engineering(Vt) << "\n";
   }
 }
@@ -20,111 +20,15 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <units/measurement.h>
 #include <units/physical/si/si.h>
-#include <cmath>
-#include <compare>
 #include <iostream>
 
 namespace {
 
-// root sum of squares
-template<typename T>
-T rss(const T& v1, const T& v2)
-{
-  return std::sqrt(std::pow(v1, 2) + std::pow(v2, 2));
-}
-
-template<class T>
-class measurement {
-public:
-  using value_type = T;
-
-  measurement() = default;
-
-  constexpr explicit measurement(const value_type& val, const value_type& err = {}) :
-      value_(val),
-      uncertainty_(std::abs(err))
-  {
-  }
-
-  constexpr const value_type& value() const { return value_; }
-  constexpr const value_type& uncertainty() const { return uncertainty_; }
-
-  constexpr value_type relative_uncertainty() const { return uncertainty() / value(); }
-  constexpr value_type lower_bound() const { return value() - uncertainty(); }
-  constexpr value_type upper_bound() const { return value() + uncertainty(); }
-
-  [[nodiscard]] constexpr measurement operator-() const { return measurement(-value(), uncertainty()); }
-
-  [[nodiscard]] friend constexpr measurement operator+(const measurement& lhs, const measurement& rhs)
-  {
-    return measurement(lhs.value() + rhs.value(), rss(lhs.uncertainty(), rhs.uncertainty()));
-  }
-
-  [[nodiscard]] friend constexpr measurement operator-(const measurement& lhs, const measurement& rhs)
-  {
-    return measurement(lhs.value() - rhs.value(), rss(lhs.uncertainty(), rhs.uncertainty()));
-  }
-
-  [[nodiscard]] friend constexpr measurement operator*(const measurement& lhs, const measurement& rhs)
-  {
-    const auto val = lhs.value() * rhs.value();
-    return measurement(val, val * rss(lhs.relative_uncertainty(), rhs.relative_uncertainty()));
-  }
-
-  [[nodiscard]] friend constexpr measurement operator*(const measurement& lhs, const value_type& value)
-  {
-    const auto val = lhs.value() * value;
-    return measurement(val, val * lhs.relative_uncertainty());
-  }
-
-  [[nodiscard]] friend constexpr measurement operator*(const value_type& value, const measurement& rhs)
-  {
-    const auto val = rhs.value() * value;
-    return measurement(val, val * rhs.relative_uncertainty());
-  }
-
-  [[nodiscard]] friend constexpr measurement operator/(const measurement& lhs, const measurement& rhs)
-  {
-    const auto val = lhs.value() / rhs.value();
-    return measurement(val, val * rss(lhs.relative_uncertainty(), rhs.relative_uncertainty()));
-  }
-
-  [[nodiscard]] friend constexpr measurement operator/(const measurement& lhs, const value_type& value)
-  {
-    const auto val = lhs.value() / value;
-    return measurement(val, val * lhs.relative_uncertainty());
-  }
-
-  [[nodiscard]] friend constexpr measurement operator/(const value_type& value, const measurement& rhs)
-  {
-    const auto val = value / rhs.value();
-    return measurement(val, val * rhs.relative_uncertainty());
-  }
-
-  [[nodiscard]] constexpr auto operator<=>(const measurement&) const = default;
-
-  friend std::ostream& operator<<(std::ostream& os, const measurement& v)
-  {
-    return os << v.value() << " ± " << v.uncertainty();
-  }
-
-private:
-  value_type value_{};
-  value_type uncertainty_{};
-};
-
-static_assert(units::ScalableNumber<measurement<double>>);
-
-}  // namespace
-
-template<typename T>
-inline constexpr bool units::treat_as_floating_point<measurement<T>> = std::is_floating_point_v<T>;
-
-namespace {
-
 void example()
 {
+  using namespace units;
   using namespace units::physical;
 
   const auto a = si::acceleration<si::metre_per_second_sq, measurement<double>>(measurement(9.8, 0.1));
@@ -0,0 +1,173 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/joining_threads.h>
+#include <units/quantity.h>
+#include <units/quantity_span.h>
+#include <gsl/gsl_assert>
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace units {
+
+/**
+ * @brief α-β filters of many independent tracks processed in batches
+ *
+ * Every track estimates a position and its rate of change from position measurements taken at
+ * regular intervals. The state of all the tracks is stored in contiguous columns (structure of
+ * arrays) so that the `estimate()` and `predict()` steps are simple loops over all the tracks
+ * which the compiler vectorizes. Large batches may be split across threads.
+ *
+ * For a single track the steps are:
+ *
+ *   estimate: innovation = measurement - predicted_position
+ *             estimated_position = predicted_position + alpha * innovation
+ *             estimated_rate = predicted_rate + beta * innovation / interval
+ *   predict:  predicted_position = estimated_position + estimated_rate * interval
+ *             predicted_rate = estimated_rate
+ *
+ * @tparam Position the type of the filtered quantity (i.e. `si::length<si::metre>`)
+ * @tparam Duration the type of the interval between measurements (i.e. `si::time<si::second>`)
+ */
+template<Quantity Position, Quantity Duration>
+  requires std::is_floating_point_v<typename Position::rep> && std::is_floating_point_v<typename Duration::rep>
+class alpha_beta_filter_batch {
+public:
+  using position_type = Position;
+  using duration_type = Duration;
+  using rate_type = decltype(std::declval<Position>() / std::declval<Duration>());
+  using gain_type = TYPENAME Position::rep;
+
+  /// batches smaller than that are never split across threads
+  static constexpr std::size_t min_tracks_per_thread = 4096;
+
+  /**
+   * @param threads the maximum number of threads used by `estimate()` and `predict()`
+   */
+  explicit alpha_beta_filter_batch(unsigned threads = 1) : threads_(std::max(threads, 1u)) {}
+
+  /**
+   * @brief Adds a track
+   *
+   * Both the estimated and the predicted state are set to the initial values.
+   *
+   * @return the index of the track
+   */
+  std::size_t add_track(const Position& position, const rate_type& rate, gain_type alpha, gain_type beta)
+  {
+    estimated_position_.push_back(position);
+    predicted_position_.push_back(position);
+    estimated_rate_.push_back(rate);
+    predicted_rate_.push_back(rate);
+    alpha_.push_back(alpha);
+    beta_.push_back(beta);
+    return size() - 1;
+  }
+
+  void reserve(std::size_t n)
+  {
+    estimated_position_.reserve(n);
+    predicted_position_.reserve(n);
+    estimated_rate_.reserve(n);
+    predicted_rate_.reserve(n);
+    alpha_.reserve(n);
+    beta_.reserve(n);
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return alpha_.size(); }
+
+  /**
+   * @brief Updates the estimates of all the tracks with new measurements
+   *
+   * @param measurements one measurement per track
+   * @param interval the time elapsed since the previous measurements
+   */
+  void estimate(quantity_span<const Position> measurements, const Duration& interval)
+  {
+    Expects(measurements.size() == size());
+    Expects(interval != Duration::zero());
+    // a single division keeps the loop free of per-element checks
+    for_each_block([rate_scale = 1. / interval, z = measurements.data(), xp = predicted_position_.data(), vp = predicted_rate_.data(),
+                    xe = estimated_position_.data(), ve = estimated_rate_.data(), a = alpha_.data(),
+                    b = beta_.data()](std::size_t first, std::size_t last) {
+      // one output column per loop keeps the number of run-time aliasing checks low enough for
+      // the compiler to vectorize both of them
+      for (std::size_t i = first; i < last; ++i) xe[i] = xp[i] + a[i] * (z[i] - xp[i]);
+      for (std::size_t i = first; i < last; ++i) ve[i] = vp[i] + b[i] * (z[i] - xp[i]) * rate_scale;
+    });
+  }
+
+  /**
+   * @brief Predicts the state of all the tracks after `interval`
+   */
+  void predict(const Duration& interval)
+  {
+    for_each_block([interval, xe = estimated_position_.data(), ve = estimated_rate_.data(), xp = predicted_position_.data(),
+                    vp = predicted_rate_.data()](std::size_t first, std::size_t last) {
+      for (std::size_t i = first; i < last; ++i) xp[i] = xe[i] + ve[i] * interval;
+      std::copy(ve + first, ve + last, vp + first);
+    });
+  }
+
+  [[nodiscard]] quantity_span<const Position> estimated_positions() const noexcept { return estimated_position_; }
+  [[nodiscard]] quantity_span<const rate_type> estimated_rates() const noexcept { return estimated_rate_; }
+  [[nodiscard]] quantity_span<const Position> predicted_positions() const noexcept { return predicted_position_; }
+  [[nodiscard]] quantity_span<const rate_type> predicted_rates() const noexcept { return predicted_rate_; }
+  [[nodiscard]] std::span<const gain_type> alphas() const noexcept { return alpha_; }
+  [[nodiscard]] std::span<const gain_type> betas() const noexcept { return beta_; }
+
+private:
+  unsigned threads_;
+  std::vector<Position> estimated_position_;
+  std::vector<Position> predicted_position_;
+  std::vector<rate_type> estimated_rate_;
+  std::vector<rate_type> predicted_rate_;
+  std::vector<gain_type> alpha_;
+  std::vector<gain_type> beta_;
+
+  // runs `f(first, last)` over disjoint ranges of tracks covering all of them
+  // (kernels capture raw pointers to the columns and scalars by value so that they are not
+  // reloaded after every store)
+  template<typename F>
+  void for_each_block(F f) const
+  {
+    const std::size_t n = size();
+    const std::size_t blocks = std::min<std::size_t>(threads_, n / min_tracks_per_thread);
+    if (blocks <= 1) {
+      f(std::size_t(0), n);
+      return;
+    }
+
+    detail::joining_threads workers(blocks - 1);
+    for (std::size_t b = 1; b < blocks; ++b) workers.start(f, n * b / blocks, n * (b + 1) / blocks);
+    f(std::size_t(0), n / blocks);
+  }
+};
+
+}  // namespace units
@@ -0,0 +1,509 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/unit_lookup.h>
+#include <units/serialization.h>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Apache Arrow interoperability
+//
+// Quantities are exchanged through the Arrow C Data Interface so no Arrow library is needed to
+// build against this header (the structures below are the ABI-stable ones from the Arrow
+// specification and are not redefined if Arrow's own `abi.h` was included first).
+//
+// A quantity column is an Arrow primitive array annotated as an extension type named
+// `mp-units.quantity`. Its extension metadata is a JSON object describing the static type of
+// the quantity:
+//
+//   {"dimension":{"L":[1,1],"T":[-1,1]},"ratio":[1,36,1],"unit":"km/h"}
+//
+// where `dimension` maps base dimension symbols to exponents (numerator and denominator),
+// `ratio` is the unit ratio (num, den, exp) relative to the base units, and `unit` is the
+// ASCII symbol of the unit (informational only). Consumers that do not know the extension
+// see a plain primitive array with the metadata attached.
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+  void (*release)(struct ArrowSchema*);
+  void* private_data;
+};
+
+struct ArrowArray {
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+  void (*release)(struct ArrowArray*);
+  void* private_data;
+};
+
+}  // extern "C"
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+namespace units {
+
+/**
+ * @brief An error reported when an Arrow array is not a valid quantity column or does not match the target type
+ */
+class arrow_error : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+inline constexpr std::string_view arrow_extension_name = "mp-units.quantity";
+
+/**
+ * @brief A decoded extension metadata of a quantity column
+ */
+struct arrow_quantity_metadata {
+  std::vector<column_header::exponent_entry> exponents;
+  ratio unit_ratio{1};
+  std::string unit;
+};
+
+namespace detail {
+
+// Arrow format string of a primitive type or `nullptr`
+template<typename Rep>
+[[nodiscard]] consteval const char* arrow_format_of()
+{
+  if constexpr (std::is_same_v<Rep, bool>) {
+    return nullptr;
+  } else if constexpr (std::is_floating_point_v<Rep> && std::numeric_limits<Rep>::is_iec559) {
+    return sizeof(Rep) == 4 ? "f" : sizeof(Rep) == 8 ? "g" : nullptr;
+  } else if constexpr (std::is_integral_v<Rep>) {
+    constexpr const char* s[] = {"c", "s", nullptr, "i", nullptr, nullptr, nullptr, "l"};
+    constexpr const char* u[] = {"C", "S", nullptr, "I", nullptr, nullptr, nullptr, "L"};
+    if constexpr (sizeof(Rep) > 8) return nullptr;
+    else return std::is_signed_v<Rep> ? s[sizeof(Rep) - 1] : u[sizeof(Rep) - 1];
+  } else {
+    return nullptr;
+  }
+}
+
+template<typename Rep>
+concept arrow_primitive = (arrow_format_of<Rep>() != nullptr);
+
+template<typename... Es>
+[[nodiscard]] std::vector<column_header::exponent_entry> exponent_entries(exponent_list<Es...>)
+{
+  return {column_header::exponent_entry{std::string(Es::dimension::symbol.c_str()), Es::num, Es::den}...};
+}
+
+template<Quantity Q>
+[[nodiscard]] arrow_quantity_metadata arrow_metadata_of()
+{
+  return {exponent_entries(typename dimension_exponents<typename Q::dimension>::type{}), quantity_ratio(Q()),
+          std::string(unit_symbol_entry_of<typename Q::dimension, typename Q::unit>.ascii)};
+}
+
+inline void append_json_string(std::string& out, std::string_view s)
+{
+  out += '"';
+  for (const char c : s) {
+    if (c == '"' || c == '\\') out += '\\';
+    out += c;
+  }
+  out += '"';
+}
+
+[[nodiscard]] inline std::string to_json(const arrow_quantity_metadata& m)
+{
+  std::string out = "{\"dimension\":{";
+  for (std::size_t i = 0; i < m.exponents.size(); ++i) {
+    if (i > 0) out += ',';
+    append_json_string(out, m.exponents[i].symbol);
+    out += ":[" + std::to_string(m.exponents[i].num) + ',' + std::to_string(m.exponents[i].den) + ']';
+  }
+  out += "},\"ratio\":[" + std::to_string(m.unit_ratio.num) + ',' + std::to_string(m.unit_ratio.den) + ',' +
+         std::to_string(m.unit_ratio.exp) + "],\"unit\":";
+  append_json_string(out, m.unit);
+  out += '}';
+  return out;
+}
+
+// a parser of the extension metadata (a subset of JSON: objects, arrays, strings, and integers)
+class arrow_metadata_parser {
+  std::string_view text_;
+  std::size_t pos_ = 0;
+
+public:
+  explicit arrow_metadata_parser(std::string_view text) : text_(text) {}
+
+  [[nodiscard]] arrow_quantity_metadata parse()
+  {
+    arrow_quantity_metadata m;
+    bool has_dimension = false, has_ratio = false;
+    object([&](const std::string& key) {
+      if (key == "dimension") {
+        has_dimension = true;
+        object([&](std::string symbol) {
+          const auto e = integers<2>();
+          if (e[1] <= 0) fail();
+          m.exponents.push_back({std::move(symbol), e[0], e[1]});
+        });
+      } else if (key == "ratio") {
+        has_ratio = true;
+        const auto r = integers<3>();
+        if (!detail::valid_unit_ratio(r[0], r[1], r[2])) fail();
+        m.unit_ratio = ratio(r[0], r[1], r[2]);
+      } else if (key == "unit") {
+        m.unit = string();
+      } else {
+        skip_value();
+      }
+    });
+    skip_ws();
+    if (!has_dimension || !has_ratio || pos_ != text_.size()) fail();
+    return m;
+  }
+
+private:
+  [[noreturn]] static void fail() { throw arrow_error("units: malformed quantity extension metadata"); }
+
+  void skip_ws()
+  {
+    while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r')) ++pos_;
+  }
+
+  [[nodiscard]] bool consume(char c)
+  {
+    skip_ws();
+    if (pos_ < text_.size() && text_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(char c)
+  {
+    if (!consume(c)) fail();
+  }
+
+  template<typename F>
+  void object(F member)
+  {
+    expect('{');
+    if (consume('}')) return;
+    do {
+      std::string key = string();
+      expect(':');
+      member(std::move(key));
+    } while (consume(','));
+    expect('}');
+  }
+
+  [[nodiscard]] std::string string()
+  {
+    expect('"');
+    std::string s;
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      if (text_[pos_] == '\\' && ++pos_ == text_.size()) fail();
+      s += text_[pos_++];
+    }
+    if (pos_ == text_.size()) fail();
+    ++pos_;
+    return s;
+  }
+
+  [[nodiscard]] std::intmax_t integer()
+  {
+    skip_ws();
+    std::intmax_t v = 0;
+    const auto [ptr, ec] = std::from_chars(text_.data() + pos_, text_.data() + text_.size(), v);
+    if (ec != std::errc()) fail();
+    pos_ = static_cast<std::size_t>(ptr - text_.data());
+    return v;
+  }
+
+  template<std::size_t N>
+  [[nodiscard]] std::array<std::intmax_t, N> integers()
+  {
+    std::array<std::intmax_t, N> v{};
+    expect('[');
+    for (std::size_t i = 0; i < N; ++i) {
+      if (i > 0) expect(',');
+      v[i] = integer();
+    }
+    expect(']');
+    return v;
+  }
+
+  void skip_value()
+  {
+    skip_ws();
+    if (pos_ == text_.size()) fail();
+    switch (text_[pos_]) {
+      case '{': object([&](const std::string&) { skip_value(); }); break;
+      case '"': static_cast<void>(string()); break;
+      case '[':
+        ++pos_;
+        if (consume(']')) break;
+        do skip_value();
+        while (consume(','));
+        expect(']');
+        break;
+      default: static_cast<void>(integer());
+    }
+  }
+};
+
+// the encoding of `ArrowSchema::metadata`: the number of pairs followed by length-prefixed
+// keys and values (all lengths are native-endian `int32_t`)
+[[nodiscard]] inline std::string encode_arrow_metadata(std::initializer_list<std::pair<std::string_view, std::string_view>> kvs)
+{
+  std::string out;
+  const auto put_int = [&](std::size_t v) {
+    const auto i = static_cast<std::int32_t>(v);
+    out.append(reinterpret_cast<const char*>(&i), sizeof(i));
+  };
+  put_int(kvs.size());
+  for (const auto& [key, value] : kvs) {
+    put_int(key.size());
+    out += key;
+    put_int(value.size());
+    out += value;
+  }
+  return out;
+}
+
+// finds the value of `key` in `ArrowSchema::metadata`
+[[nodiscard]] inline const char* find_arrow_metadata(const char* metadata, std::string_view key, std::int32_t& size)
+{
+  if (metadata == nullptr) return nullptr;
+  const auto get_int = [&] {
+    std::int32_t i;
+    std::memcpy(&i, metadata, sizeof(i));
+    metadata += sizeof(i);
+    if (i < 0) throw arrow_error("units: malformed schema metadata");
+    return i;
+  };
+  for (std::int32_t n = get_int(); n > 0; --n) {
+    const std::int32_t key_size = get_int();
+    const std::string_view k(metadata, static_cast<std::size_t>(key_size));
+    metadata += key_size;
+    size = get_int();
+    if (k == key) return metadata;
+    metadata += size;
+  }
+  return nullptr;
+}
+
+struct arrow_schema_data {
+  std::string format;
+  std::string name;
+  std::string metadata;
+};
+
+struct arrow_array_data {
+  const void* buffers[2];
+  std::shared_ptr<const void> owner;
+};
+
+inline void check_arrow_array(const ArrowArray& array)
+{
+  if (array.release == nullptr) throw arrow_error("units: released Arrow array");
+  if (array.n_buffers != 2 || array.n_children != 0 || array.length < 0 || array.offset < 0)
+    throw arrow_error("units: not a primitive Arrow array");
+  if (array.null_count != 0 && array.buffers[0] != nullptr) throw arrow_error("units: null values are not supported");
+}
+
+}  // namespace detail
+
+/**
+ * @brief Decodes the quantity extension metadata of an Arrow field
+ *
+ * @throws arrow_error if the field is not annotated as a quantity column
+ */
+[[nodiscard]] inline arrow_quantity_metadata read_arrow_metadata(const ArrowSchema& schema)
+{
+  std::int32_t size = 0;
+  const char* name = detail::find_arrow_metadata(schema.metadata, "ARROW:extension:name", size);
+  if (name == nullptr || std::string_view(name, static_cast<std::size_t>(size)) != arrow_extension_name)
+    throw arrow_error("units: not a quantity column");
+  const char* metadata = detail::find_arrow_metadata(schema.metadata, "ARROW:extension:metadata", size);
+  if (metadata == nullptr) throw arrow_error("units: missing quantity extension metadata");
+  return detail::arrow_metadata_parser(std::string_view(metadata, static_cast<std::size_t>(size))).parse();
+}
+
+/**
+ * @brief Describes a column of quantities of type `Q` as an Arrow extension type
+ *
+ * @param out the schema to initialize; it owns its strings and has to be released by the consumer
+ * @param name the name of the field
+ */
+template<Quantity Q>
+  requires detail::arrow_primitive<typename Q::rep>
+void export_arrow_schema(ArrowSchema& out, std::string_view name = {})
+{
+  auto data = std::make_unique<detail::arrow_schema_data>();
+  data->format = detail::arrow_format_of<typename Q::rep>();
+  data->name = name;
+  data->metadata = detail::encode_arrow_metadata({{"ARROW:extension:name", arrow_extension_name},
+                                                  {"ARROW:extension:metadata", detail::to_json(detail::arrow_metadata_of<Q>())}});
+  out = ArrowSchema{data->format.c_str(), data->name.c_str(), data->metadata.c_str(), 0, 0, nullptr, nullptr,
+                    [](ArrowSchema* schema) {
+                      delete static_cast<detail::arrow_schema_data*>(schema->private_data);
+                      schema->release = nullptr;
+                    },
+                    data.get()};
+  data.release();
+}
+
+/**
+ * @brief Exposes a contiguous range of quantities as an Arrow array without copying
+ *
+ * The array refers to the memory of `qs` which has to outlive it. Alternatively, the owner of
+ * the memory may be handed over in `owner` which is then destroyed when the consumer releases
+ * the array.
+ *
+ * @param qs quantities to export
+ * @param out the array to initialize
+ * @param owner an object keeping the memory of `qs` alive
+ */
+template<typename Q, std::size_t Extent>
+  requires Quantity<std::remove_const_t<Q>> && detail::arrow_primitive<typename Q::rep>
+void export_arrow_array(quantity_span<Q, Extent> qs, ArrowArray& out, std::shared_ptr<const void> owner = {})
+{
+  static_assert(sizeof(Q) == sizeof(typename Q::rep));
+  auto data = std::make_unique<detail::arrow_array_data>(detail::arrow_array_data{{nullptr, qs.data()}, std::move(owner)});
+  out = ArrowArray{static_cast<int64_t>(qs.size()), 0, 0, 2, 0, data->buffers, nullptr, nullptr,
+                   [](ArrowArray* array) {
+                     delete static_cast<detail::arrow_array_data*>(array->private_data);
+                     array->release = nullptr;
+                   },
+                   data.get()};
+  data.release();
+}
+
+/**
+ * @brief Views an Arrow array of a quantity column as quantities without copying
+ *
+ * The column has to store exactly the type `Q` (the same dimension, unit ratio, and
+ * representation type). Use `arrow_quantity_cast()` to convert columns of other units or
+ * representation types.
+ *
+ * @throws arrow_error if the column does not store `Q`, has null values, or is misaligned
+ */
+template<Quantity Q>
+  requires detail::arrow_primitive<typename Q::rep>
+[[nodiscard]] quantity_span<const Q> arrow_quantity_span(const ArrowSchema& schema, const ArrowArray& array)
+{
+  static_assert(sizeof(Q) == sizeof(typename Q::rep));
+  detail::check_arrow_array(array);
+  const arrow_quantity_metadata m = read_arrow_metadata(schema);
+  static const arrow_quantity_metadata expected = detail::arrow_metadata_of<Q>();
+  if (m.exponents != expected.exponents) throw arrow_error("units: dimension mismatch");
+  if (detail::unit_ratio_quotient(m.unit_ratio, expected.unit_ratio) != ratio(1)) throw arrow_error("units: unit mismatch");
+  if (std::string_view(schema.format) != detail::arrow_format_of<typename Q::rep>())
+    throw arrow_error("units: representation type mismatch");
+  if (array.length == 0) return {};
+
+  const auto* first = static_cast<const Q*>(array.buffers[1]) + array.offset;
+  if (reinterpret_cast<std::uintptr_t>(first) % alignof(Q) != 0) throw arrow_error("units: misaligned Arrow buffer");
+  return quantity_span<const Q>(first, static_cast<std::size_t>(array.length));
+}
+
+/**
+ * @brief Converts an Arrow array of a quantity column to quantities of type `Q`
+ *
+ * The dimension of the column has to match the one of `Q`. Values are converted from the unit
+ * and representation type of the column in one pass directly over the Arrow buffer.
+ *
+ * @param out quantities to fill; must be large enough for all the elements of the array
+ * @return the number of quantities written
+ *
+ * @throws arrow_error if the column does not match the dimension of `Q`, is not a supported
+ *         primitive array, has null values, or its unit can not be converted to the one of `Q`
+ */
+template<typename Q, std::size_t Extent>
+  requires Quantity<Q> && std::is_arithmetic_v<typename Q::rep>
+std::size_t arrow_quantity_cast(const ArrowSchema& schema, const ArrowArray& array, quantity_span<Q, Extent> out)
+{
+  detail::check_arrow_array(array);
+  const arrow_quantity_metadata m = read_arrow_metadata(schema);
+  static const arrow_quantity_metadata expected = detail::arrow_metadata_of<Q>();
+  if (m.exponents != expected.exponents) throw arrow_error("units: dimension mismatch");
+  const auto n = static_cast<std::size_t>(array.length);
+  if (n > out.size()) throw arrow_error("units: output range too small");
+  if (n == 0) return 0;
+
+  const auto r = detail::unit_ratio_quotient(m.unit_ratio, expected.unit_ratio);
+  if (!r) throw arrow_error("units: unit ratio out of range");
+  const std::string_view format(schema.format);
+  const auto convert = [&]<typename From>(From*) {
+    const auto* src = static_cast<const std::byte*>(array.buffers[1]) + static_cast<std::size_t>(array.offset) * sizeof(From);
+    try {
+      detail::convert_column<From>(src, n, *r, out.data());
+    } catch (const serialization_error& e) {
+      throw arrow_error(e.what());
+    }
+  };
+  if (format == "g") convert(static_cast<double*>(nullptr));
+  else if (format == "f") convert(static_cast<float*>(nullptr));
+  else if (format == "l") convert(static_cast<std::int64_t*>(nullptr));
+  else if (format == "i") convert(static_cast<std::int32_t*>(nullptr));
+  else if (format == "s") convert(static_cast<std::int16_t*>(nullptr));
+  else if (format == "c") convert(static_cast<std::int8_t*>(nullptr));
+  else if (format == "L") convert(static_cast<std::uint64_t*>(nullptr));
+  else if (format == "I") convert(static_cast<std::uint32_t*>(nullptr));
+  else if (format == "S") convert(static_cast<std::uint16_t*>(nullptr));
+  else if (format == "C") convert(static_cast<std::uint8_t*>(nullptr));
+  else throw arrow_error("units: unsupported Arrow storage type");
+  return n;
+}
+
+}  // namespace units
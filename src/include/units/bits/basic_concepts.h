@@ -27,6 +27,7 @@
 #include <units/bits/external/hacks.h>
 #include <units/ratio.h>
 #include <units/bits/external/type_traits.h>
+#include <cstddef>
 #include <functional>
 #include <cstdint>
 #include <utility>
@@ -254,8 +255,26 @@ concept WrappedQuantity = detail::is_wrapped_quantity<T>;
 
 namespace detail {
 
+// data-parallel types (i.e. `std::experimental::simd`) hold a pack of values of `value_type`,
+// compare element-wise returning `mask_type` instead of `bool`, and are scaled with values of
+// their `value_type`
+template<typename T>
+concept data_parallel =
+  requires {
+    typename T::value_type;
+    typename T::mask_type;
+    { T::size() } -> std::convertible_to<std::size_t>;
+  } &&
+  std::is_arithmetic_v<typename T::value_type> &&
+  std::semiregular<T> &&
+  std::constructible_from<T, typename T::value_type> &&
+  std::regular_invocable<std::multiplies<>, T, T> &&
+  std::regular_invocable<std::divides<>, T, T>;
+
+// data-parallel types are scaled by their own specializations of `quantity_cast_impl`
 template<typename T>
 concept constructible_from_integral =
+  (!data_parallel<T>) &&
   // construction from an integral type
   std::constructible_from<T, std::int64_t> &&
   // unit scaling
@@ -264,6 +283,7 @@ concept constructible_from_integral =
 
 template<typename T>
 concept not_constructible_from_integral =
+  (!data_parallel<T>) &&
   // not construction from an integral type
   (!std::constructible_from<T, std::int64_t>) &&
 
@@ -277,13 +297,14 @@ concept not_constructible_from_integral =
 /**
  * @brief A concept matching non-Quantity types.
  *
- * Satisfied by types that satisfy `(!Quantity<T>) && (!WrappedQuantity<T>) && std::regular<T>`.
+ * Satisfied by types that satisfy `(!Quantity<T>) && (!WrappedQuantity<T>) && std::regular<T>`
+ * as well as by data-parallel types (SIMD packs) whose comparisons return masks.
  */
 template<typename T>
 concept ScalableNumber =
   (!Quantity<T>) &&
   (!WrappedQuantity<T>) &&
-  std::regular<T> &&
-  (detail::constructible_from_integral<T> || detail::not_constructible_from_integral<T>);
+  ((std::regular<T> && (detail::constructible_from_integral<T> || detail::not_constructible_from_integral<T>)) ||
+   detail::data_parallel<T>);
 
 }  // namespace units
@@ -0,0 +1,124 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <version>
+
+namespace units::detail {
+
+#if !__cpp_lib_to_chars
+
+template<std::floating_point T>
+std::from_chars_result strto_from_chars(const char* first, const char* last, T& value)
+{
+  // `strtod()` skips whitespace, accepts a plus sign and hexadecimal values which `std::from_chars()` does not
+  const char* digits = first != last && *first == '-' ? first + 1 : first;
+  if (digits == last || *digits == ' ' || *digits == '\t' || *digits == '\n' || *digits == '+')
+    return {first, std::errc::invalid_argument};
+  if (last - digits > 1 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) last = digits + 1;
+
+  const std::string txt(first, last);
+  char* end = nullptr;
+  errno = 0;
+  T v;
+  if constexpr (std::is_same_v<T, float>) v = std::strtof(txt.c_str(), &end);
+  else if constexpr (std::is_same_v<T, double>) v = std::strtod(txt.c_str(), &end);
+  else v = std::strtold(txt.c_str(), &end);
+  const char* ptr = first + (end - txt.c_str());
+  if (ptr == first) return {first, std::errc::invalid_argument};
+  // subnormal results are accepted like `std::from_chars()` does
+  if (errno == ERANGE && (v == 0 || v == std::numeric_limits<T>::infinity() || v == -std::numeric_limits<T>::infinity()))
+    return {ptr, std::errc::result_out_of_range};
+  value = v;
+  return {ptr, std::errc{}};
+}
+
+template<std::floating_point T>
+std::to_chars_result snprintf_to_chars(char* first, char* last, T value)
+{
+  // the shortest `%g` representation that round-trips (a higher precision may avoid the exponent)
+  std::array<char, 64> buf, shortest;
+  int len = 0;
+  for (int precision = std::numeric_limits<T>::max_digits10; precision > 0; --precision) {
+    const int n = std::snprintf(buf.data(), buf.size(), "%.*Lg", precision, static_cast<long double>(value));
+    T parsed;
+    const bool exact = strto_from_chars(buf.data(), buf.data() + n, parsed).ec == std::errc{} && parsed == value;
+    if (len == 0 || (exact && n <= len)) {
+      shortest = buf;
+      len = n;
+    }
+  }
+  if (len > last - first) return {last, std::errc::value_too_large};
+  return {std::copy(shortest.data(), shortest.data() + len, first), std::errc{}};
+}
+
+#endif
+
+/**
+ * @brief `std::from_chars` replacement for standard libraries that do not parse floating-point values yet
+ *
+ * The fallback parses a copy of the input with `std::strtod()` and friends, so it is slower and
+ * depends on the decimal point of the current C locale.
+ */
+template<typename T>
+  requires std::is_arithmetic_v<T>
+std::from_chars_result from_chars(const char* first, const char* last, T& value)
+{
+#if __cpp_lib_to_chars
+  return std::from_chars(first, last, value);
+#else
+  if constexpr (std::floating_point<T>) return strto_from_chars(first, last, value);
+  else return std::from_chars(first, last, value);
+#endif
+}
+
+/**
+ * @brief `std::to_chars` replacement for standard libraries that do not print floating-point values yet
+ *
+ * Like `std::to_chars()` it prints the shortest representation that round-trips. The fallback
+ * finds it with `std::snprintf()`, so it is slower and depends on the current C locale.
+ */
+template<typename T>
+  requires std::is_arithmetic_v<T>
+std::to_chars_result to_chars(char* first, char* last, T value)
+{
+#if __cpp_lib_to_chars
+  return std::to_chars(first, last, value);
+#else
+  if constexpr (std::floating_point<T>) return snprintf_to_chars(first, last, value);
+  else return std::to_chars(first, last, value);
+#endif
+}
+
+}  // namespace units::detail
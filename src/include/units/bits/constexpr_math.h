@@ -0,0 +1,271 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Scalar kernels used by `units/math.h`.
+//
+// All of them are usable in constant expressions. Floating-point kernels dispatch to the
+// <cmath> implementation at runtime (which is usually a single instruction and correctly
+// rounded) and fall back to Newton iterations during constant evaluation. Integral kernels
+// never leave the integer domain.
+
+namespace units::detail {
+
+template<typename T>
+concept arithmetic = std::is_arithmetic_v<T>;
+
+/**
+ * @brief Raises `base` to the non-negative power `exp` with exponentiation by squaring
+ *
+ * Requires only multiplication from `T` so it also works for custom representation types.
+ */
+template<typename T>
+[[nodiscard]] constexpr T pow_by_squaring(T base, std::uintmax_t exp)
+{
+  T result = T(1);
+  while (exp > 0) {
+    if (exp & 1) result = result * base;
+    exp >>= 1;
+    if (exp > 0) base = base * base;
+  }
+  return result;
+}
+
+// truncation helpers used by the floating-point kernels below
+// values with magnitude above 2^62 are always integral for every IEEE format
+template<std::floating_point T>
+inline constexpr T integral_threshold = static_cast<T>(std::intmax_t(1) << 62);
+
+template<std::floating_point T>
+[[nodiscard]] constexpr bool is_finite(T v) noexcept
+{
+  return v == v && v != std::numeric_limits<T>::infinity() && v != -std::numeric_limits<T>::infinity();
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T floor(T v) noexcept
+{
+  if (!std::is_constant_evaluated()) return std::floor(v);
+  if (!(v < integral_threshold<T> && v > -integral_threshold<T>)) return v;  // NaN, inf, or already integral
+  const T t = static_cast<T>(static_cast<std::intmax_t>(v));
+  return t > v ? t - T(1) : t;
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T ceil(T v) noexcept
+{
+  if (!std::is_constant_evaluated()) return std::ceil(v);
+  if (!(v < integral_threshold<T> && v > -integral_threshold<T>)) return v;
+  const T t = static_cast<T>(static_cast<std::intmax_t>(v));
+  return t < v ? t + T(1) : t;
+}
+
+// rounds half away from zero (same as `std::round`)
+template<std::floating_point T>
+[[nodiscard]] constexpr T round(T v) noexcept
+{
+  if (!std::is_constant_evaluated()) return std::round(v);
+  if (!(v < integral_threshold<T> && v > -integral_threshold<T>)) return v;
+  if (v < T(0)) return -detail::round(-v);
+  const T t = detail::floor(v);
+  return v - t >= T(0.5) ? t + T(1) : t;
+}
+
+// whether `v > a * b` holds exactly for `a * b` close to `v`
+// the product is split into `hi + lo` without rounding (Dekker) so that only `v - hi` has to be
+// computed, which is exact because `hi` and `v` are within a factor of 2 of each other
+template<std::floating_point T>
+[[nodiscard]] constexpr bool exceeds_product(T v, T a, T b) noexcept
+{
+  constexpr T splitter = static_cast<T>((std::uintmax_t(1) << ((std::numeric_limits<T>::digits + 1) / 2)) + 1);
+  const auto split = [](T x, T& high, T& low) {
+    const T c = splitter * x;
+    high = c - (c - x);
+    low = x - high;
+  };
+  T ah{}, al{}, bh{}, bl{};
+  split(a, ah, al);
+  split(b, bh, bl);
+  const T hi = a * b;
+  const T lo = ((ah * bh - hi) + ah * bl + al * bh) + al * bl;
+  return v - hi > lo;
+}
+
+/**
+ * @brief Square root of a floating-point value
+ *
+ * During constant evaluation the argument is first scaled by powers of 4 into [1, 4) so that
+ * the Newton iteration converges in a handful of steps for the whole range of `T`. The result
+ * is then nudged by single ulps until it is correctly rounded, matching `std::sqrt`.
+ */
+template<std::floating_point T>
+[[nodiscard]] constexpr T sqrt(T v) noexcept
+{
+  if (!std::is_constant_evaluated()) return std::sqrt(v);
+  if (v != v || v < T(0)) return std::numeric_limits<T>::quiet_NaN();
+  if (v == T(0) || v == std::numeric_limits<T>::infinity()) return v;
+
+  T scale = T(1);
+  while (v >= T(4)) { v /= T(4); scale *= T(2); }
+  while (v < T(1)) { v *= T(4); scale /= T(2); }
+
+  // starting above the root makes the sequence strictly decreasing until it converges
+  T x = v;
+  T prev{};
+  do {
+    prev = x;
+    x = (x + v / x) / T(2);
+  } while (x < prev);
+
+  // the root lies in [1, 2) where the spacing is `epsilon`; as `v` and `r * (r +/- epsilon)` are
+  // both multiples of epsilon^2, `r` rounds up iff `v > r * (r + epsilon)` and down iff
+  // `v <= r * (r - epsilon)`
+  constexpr T eps = std::numeric_limits<T>::epsilon();
+  T r = prev < T(2) ? prev : T(2) - eps;
+  while (exceeds_product(v, r, r + eps)) r += eps;
+  while (!exceeds_product(v, r, r - eps)) r -= eps;
+  return r * scale;
+}
+
+/**
+ * @brief Cube root of a floating-point value
+ *
+ * Uses the same range reduction as `sqrt()` (by powers of 8) followed by Newton iterations.
+ */
+template<std::floating_point T>
+[[nodiscard]] constexpr T cbrt(T v) noexcept
+{
+  if (!std::is_constant_evaluated()) return std::cbrt(v);
+  if (v != v || v == T(0) || !is_finite(v)) return v;
+  if (v < T(0)) return -cbrt(-v);
+
+  T scale = T(1);
+  while (v >= T(8)) { v /= T(8); scale *= T(2); }
+  while (v < T(1)) { v *= T(8); scale /= T(2); }
+
+  T x = v;
+  T prev{};
+  do {
+    prev = x;
+    x = (T(2) * x + v / (x * x)) / T(3);
+  } while (x < prev);
+  return prev * scale;
+}
+
+/**
+ * @brief Floor of the square root of a non-negative integral value
+ */
+template<std::integral T>
+[[nodiscard]] constexpr T sqrt(T v) noexcept
+{
+  if (v <= T(1)) return v < T(0) ? T(0) : v;
+  using U = std::make_unsigned_t<std::common_type_t<T, unsigned>>;
+  const U n = static_cast<U>(v);
+  U x = n;
+  U y = x / 2 + (x & 1);
+  while (y < x) {
+    x = y;
+    y = (x + n / x) / 2;
+  }
+  return static_cast<T>(x);
+}
+
+/**
+ * @brief Integral cube root of an integral value truncated toward zero
+ */
+template<std::integral T>
+[[nodiscard]] constexpr T cbrt(T v) noexcept
+{
+  if constexpr (std::is_signed_v<T>) {
+    if (v < T(0)) return static_cast<T>(-static_cast<T>(detail::cbrt(static_cast<std::make_unsigned_t<T>>(-(v + 1)) + 1u)));
+  }
+  using U = std::make_unsigned_t<std::common_type_t<T, unsigned>>;
+  U n = static_cast<U>(v);
+  U root = 0;
+  for (int s = (std::numeric_limits<U>::digits / 3) * 3; s >= 0; s -= 3) {
+    root <<= 1;
+    const U b = 3 * root * (root + 1) + 1;
+    if ((n >> s) >= b) {
+      n -= b << s;
+      ++root;
+    }
+  }
+  return static_cast<T>(root);
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T hypot(T x, T y) noexcept
+{
+  if (!std::is_constant_evaluated()) return std::hypot(x, y);
+  x = x < T(0) ? -x : x;
+  y = y < T(0) ? -y : y;
+  const T m = x > y ? x : y;
+  if (m == T(0) || !is_finite(m)) return m;
+  x /= m;
+  y /= m;
+  return m * detail::sqrt(x * x + y * y);
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T hypot(T x, T y, T z) noexcept
+{
+  if (!std::is_constant_evaluated()) return std::hypot(x, y, z);
+  x = x < T(0) ? -x : x;
+  y = y < T(0) ? -y : y;
+  z = z < T(0) ? -z : z;
+  const T m = x > y ? (x > z ? x : z) : (y > z ? y : z);
+  if (m == T(0) || !is_finite(m)) return m;
+  x /= m;
+  y /= m;
+  z /= m;
+  return m * detail::sqrt(x * x + y * y + z * z);
+}
+
+template<std::integral T>
+[[nodiscard]] constexpr T hypot(T x, T y) noexcept
+{
+  return detail::sqrt(static_cast<T>(x * x + y * y));
+}
+
+template<std::integral T>
+[[nodiscard]] constexpr T hypot(T x, T y, T z) noexcept
+{
+  return detail::sqrt(static_cast<T>(x * x + y * y + z * z));
+}
+
+template<arithmetic T>
+[[nodiscard]] constexpr T fma(T x, T y, T z) noexcept
+{
+  if constexpr (std::floating_point<T>) {
+    if (!std::is_constant_evaluated()) return std::fma(x, y, z);
+  }
+  return static_cast<T>(x * y + z);
+}
+
+}  // namespace units::detail
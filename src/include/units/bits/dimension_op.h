@@ -190,6 +190,37 @@ struct dimension_sqrt_impl<derived_dimension_base<Es...>> {
 template<Dimension D>
 using dimension_sqrt = TYPENAME detail::dimension_sqrt_impl<D>::type;
 
+// dimension_cbrt
+namespace detail {
+
+template<Dimension D>
+struct dimension_cbrt_impl;
+
+template<BaseDimension D>
+struct dimension_cbrt_impl<D> {
+  using type = downcast_dimension<derived_dimension_base<exponent<D, 1, 3>>>;
+};
+
+template<BaseDimension D>
+struct dimension_cbrt_impl<derived_dimension_base<exponent<D, 3>>> {
+  using type = D;
+};
+
+template<DerivedDimension D>
+struct dimension_cbrt_impl<D> {
+  using type = TYPENAME dimension_cbrt_impl<typename D::downcast_base_type>::type;
+};
+
+template<typename... Es>
+struct dimension_cbrt_impl<derived_dimension_base<Es...>> {
+  using type = downcast_dimension<derived_dimension_base<exponent_multiply<Es, 1, 3>...>>;
+};
+
+}  // namespace detail
+
+template<Dimension D>
+using dimension_cbrt = TYPENAME detail::dimension_cbrt_impl<D>::type;
+
 // dimension_pow
 namespace detail {
 
@@ -0,0 +1,118 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+
+// Polynomial approximations of trigonometric functions used by `units::fast`.
+//
+// The kernels are branch-free, do not call into <cmath>, and are usable
+// in constant expressions, so loops over contiguous storage vectorize.
+// Coefficients come from Abramowitz & Stegun (4.3.97, 4.3.99, and 4.4.49).
+
+namespace units::detail::fast {
+
+template<std::floating_point T>
+inline constexpr T pi = static_cast<T>(3.141592653589793238462643383279502884L);
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T sin_poly(T r) noexcept
+{
+  // sin(r) / r on [-pi/2, pi/2], |error| <= 2e-9
+  const T z = r * r;
+  return r + r * z * (T(-0.1666666664) + z * (T(0.0083333315) + z * (T(-0.0001984090) + z * (T(0.0000027526) + z * T(-0.0000000239)))));
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T cos_poly(T r) noexcept
+{
+  // cos(r) on [-pi/2, pi/2], |error| <= 2e-9
+  const T z = r * r;
+  return T(1) + z * (T(-0.4999999963) + z * (T(0.0416666418) + z * (T(-0.0013888397) + z * (T(0.0000247609) + z * T(-0.0000002605)))));
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T atan_poly(T x) noexcept
+{
+  // atan(x) on [-1, 1], |error| <= 2e-8
+  const T z = x * x;
+  return x + x * z * (T(-0.3333314528) + z * (T(0.1999355085) + z * (T(-0.1420889944) + z * (T(0.1065626393) +
+                 z * (T(-0.0752896400) + z * (T(0.0429096138) + z * (T(-0.0161657367) + z * T(0.0028662257))))))));
+}
+
+template<std::floating_point T>
+inline constexpr T round_magic = T(1.5) * static_cast<T>(std::uintmax_t(1) << (std::numeric_limits<T>::digits - 1));
+
+// reduces `x` to [-pi/4, pi/4] and evaluates the proper polynomial for the quadrant
+// `shift` equal to 1 turns sine into cosine
+//
+// Quadrants are handled by multiplying with 0/1 and -1/1 factors instead of selecting with `?:`,
+// otherwise the compiler sinks the operations of each arm into branches (floating-point
+// operations may trap) and the loop body is no longer vectorizable.
+// Requires the default (round to nearest) floating-point rounding mode.
+template<std::floating_point T>
+[[nodiscard]] constexpr T sin_quadrant(T x, std::int32_t shift) noexcept
+{
+  // rounds to the nearest integer by pushing the fraction out of the significand
+  const T t = x * (T(2) / pi<T>);
+  const auto k = static_cast<std::int32_t>((t + round_magic<T>) - round_magic<T>);
+  const T r = x - static_cast<T>(k) * (pi<T> / T(2));
+  const std::int32_t q = (k + shift) & 3;
+  const T use_cos = static_cast<T>(q & 1);
+  const T sign = static_cast<T>(1 - (q & 2));
+  return sign * (sin_poly(r) * (T(1) - use_cos) + cos_poly(r) * use_cos);
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T sin(T x) noexcept
+{
+  return sin_quadrant(x, 0);
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T cos(T x) noexcept
+{
+  return sin_quadrant(x, 1);
+}
+
+// the same factor trick as in `sin_quadrant()` is used to move the result to the proper octant
+template<std::floating_point T>
+[[nodiscard]] constexpr T atan2(T y, T x) noexcept
+{
+  const T x_neg = static_cast<T>(x < T(0));
+  const T y_neg = static_cast<T>(y < T(0));
+  const T ax = x * (T(1) - T(2) * x_neg);
+  const T ay = y * (T(1) - T(2) * y_neg);
+  const T steep = static_cast<T>(ay > ax);
+  const T mx = ax * (T(1) - steep) + ay * steep;
+  const T mn = ay * (T(1) - steep) + ax * steep;
+  // the smallest normal value keeps 0/0 away without a branch
+  const T a0 = atan_poly(mn / (mx + std::numeric_limits<T>::min()));
+  const T a1 = a0 * (T(1) - T(2) * steep) + steep * (pi<T> / T(2));
+  const T a2 = a1 * (T(1) - T(2) * x_neg) + x_neg * pi<T>;
+  return a2 * (T(1) - T(2) * y_neg);
+}
+
+}  // namespace units::detail::fast
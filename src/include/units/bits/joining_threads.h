@@ -0,0 +1,60 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace units::detail {
+
+/**
+ * @brief Worker threads joined on destruction
+ *
+ * Unlike a plain vector of `std::thread` it does not terminate the program when an exception
+ * leaves the scope that started the threads (i.e. when starting one of them fails).
+ */
+class joining_threads {
+  std::vector<std::thread> threads_;
+
+public:
+  explicit joining_threads(std::size_t capacity) { threads_.reserve(capacity); }
+  joining_threads(const joining_threads&) = delete;
+  joining_threads& operator=(const joining_threads&) = delete;
+  ~joining_threads() { join(); }
+
+  template<typename F, typename... Args>
+  void start(F&& f, Args&&... args)
+  {
+    threads_.emplace_back(std::forward<F>(f), std::forward<Args>(args)...);
+  }
+
+  void join() noexcept
+  {
+    for (std::thread& t : threads_)
+      if (t.joinable()) t.join();
+  }
+};
+
+}  // namespace units::detail
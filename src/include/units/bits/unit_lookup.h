@@ -0,0 +1,72 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/to_string.h>
+#include <units/concepts.h>
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace units::detail {
+
+template<Dimension D, Unit U>
+inline constexpr auto unit_symbol = unit_text<D, U>();
+
+struct unit_symbol_entry {
+  std::string_view standard;
+  std::string_view ascii;
+};
+
+template<Dimension D, Unit U>
+inline constexpr unit_symbol_entry unit_symbol_entry_of{
+    std::string_view(unit_symbol<D, U>.standard().c_str(), unit_symbol<D, U>.standard().size()),
+    std::string_view(unit_symbol<D, U>.ascii().c_str(), unit_symbol<D, U>.ascii().size())};
+
+/**
+ * @brief The standard and ASCII-only symbols of units `Us` printed as for quantities of dimension `D`
+ */
+template<Dimension D, Unit... Us>
+inline constexpr std::array<unit_symbol_entry, sizeof...(Us)> unit_symbol_table{unit_symbol_entry_of<D, Us>...};
+
+/**
+ * @brief Finds a unit by its symbol
+ *
+ * Both the standard and the ASCII-only symbols of the units are taken into account.
+ *
+ * @tparam D a dimension used to print the symbols of units deduced from their dimension recipe
+ * @tparam Us units to look through
+ *
+ * @return the index of the first unit of `Us` with a matching symbol or `sizeof...(Us)` if there is none
+ */
+template<Dimension D, Unit... Us>
+[[nodiscard]] constexpr std::size_t find_unit_by_symbol(std::string_view symbol) noexcept
+{
+  const auto& table = unit_symbol_table<D, Us...>;
+  std::size_t index = 0;
+  while (index < table.size() && symbol != table[index].standard && symbol != table[index].ascii) ++index;
+  return index;
+}
+
+}  // namespace units::detail
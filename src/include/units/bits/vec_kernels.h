@@ -0,0 +1,221 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/external/hacks.h>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// Kernels of `units::vec` and `units::mat` operating on contiguous representation values.
+//
+// With GCC and Clang vectors of 2, 3, and 4 arithmetic values are processed with the generic
+// vector extensions (3 elements are padded with a zero lane) so that every operation maps to a few
+// SIMD instructions. Other sizes and types, other compilers, and constant evaluation use plain loops.
+
+namespace units::detail {
+
+#if COMP_GCC || COMP_CLANG
+
+// integral types narrower than `int` are excluded as the scalar arithmetic would promote them
+template<typename T, std::size_t N>
+inline constexpr bool vec_simd_enabled =
+    ((std::is_floating_point_v<T> && sizeof(T) <= 8) || (std::is_integral_v<T> && sizeof(T) >= sizeof(int) && !std::is_same_v<T, bool>)) &&
+    N >= 2 && N <= 4;
+
+template<typename T, std::size_t N>
+using vec_lanes __attribute__((vector_size(sizeof(T) * (N == 3 ? 4 : N)))) = T;
+
+// vector values are passed by reference only to keep the ABI independent of the target ISA
+template<typename T, std::size_t N>
+inline void vec_load(vec_lanes<T, N>& v, const T* p) noexcept
+{
+  v = vec_lanes<T, N>{};
+  std::memcpy(&v, p, N * sizeof(T));
+}
+
+template<typename T, std::size_t N>
+inline void vec_store(T* p, const vec_lanes<T, N>& v) noexcept
+{
+  std::memcpy(p, &v, N * sizeof(T));
+}
+
+#else
+
+template<typename T, std::size_t N>
+inline constexpr bool vec_simd_enabled = false;
+
+#endif
+
+template<typename T, std::size_t N>
+constexpr void vec_add(const T* a, const T* b, T* out) noexcept
+{
+#if COMP_GCC || COMP_CLANG
+  if constexpr (vec_simd_enabled<T, N>) {
+    if (!std::is_constant_evaluated()) {
+      vec_lanes<T, N> x, y;
+      vec_load<T, N>(x, a);
+      vec_load<T, N>(y, b);
+      x += y;
+      vec_store<T, N>(out, x);
+      return;
+    }
+  }
+#endif
+  for (std::size_t i = 0; i < N; ++i) out[i] = a[i] + b[i];
+}
+
+template<typename T, std::size_t N>
+constexpr void vec_sub(const T* a, const T* b, T* out) noexcept
+{
+#if COMP_GCC || COMP_CLANG
+  if constexpr (vec_simd_enabled<T, N>) {
+    if (!std::is_constant_evaluated()) {
+      vec_lanes<T, N> x, y;
+      vec_load<T, N>(x, a);
+      vec_load<T, N>(y, b);
+      x -= y;
+      vec_store<T, N>(out, x);
+      return;
+    }
+  }
+#endif
+  for (std::size_t i = 0; i < N; ++i) out[i] = a[i] - b[i];
+}
+
+template<typename T, std::size_t N>
+constexpr void vec_scale(const T* a, T s, T* out) noexcept
+{
+#if COMP_GCC || COMP_CLANG
+  if constexpr (vec_simd_enabled<T, N>) {
+    if (!std::is_constant_evaluated()) {
+      vec_lanes<T, N> x;
+      vec_load<T, N>(x, a);
+      x *= s;
+      vec_store<T, N>(out, x);
+      return;
+    }
+  }
+#endif
+  for (std::size_t i = 0; i < N; ++i) out[i] = a[i] * s;
+}
+
+template<typename T, std::size_t N>
+constexpr void vec_divide(const T* a, T s, T* out) noexcept
+{
+#if COMP_GCC || COMP_CLANG
+  if constexpr (vec_simd_enabled<T, N>) {
+    if (!std::is_constant_evaluated()) {
+      vec_lanes<T, N> x;
+      vec_load<T, N>(x, a);
+      x /= s;
+      vec_store<T, N>(out, x);
+      return;
+    }
+  }
+#endif
+  for (std::size_t i = 0; i < N; ++i) out[i] = a[i] / s;
+}
+
+template<typename T, std::size_t N>
+[[nodiscard]] constexpr T vec_dot(const T* a, const T* b) noexcept
+{
+#if COMP_GCC || COMP_CLANG
+  if constexpr (vec_simd_enabled<T, N>) {
+    if (!std::is_constant_evaluated()) {
+      vec_lanes<T, N> x, y;
+      vec_load<T, N>(x, a);
+      vec_load<T, N>(y, b);
+      x *= y;
+      T sum = x[0] + x[1];
+      if constexpr (N > 2) sum += x[2];
+      if constexpr (N > 3) sum += x[3];
+      return sum;
+    }
+  }
+#endif
+  T sum = a[0] * b[0];
+  for (std::size_t i = 1; i < N; ++i) sum += a[i] * b[i];
+  return sum;
+}
+
+template<typename T>
+constexpr void vec_cross(const T* a, const T* b, T* out) noexcept
+{
+#if COMP_GCC || COMP_CLANG
+  if constexpr (vec_simd_enabled<T, 3>) {
+    if (!std::is_constant_evaluated()) {
+      // the element-wise initialization compiles to lane shuffles
+      const vec_lanes<T, 3> a1{a[1], a[2], a[0], T{}};
+      const vec_lanes<T, 3> b1{b[2], b[0], b[1], T{}};
+      const vec_lanes<T, 3> a2{a[2], a[0], a[1], T{}};
+      const vec_lanes<T, 3> b2{b[1], b[2], b[0], T{}};
+      const vec_lanes<T, 3> x = a1 * b1 - a2 * b2;
+      vec_store<T, 3>(out, x);
+      return;
+    }
+  }
+#endif
+  out[0] = a[1] * b[2] - a[2] * b[1];
+  out[1] = a[2] * b[0] - a[0] * b[2];
+  out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+// `m` is a row-major `R`x`C` matrix
+template<typename T, std::size_t R, std::size_t C>
+constexpr void mat_vec(const T* m, const T* v, T* out) noexcept
+{
+  for (std::size_t r = 0; r < R; ++r) out[r] = vec_dot<T, C>(m + r * C, v);
+}
+
+// `a` is a row-major `R`x`K` matrix, `b` a row-major `K`x`C` one
+// every row of the result is accumulated from the rows of `b` scaled by the elements of `a`
+template<typename T, std::size_t R, std::size_t K, std::size_t C>
+constexpr void mat_mat(const T* a, const T* b, T* out) noexcept
+{
+#if COMP_GCC || COMP_CLANG
+  if constexpr (vec_simd_enabled<T, C>) {
+    if (!std::is_constant_evaluated()) {
+      for (std::size_t r = 0; r < R; ++r) {
+        vec_lanes<T, C> acc{};
+        vec_lanes<T, C> row;
+        for (std::size_t k = 0; k < K; ++k) {
+          vec_load<T, C>(row, b + k * C);
+          acc += a[r * K + k] * row;
+        }
+        vec_store<T, C>(out + r * C, acc);
+      }
+      return;
+    }
+  }
+#endif
+  for (std::size_t r = 0; r < R; ++r)
+    for (std::size_t c = 0; c < C; ++c) {
+      T sum = a[r * K] * b[c];
+      for (std::size_t k = 1; k < K; ++k) sum += a[r * K + k] * b[k * C + c];
+      out[r * C + c] = sum;
+    }
+}
+
+}  // namespace units::detail
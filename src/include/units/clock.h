@@ -0,0 +1,215 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/external/hacks.h>
+#include <units/physical/si/base/time.h>
+#include <units/quantity_point.h>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) && (COMP_GCC || COMP_CLANG)
+#define UNITS_HAS_TSC_CLOCK 1
+#include <x86intrin.h>
+#else
+#define UNITS_HAS_TSC_CLOCK 0
+#endif
+
+namespace units::physical::si {
+
+/**
+ *  @brief Conversion from a time quantity point to a std::chrono::time_point
+ *
+ *  The time point is taken relative to the epoch of `Clock`. If unspecified, Duration is
+ *  the one returned by `to_chrono_duration()` for the relative quantity so the conversion
+ *  only copies the value. For example:
+ *
+ *  auto tp1 = units::physical::si::to_chrono_time_point<std::chrono::steady_clock>(units::clock::steady::now());
+ *  auto tp2 = units::physical::si::to_chrono_time_point<std::chrono::system_clock, std::chrono::seconds>(qp);
+ *
+ *  @tparam Clock the clock of the resulting time point
+ */
+template<typename Clock, units::Unit U, units::ScalableNumber Rep>
+constexpr auto to_chrono_time_point(const units::quantity_point<dim_time, U, Rep>& qp)
+{
+  using duration = decltype(to_chrono_duration(qp.relative()));
+  return std::chrono::time_point<Clock, duration>(to_chrono_duration(qp.relative()));
+}
+
+/**
+ *  @brief Conversion from a time quantity point to a std::chrono::time_point with a target Duration
+ *
+ *  @tparam Clock the clock of the resulting time point
+ *  @tparam Duration a target std::chrono::duration type to cast to
+ */
+template<typename Clock, typename Duration, units::Unit U, units::ScalableNumber Rep>
+  requires requires{ std::chrono::duration_cast<Duration>(std::chrono::seconds{}); }
+constexpr auto to_chrono_time_point(const units::quantity_point<dim_time, U, Rep>& qp)
+{
+  return std::chrono::time_point<Clock, Duration>(to_chrono_duration<Duration>(qp.relative()));
+}
+
+/**
+ *  @brief Conversion from a std::chrono::time_point to a time quantity point
+ *
+ *  The resulting point is relative to the epoch of the clock of the argument. Its unit and
+ *  representation are the ones of the duration of the time point so the conversion only
+ *  copies the value.
+ */
+template<typename Clock, units::ScalableNumber Rep, std::intmax_t Num, std::intmax_t Den>
+constexpr auto from_chrono_time_point(const std::chrono::time_point<Clock, std::chrono::duration<Rep, std::ratio<Num, Den>>>& tp)
+{
+  return units::quantity_point(from_chrono_duration(tp.time_since_epoch()));
+}
+
+/**
+ *  @brief Conversion from a std::chrono::time_point to a time quantity point of type QP
+ *
+ *  @tparam QP a target quantity point of time to cast to
+ */
+template<units::QuantityPoint QP, typename Clock, units::ScalableNumber Rep, std::intmax_t Num, std::intmax_t Den>
+  requires units::physical::Time<typename QP::quantity_type>
+constexpr QP from_chrono_time_point(const std::chrono::time_point<Clock, std::chrono::duration<Rep, std::ratio<Num, Den>>>& tp)
+{
+  return QP(from_chrono_duration<typename QP::quantity_type>(tp.time_since_epoch()));
+}
+
+}  // namespace units::physical::si
+
+namespace units::clock {
+
+/**
+ * @brief The duration of all the clocks of the library
+ */
+using duration = physical::si::time<physical::si::nanosecond, std::int64_t>;
+
+/**
+ * @brief The time point of all the clocks of the library
+ *
+ * A time point does not carry its clock so only the differences of time points of the same
+ * clock are meaningful.
+ */
+using time_point = quantity_point<physical::si::dim_time, physical::si::nanosecond, std::int64_t>;
+
+namespace detail {
+
+template<typename Clock>
+struct chrono_clock {
+  using std_clock = Clock;
+  using duration = clock::duration;
+  using time_point = clock::time_point;
+  static constexpr bool is_steady = Clock::is_steady;
+
+  [[nodiscard]] static time_point now() noexcept
+  {
+    return time_point(duration(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count()));
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief `std::chrono::steady_clock` returning a quantity point of time
+ */
+struct steady : detail::chrono_clock<std::chrono::steady_clock> {};
+
+/**
+ * @brief `std::chrono::system_clock` returning a quantity point of time
+ */
+struct system : detail::chrono_clock<std::chrono::system_clock> {};
+
+#if UNITS_HAS_TSC_CLOCK
+
+/**
+ * @brief A clock reading the time stamp counter of the CPU
+ *
+ * Reading the counter is much cheaper than a call to `steady::now()`. Its frequency is measured
+ * once against `steady` on the first call to `now()` or `calibrate()` (which takes about 10 ms)
+ * and the returned time points share the epoch of `steady`.
+ *
+ * Requires an invariant time stamp counter (constant rate and synchronized between cores),
+ * which is the case for x86-64 CPUs of the last decade.
+ */
+struct tsc {
+  using duration = clock::duration;
+  using time_point = clock::time_point;
+  static constexpr bool is_steady = true;
+
+  /**
+   * @brief Calibrates the clock if it was not calibrated yet
+   *
+   * @return the measured frequency of the counter in ticks per second
+   */
+  static double calibrate() noexcept
+  {
+    return 1e9 * 4294967296.0 / static_cast<double>(calibration().ns_per_tick);
+  }
+
+  [[nodiscard]] static time_point now() noexcept
+  {
+    const calibration_data& c = calibration();
+    const std::uint64_t ticks = __rdtsc() - c.ticks;
+    __extension__ using wide = unsigned __int128;
+    const auto ns = static_cast<std::int64_t>((static_cast<wide>(ticks) * c.ns_per_tick) >> 32);
+    return time_point(duration(c.nanoseconds + ns));
+  }
+
+private:
+  struct calibration_data {
+    std::uint64_t ticks;         // a reading of the counter
+    std::int64_t nanoseconds;    // `steady` at the time of the reading
+    std::uint64_t ns_per_tick;   // nanoseconds per tick scaled by 2^32
+  };
+
+  static calibration_data measure() noexcept
+  {
+    constexpr std::int64_t window = 10'000'000;
+    const std::int64_t t0 = steady::now().relative().count();
+    const std::uint64_t c0 = __rdtsc();
+    std::int64_t t1 = t0;
+    while (t1 - t0 < window) t1 = steady::now().relative().count();
+    const std::uint64_t c1 = __rdtsc();
+    const auto ns_per_tick = static_cast<std::uint64_t>(static_cast<double>(t1 - t0) * 4294967296.0 / static_cast<double>(c1 - c0));
+    return {c1, t1, ns_per_tick};
+  }
+
+  static const calibration_data& calibration() noexcept
+  {
+    static const calibration_data data = measure();
+    return data;
+  }
+};
+
+#endif
+
+/**
+ * @brief The cheapest steady clock available (`tsc` if supported, `steady` otherwise)
+ */
+#if UNITS_HAS_TSC_CLOCK
+using fast = tsc;
+#else
+using fast = steady;
+#endif
+
+}  // namespace units::clock
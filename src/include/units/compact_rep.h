@@ -0,0 +1,339 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <units/bits/bit_cast.h>
+#include <units/bits/constexpr_math.h>
+#include <units/bits/pow.h>
+#include <units/customization_points.h>
+#include <units/quantity_cast.h>
+#include <units/quantity_span.h>
+#include <units/ratio.h>
+#include <gsl/gsl_assert>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Storage-oriented representation types.
+//
+// All of them trade precision for size: a value is rounded to the nearest representable one when
+// stored and is implicitly converted back to `float` or `double` when read, so the arithmetic is
+// always carried out in the wider type. The conversion kernels are branch-free so that bulk
+// `pack()` and `unpack()` loops vectorize.
+
+namespace units {
+
+namespace detail {
+
+// blends `a` and `b` with a mask of all ones or all zeros (select without a branch)
+[[nodiscard]] constexpr std::uint32_t blend(std::uint32_t mask, std::uint32_t a, std::uint32_t b) noexcept
+{
+  return (a & mask) | (b & ~mask);
+}
+
+[[nodiscard]] constexpr std::uint32_t mask_if(bool cond) noexcept { return 0u - static_cast<std::uint32_t>(cond); }
+
+// IEEE 754 binary32 -> binary16 with rounding to nearest even
+[[nodiscard]] constexpr std::uint16_t float_to_half_bits(float v) noexcept
+{
+  const auto bits = bit_cast<std::uint32_t>(v);
+  const std::uint32_t sign = (bits >> 16) & 0x8000u;
+  const std::uint32_t abs = bits & 0x7fff'ffffu;
+
+  // rebias the exponent and round the mantissa
+  const std::uint32_t normal = (abs - (112u << 23) + 0xfffu + ((abs >> 13) & 1u)) >> 13;
+  // adding 0.5f aligns the mantissa of a value below 2^-14 so the FPU does the rounding
+  const std::uint32_t subnormal = bit_cast<std::uint32_t>(bit_cast<float>(abs) + 0.5f) - (126u << 23);
+  const std::uint32_t inf_nan = abs > 0x7f80'0000u ? 0x7e00u : 0x7c00u;
+
+  std::uint32_t h = blend(mask_if(abs < (113u << 23)), subnormal, normal);
+  h = blend(mask_if(abs >= (143u << 23)), inf_nan, h);
+  return static_cast<std::uint16_t>(h | sign);
+}
+
+// IEEE 754 binary16 -> binary32 (exact)
+[[nodiscard]] constexpr float half_bits_to_float(std::uint16_t bits) noexcept
+{
+  const std::uint32_t sign = (bits & 0x8000u) << 16;
+  const std::uint32_t em = (bits & 0x7fffu) << 13;
+  const std::uint32_t exp = em & (0x1fu << 23);
+
+  const std::uint32_t normal = em + (112u << 23);
+  const std::uint32_t inf_nan = em + (224u << 23);
+  const std::uint32_t subnormal = bit_cast<std::uint32_t>(bit_cast<float>(em + (113u << 23)) - bit_cast<float>(113u << 23));
+
+  std::uint32_t f = blend(mask_if(exp == 0), subnormal, normal);
+  f = blend(mask_if(exp == (0x1fu << 23)), inf_nan, f);
+  return bit_cast<float>(f | sign);
+}
+
+// IEEE 754 binary32 -> bfloat16 with rounding to nearest even (NaNs stay quiet NaNs)
+[[nodiscard]] constexpr std::uint16_t float_to_bfloat16_bits(float v) noexcept
+{
+  const auto bits = bit_cast<std::uint32_t>(v);
+  const std::uint32_t rounded = (bits + 0x7fffu + ((bits >> 16) & 1u)) >> 16;
+  const std::uint32_t nan = (bits >> 16) | 0x40u;
+  return static_cast<std::uint16_t>(blend(mask_if((bits & 0x7fff'ffffu) > 0x7f80'0000u), nan, rounded));
+}
+
+[[nodiscard]] constexpr float bfloat16_bits_to_float(std::uint16_t bits) noexcept
+{
+  return bit_cast<float>(static_cast<std::uint32_t>(bits) << 16);
+}
+
+}  // namespace detail
+
+/**
+ * @brief IEEE 754 half-precision (binary16) storage type
+ *
+ * 11 significant bits and a range of +-65504. Values are stored with rounding to nearest even and
+ * read as `float`. `double` arguments are rounded to `float` first.
+ */
+class float16 {
+  std::uint16_t bits_{};
+
+public:
+  float16() = default;
+
+  template<detail::arithmetic T>
+  constexpr float16(T v) noexcept : bits_(detail::float_to_half_bits(static_cast<float>(v))) {}
+
+  [[nodiscard]] static constexpr float16 from_bits(std::uint16_t bits) noexcept
+  {
+    float16 v;
+    v.bits_ = bits;
+    return v;
+  }
+  [[nodiscard]] constexpr std::uint16_t bits() const noexcept { return bits_; }
+
+  [[nodiscard]] constexpr operator float() const noexcept { return detail::half_bits_to_float(bits_); }
+
+  constexpr float16& operator+=(float rhs) noexcept { return *this = float16(float(*this) + rhs); }
+  constexpr float16& operator-=(float rhs) noexcept { return *this = float16(float(*this) - rhs); }
+  constexpr float16& operator*=(float rhs) noexcept { return *this = float16(float(*this) * rhs); }
+  constexpr float16& operator/=(float rhs) noexcept { return *this = float16(float(*this) / rhs); }
+};
+
+/**
+ * @brief bfloat16 storage type
+ *
+ * The upper half of an IEEE 754 binary32 value: the range of `float` with 8 significant bits.
+ * Values are stored with rounding to nearest even and read as `float`.
+ */
+class bfloat16 {
+  std::uint16_t bits_{};
+
+public:
+  bfloat16() = default;
+
+  template<detail::arithmetic T>
+  constexpr bfloat16(T v) noexcept : bits_(detail::float_to_bfloat16_bits(static_cast<float>(v))) {}
+
+  [[nodiscard]] static constexpr bfloat16 from_bits(std::uint16_t bits) noexcept
+  {
+    bfloat16 v;
+    v.bits_ = bits;
+    return v;
+  }
+  [[nodiscard]] constexpr std::uint16_t bits() const noexcept { return bits_; }
+
+  [[nodiscard]] constexpr operator float() const noexcept { return detail::bfloat16_bits_to_float(bits_); }
+
+  constexpr bfloat16& operator+=(float rhs) noexcept { return *this = bfloat16(float(*this) + rhs); }
+  constexpr bfloat16& operator-=(float rhs) noexcept { return *this = bfloat16(float(*this) - rhs); }
+  constexpr bfloat16& operator*=(float rhs) noexcept { return *this = bfloat16(float(*this) * rhs); }
+  constexpr bfloat16& operator/=(float rhs) noexcept { return *this = bfloat16(float(*this) / rhs); }
+};
+
+/**
+ * @brief A 16-bit integer counting steps of `Scale`
+ *
+ * Stores a value `v` as the integer `v / Scale` and reads it back as `double`. For example,
+ * `si::thermodynamic_temperature<si::kelvin, scaled_int16<ratio(1, 100)>>` covers +-327.67 K
+ * with a resolution of 10 mK. Stored values are rounded to the nearest step and saturate at the
+ * ends of the range; NaN is stored as 0.
+ *
+ * @tparam Scale a value of one step expressed in the unit of the quantity
+ */
+template<ratio Scale>
+  requires (Scale.num > 0)
+class scaled_int16 {
+  std::int16_t raw_{};
+
+  static constexpr double step = static_cast<double>(Scale.num) / static_cast<double>(Scale.den) * detail::fpow10<double>(Scale.exp);
+  static constexpr double inv_step = static_cast<double>(Scale.den) / static_cast<double>(Scale.num) * detail::fpow10<double>(-Scale.exp);
+  // adding and subtracting it rounds to the nearest integer (magnitudes above 2^51 are saturated anyway)
+  static constexpr double round_magic = 6'755'399'441'055'744.0;
+
+  [[nodiscard]] static constexpr std::int16_t to_raw(double v) noexcept
+  {
+    // rounding first leaves only selects after the arithmetic, which keeps loops vectorizable
+    double s = (v * inv_step + round_magic) - round_magic;
+    s = s == s ? s : 0.;
+    s = s > 32767. ? 32767. : s;
+    s = s < -32768. ? -32768. : s;
+    return static_cast<std::int16_t>(s);
+  }
+
+public:
+  using raw_type = std::int16_t;
+  static constexpr ratio scale = Scale;
+
+  scaled_int16() = default;
+
+  template<detail::arithmetic T>
+  constexpr scaled_int16(T v) noexcept : raw_(to_raw(static_cast<double>(v))) {}
+
+  [[nodiscard]] static constexpr scaled_int16 from_raw(std::int16_t raw) noexcept
+  {
+    scaled_int16 v;
+    v.raw_ = raw;
+    return v;
+  }
+  [[nodiscard]] constexpr std::int16_t raw() const noexcept { return raw_; }
+
+  [[nodiscard]] constexpr operator double() const noexcept { return raw_ * step; }
+
+  constexpr scaled_int16& operator+=(double rhs) noexcept { return *this = scaled_int16(double(*this) + rhs); }
+  constexpr scaled_int16& operator-=(double rhs) noexcept { return *this = scaled_int16(double(*this) - rhs); }
+  constexpr scaled_int16& operator*=(double rhs) noexcept { return *this = scaled_int16(double(*this) * rhs); }
+  constexpr scaled_int16& operator/=(double rhs) noexcept { return *this = scaled_int16(double(*this) / rhs); }
+};
+
+namespace detail {
+
+template<typename T>
+inline constexpr bool is_compact_rep = false;
+
+template<>
+inline constexpr bool is_compact_rep<float16> = true;
+
+template<>
+inline constexpr bool is_compact_rep<bfloat16> = true;
+
+template<ratio Scale>
+inline constexpr bool is_compact_rep<scaled_int16<Scale>> = true;
+
+template<typename T>
+concept compact_rep = is_compact_rep<T>;
+
+// the type all the arithmetic on a compact representation is done in
+template<compact_rep T>
+using compact_rep_wide_t = decltype(+std::declval<T>());
+
+}  // namespace detail
+
+template<>
+inline constexpr bool treat_as_floating_point<float16> = true;
+
+template<>
+inline constexpr bool treat_as_floating_point<bfloat16> = true;
+
+template<ratio Scale>
+inline constexpr bool treat_as_floating_point<scaled_int16<Scale>> = true;
+
+template<>
+inline constexpr std::array<std::int64_t, 4> serialization_rep_id<float16>{detail::rep_id_name("float16")};
+
+template<>
+inline constexpr std::array<std::int64_t, 4> serialization_rep_id<bfloat16>{detail::rep_id_name("bfloat16")};
+
+template<ratio Scale>
+inline constexpr std::array<std::int64_t, 4> serialization_rep_id<scaled_int16<Scale>>{
+  detail::rep_id_name("sint16"), Scale.num, Scale.den, Scale.exp};
+
+template<>
+struct quantity_values<float16> {
+  static constexpr float16 zero() noexcept { return float16::from_bits(0x0000); }
+  static constexpr float16 one() noexcept { return float16::from_bits(0x3c00); }
+  static constexpr float16 min() noexcept { return float16::from_bits(0xfbff); }
+  static constexpr float16 max() noexcept { return float16::from_bits(0x7bff); }
+};
+
+template<>
+struct quantity_values<bfloat16> {
+  static constexpr bfloat16 zero() noexcept { return bfloat16::from_bits(0x0000); }
+  static constexpr bfloat16 one() noexcept { return bfloat16::from_bits(0x3f80); }
+  static constexpr bfloat16 min() noexcept { return bfloat16::from_bits(0xff7f); }
+  static constexpr bfloat16 max() noexcept { return bfloat16::from_bits(0x7f7f); }
+};
+
+template<ratio Scale>
+struct quantity_values<scaled_int16<Scale>> {
+  using rep = scaled_int16<Scale>;
+  static constexpr rep zero() noexcept { return rep::from_raw(0); }
+  static constexpr rep one() noexcept { return rep(1); }
+  static constexpr rep min() noexcept { return rep::from_raw(-32768); }
+  static constexpr rep max() noexcept { return rep::from_raw(32767); }
+};
+
+/**
+ * @brief Converts quantities to a compact representation
+ *
+ * `out[i] = quantity_cast<QOut>(in[i])` for every element. Units may differ as long as the
+ * dimensions are equivalent.
+ */
+template<typename QIn, std::size_t InExtent, typename QOut, std::size_t OutExtent>
+  requires std::floating_point<typename std::remove_const_t<QIn>::rep> &&
+           detail::compact_rep<typename QOut::rep> &&
+           QuantityOf<QOut, typename std::remove_const_t<QIn>::dimension>
+constexpr void pack(quantity_span<QIn, InExtent> in, quantity_span<QOut, OutExtent> out)
+{
+  Expects(in.size() == out.size());
+  for (std::size_t i = 0; i < in.size(); ++i) out[i] = quantity_cast<QOut>(in[i]);
+}
+
+/**
+ * @brief Converts quantities stored with a compact representation back to a floating-point one
+ *
+ * `out[i] = quantity_cast<QOut>(in[i])` for every element. Units may differ as long as the
+ * dimensions are equivalent.
+ */
+template<typename QIn, std::size_t InExtent, typename QOut, std::size_t OutExtent>
+  requires detail::compact_rep<typename std::remove_const_t<QIn>::rep> &&
+           std::floating_point<typename QOut::rep> &&
+           QuantityOf<QOut, typename std::remove_const_t<QIn>::dimension>
+constexpr void unpack(quantity_span<QIn, InExtent> in, quantity_span<QOut, OutExtent> out)
+{
+  Expects(in.size() == out.size());
+  for (std::size_t i = 0; i < in.size(); ++i) out[i] = quantity_cast<QOut>(in[i]);
+}
+
+}  // namespace units
+
+namespace std {
+
+// compact representations widen on arithmetic so their common type is the wide one
+template<units::detail::compact_rep T, units::detail::compact_rep U>
+struct common_type<T, U> : common_type<units::detail::compact_rep_wide_t<T>, units::detail::compact_rep_wide_t<U>> {};
+
+template<units::detail::compact_rep T, units::detail::arithmetic U>
+struct common_type<T, U> : common_type<units::detail::compact_rep_wide_t<T>, U> {};
+
+template<units::detail::arithmetic T, units::detail::compact_rep U>
+struct common_type<T, U> : common_type<T, units::detail::compact_rep_wide_t<U>> {};
+
+}  // namespace std
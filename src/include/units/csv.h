@@ -0,0 +1,436 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/charconv.h>
+#include <units/bits/joining_threads.h>
+#include <units/bits/unit_lookup.h>
+#include <units/quantity.h>
+#include <units/quantity_cast.h>
+#include <units/quantity_span.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <istream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Streaming reader of delimiter-separated numeric data (CSV, TSV)
+//
+// The first line of the input is a header naming the fields. A name may carry a unit annotation in
+// square brackets (i.e. `speed[km/h]`). The input is read in chunks of a fixed size, so the memory
+// usage does not depend on the length of the input. Every chunk is parsed with `std::from_chars()`
+// into the representation types of the selected columns and then converted to the target units with
+// `quantity_cast` in a single pass over each column.
+//
+// Empty lines are skipped. Quoted fields are supported only in the header.
+
+namespace units {
+
+/**
+ * @brief An error reported when the input does not match the requested columns or contains malformed values
+ */
+class csv_error : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+struct csv_options {
+  char delimiter = ',';                           ///< `'\t'` for TSV
+  std::size_t chunk_size = std::size_t(1) << 20;  ///< number of bytes read from the input at once
+  unsigned threads = 1;                           ///< number of threads parsing every chunk
+};
+
+/**
+ * @brief A column of quantities read by `csv_reader`
+ *
+ * The unit annotation of the field has to be a symbol of either `Q::unit` or one of `Us`. A field
+ * without an annotation is assumed to be expressed in `Q::unit`. A plain quantity type may be used
+ * instead of `csv_column<Q>`.
+ *
+ * @tparam Q the type of the quantities in the column
+ * @tparam Us additional units accepted in the input
+ */
+template<Quantity Q, Unit... Us>
+  requires std::is_arithmetic_v<typename Q::rep> && (!std::is_same_v<typename Q::rep, bool>) &&
+           (UnitOf<Us, typename Q::dimension> && ...)
+struct csv_column {
+  using quantity_type = Q;
+};
+
+namespace detail {
+
+template<typename T>
+struct csv_column_traits;
+
+template<Quantity Q>
+struct csv_column_traits<Q> : csv_column_traits<csv_column<Q>> {};
+
+template<Quantity Q, Unit... Us>
+struct csv_column_traits<csv_column<Q, Us...>> {
+  using quantity_type = Q;
+  using rep = TYPENAME Q::rep;
+  using dimension = TYPENAME Q::dimension;
+
+  static constexpr std::size_t unit_count = sizeof...(Us) + 1;
+
+  // the index of the unit of the field or `unit_count` if the unit is not accepted
+  [[nodiscard]] static constexpr std::size_t find_unit(std::string_view symbol) noexcept
+  {
+    if (symbol.empty()) return 0;
+    return find_unit_by_symbol<dimension, typename Q::unit, Us...>(symbol);
+  }
+
+  static void convert(std::size_t unit, std::span<const rep> in, Q* out)
+  {
+    convert_from<typename Q::unit, Us...>(unit, in, out);
+  }
+
+private:
+  template<Unit... All>
+  static void convert_from(std::size_t unit, std::span<const rep> in, Q* out)
+  {
+    std::size_t index = 0;
+    static_cast<void>(((unit == index++ ? (convert_from<All>(in, out), true) : false) || ...));
+  }
+
+  template<Unit U>
+  static void convert_from(std::span<const rep> in, Q* out)
+  {
+    using from = quantity<dimension, U, rep>;
+    for (std::size_t i = 0; i < in.size(); ++i) out[i] = quantity_cast<Q>(from(in[i]));
+  }
+};
+
+struct csv_field {
+  std::string name;
+  std::string unit;
+};
+
+[[nodiscard]] inline std::string_view csv_trim(std::string_view txt) noexcept
+{
+  const auto first = txt.find_first_not_of(" \r");
+  if (first == std::string_view::npos) return {};
+  return txt.substr(first, txt.find_last_not_of(" \r") - first + 1);
+}
+
+// splits the header line into field names and unit annotations
+[[nodiscard]] inline std::vector<csv_field> parse_csv_header(std::string_view line, char delimiter)
+{
+  std::vector<csv_field> fields;
+  while (true) {
+    const auto end = line.find(delimiter);
+    std::string_view txt = csv_trim(line.substr(0, end));
+    if (txt.size() >= 2 && txt.front() == '"' && txt.back() == '"') txt = csv_trim(txt.substr(1, txt.size() - 2));
+
+    csv_field& field = fields.emplace_back();
+    if (const auto open = txt.find('['); open != std::string_view::npos && txt.back() == ']') {
+      field.name = csv_trim(txt.substr(0, open));
+      field.unit = csv_trim(txt.substr(open + 1, txt.size() - open - 2));
+    } else {
+      field.name = txt;
+    }
+
+    if (end == std::string_view::npos) break;
+    line.remove_prefix(end + 1);
+  }
+  return fields;
+}
+
+// parses the whole field allowing leading `+` and surrounding spaces
+template<typename Rep>
+[[nodiscard]] bool parse_csv_value(const char* first, const char* last, Rep& value)
+{
+  while (first != last && *first == ' ') ++first;
+  if (first != last && *first == '+') ++first;
+  const auto [ptr, ec] = detail::from_chars(first, last, value);
+  if (ec != std::errc{}) return false;
+  return std::all_of(ptr, last, [](char c) { return c == ' ' || c == '\r'; });
+}
+
+}  // namespace detail
+
+/**
+ * @brief A streaming reader of delimiter-separated columns of quantities
+ *
+ * Every call to `next()` reads the next chunk of the input and makes the complete rows in it
+ * available as contiguous columns of quantities. The columns stay valid until the next call
+ * to `next()`.
+ *
+ * @code{.cpp}
+ * csv_reader<csv_column<si::speed<si::metre_per_second>, si::kilometre_per_hour>, si::time<si::second>> reader(file, {"speed", "time"});
+ * while (reader.next()) {
+ *   for (const auto& v : reader.column<0>()) ...
+ * }
+ * @endcode
+ *
+ * @tparam Columns `csv_column` or quantity types of the columns to read
+ */
+template<typename... Columns>
+  requires (sizeof...(Columns) > 0)
+class csv_reader {
+  static constexpr std::size_t column_count = sizeof...(Columns);
+
+  template<std::size_t I>
+  using traits = detail::csv_column_traits<std::tuple_element_t<I, std::tuple<Columns...>>>;
+
+  using raw_columns = std::tuple<std::vector<typename detail::csv_column_traits<Columns>::rep>...>;
+
+  struct field_binding {
+    std::size_t field;
+    std::size_t column;
+  };
+
+public:
+  template<std::size_t I>
+  using quantity_type = TYPENAME traits<I>::quantity_type;
+
+  /**
+   * @brief Reads the header of `in` and binds the columns to the fields with the provided names
+   *
+   * @throws csv_error if a field is missing or has a unit annotation not accepted by its column
+   */
+  csv_reader(std::istream& in, const std::array<std::string_view, column_count>& names, csv_options options = {}) :
+    in_(in), options_(options), buffer_(std::max<std::size_t>(options.chunk_size, 1)), raw_(std::max(options.threads, 1u))
+  {
+    std::string line;
+    if (!std::getline(in_, line)) throw csv_error("csv: missing header");
+    const std::vector<detail::csv_field> fields = detail::parse_csv_header(line, options_.delimiter);
+
+    bind(names, fields, std::make_index_sequence<column_count>());
+    std::ranges::sort(bindings_, {}, &field_binding::field);
+  }
+
+  /**
+   * @brief Reads the next chunk of the input
+   *
+   * @return `false` if the end of the input was reached
+   *
+   * @throws csv_error if the chunk contains malformed values or lines with not enough fields
+   */
+  [[nodiscard]] bool next()
+  {
+    size_ = 0;
+    while (!eof_ || carry_ > 0) {
+      std::size_t count = carry_;
+      if (!eof_) {
+        const std::size_t requested = buffer_.size() - carry_;
+        in_.read(buffer_.data() + carry_, static_cast<std::streamsize>(requested));
+        if (in_.bad()) throw csv_error("csv: read error");
+        const auto got = static_cast<std::size_t>(in_.gcount());
+        eof_ = got < requested;
+        count += got;
+      }
+
+      // only complete lines are parsed, the rest waits for the next chunk
+      std::size_t end = count;
+      if (!eof_) {
+        const auto last_eol = std::string_view(buffer_.data(), count).rfind('\n');
+        if (last_eol == std::string_view::npos) {
+          // a line longer than the chunk
+          carry_ = count;
+          buffer_.resize(buffer_.size() * 2);
+          continue;
+        }
+        end = last_eol + 1;
+      }
+
+      parse(buffer_.data(), buffer_.data() + end, std::make_index_sequence<column_count>());
+      line_ += static_cast<std::size_t>(std::count(buffer_.data(), buffer_.data() + end, '\n'));
+      carry_ = count - end;
+      std::memmove(buffer_.data(), buffer_.data() + end, carry_);
+      if (size_ > 0) return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief The number of rows read by the last call to `next()`
+   */
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+  /**
+   * @brief The quantities of the `I`-th column read by the last call to `next()`
+   */
+  template<std::size_t I>
+    requires (I < column_count)
+  [[nodiscard]] quantity_span<const quantity_type<I>> column() const noexcept
+  {
+    return quantity_span<const quantity_type<I>>(std::get<I>(columns_).data(), size_);
+  }
+
+private:
+  std::istream& in_;
+  csv_options options_;
+  std::array<std::string, column_count> names_;
+  std::array<std::size_t, column_count> units_{};  // index of the unit of every column
+  std::vector<field_binding> bindings_;             // sorted by the field index
+  std::vector<char> buffer_;
+  std::size_t carry_ = 0;  // number of bytes of an incomplete line at the beginning of `buffer_`
+  std::size_t line_ = 2;   // number of the line at the beginning of `buffer_`
+  bool eof_ = false;
+  std::size_t size_ = 0;
+  std::vector<raw_columns> raw_;  // values parsed by each thread
+  std::tuple<std::vector<typename detail::csv_column_traits<Columns>::quantity_type>...> columns_;
+
+  template<std::size_t... Is>
+  void bind(const std::array<std::string_view, column_count>& names, const std::vector<detail::csv_field>& fields,
+            std::index_sequence<Is...>)
+  {
+    (bind_column<Is>(names[Is], fields), ...);
+  }
+
+  template<std::size_t I>
+  void bind_column(std::string_view name, const std::vector<detail::csv_field>& fields)
+  {
+    names_[I] = name;
+    const auto it = std::ranges::find(fields, name, &detail::csv_field::name);
+    if (it == fields.end()) throw csv_error("csv: column '" + names_[I] + "' not found");
+
+    units_[I] = traits<I>::find_unit(it->unit);
+    if (units_[I] == traits<I>::unit_count)
+      throw csv_error("csv: unsupported unit '" + it->unit + "' of column '" + names_[I] + "'");
+
+    bindings_.push_back({static_cast<std::size_t>(it - fields.begin()), I});
+  }
+
+  template<std::size_t I>
+  static bool store(raw_columns& raw, const char* first, const char* last)
+  {
+    typename traits<I>::rep value{};
+    if (!detail::parse_csv_value(first, last, value)) return false;
+    std::get<I>(raw).push_back(value);
+    return true;
+  }
+
+  template<std::size_t... Is>
+  static constexpr auto store_table(std::index_sequence<Is...>)
+  {
+    using store_fn = bool (*)(raw_columns&, const char*, const char*);
+    return std::array<store_fn, column_count>{&store<Is>...};
+  }
+
+  [[noreturn]] void fail(const char* chunk, const char* pos, std::size_t column, const char* what) const
+  {
+    const auto line = line_ + static_cast<std::size_t>(std::count(chunk, pos, '\n'));
+    throw csv_error("csv: " + std::string(what) + " of column '" + names_[column] + "' at line " + std::to_string(line));
+  }
+
+  // parses complete lines in [first, last)
+  void parse_block(const char* chunk, const char* first, const char* last, raw_columns& raw) const
+  {
+    static constexpr auto stores = store_table(std::make_index_sequence<column_count>());
+    const char delimiter = options_.delimiter;
+
+    while (first != last) {
+      const char* eol = static_cast<const char*>(std::memchr(first, '\n', static_cast<std::size_t>(last - first)));
+      if (eol == nullptr) eol = last;
+      const char* line_end = eol;
+      if (line_end != first && line_end[-1] == '\r') --line_end;
+
+      if (line_end != first) {
+        const char* pos = first;
+        std::size_t field = 0;
+        for (const field_binding& b : bindings_) {
+          for (; field < b.field; ++field) {
+            pos = static_cast<const char*>(std::memchr(pos, delimiter, static_cast<std::size_t>(line_end - pos)));
+            if (pos == nullptr) fail(chunk, first, b.column, "missing value");
+            ++pos;
+          }
+          const char* end = static_cast<const char*>(std::memchr(pos, delimiter, static_cast<std::size_t>(line_end - pos)));
+          if (end == nullptr) end = line_end;
+          if (!stores[b.column](raw, pos, end)) fail(chunk, first, b.column, "invalid value");
+        }
+      }
+
+      first = eol == last ? last : eol + 1;
+    }
+  }
+
+  template<std::size_t... Is>
+  void parse(const char* first, const char* last, std::index_sequence<Is...>)
+  {
+    for (raw_columns& raw : raw_) (std::get<Is>(raw).clear(), ...);
+
+    const std::size_t parts = raw_.size();
+    if (parts == 1) {
+      parse_block(first, first, last, raw_.front());
+    } else {
+      // every thread gets a range of complete lines of a similar length
+      std::vector<const char*> bounds;
+      bounds.reserve(parts + 1);
+      bounds.push_back(first);
+      for (std::size_t i = 1; i < parts; ++i) {
+        const char* split = std::max(bounds.back(), first + (last - first) * static_cast<std::ptrdiff_t>(i) / static_cast<std::ptrdiff_t>(parts));
+        const char* eol = static_cast<const char*>(std::memchr(split, '\n', static_cast<std::size_t>(last - split)));
+        bounds.push_back(eol == nullptr ? last : eol + 1);
+      }
+      bounds.push_back(last);
+
+      std::vector<std::exception_ptr> errors(parts);
+      const auto work = [&](std::size_t i) {
+        try {
+          parse_block(first, bounds[i], bounds[i + 1], raw_[i]);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      };
+      detail::joining_threads workers(parts - 1);
+      for (std::size_t i = 1; i < parts; ++i) workers.start(work, i);
+      work(0);
+      workers.join();
+      for (const std::exception_ptr& e : errors)
+        if (e) std::rethrow_exception(e);
+    }
+
+    size_ = std::get<0>(raw_.front()).size();
+    for (std::size_t i = 1; i < parts; ++i) size_ += std::get<0>(raw_[i]).size();
+    (convert<Is>(), ...);
+  }
+
+  // converts the values parsed by all threads to the target quantities
+  template<std::size_t I>
+  void convert()
+  {
+    auto& out = std::get<I>(columns_);
+    out.resize(size_);
+    std::size_t offset = 0;
+    for (const raw_columns& raw : raw_) {
+      const auto& values = std::get<I>(raw);
+      traits<I>::convert(units_[I], values, out.data() + offset);
+      offset += values.size();
+    }
+  }
+};
+
+}  // namespace units
@@ -23,7 +23,10 @@
 #pragma once
 
 #include <units/concepts.h>
+#include <array>
+#include <cstdint>
 #include <limits>
+#include <string_view>
 #include <type_traits>
 
 namespace units {
@@ -40,6 +43,10 @@ namespace units {
 template<ScalableNumber Rep>
 inline constexpr bool treat_as_floating_point = std::is_floating_point_v<Rep>;
 
+template<ScalableNumber Rep>
+  requires detail::data_parallel<Rep>
+inline constexpr bool treat_as_floating_point<Rep> = treat_as_floating_point<typename Rep::value_type>;
+
 /**
  * @brief A type trait that defines zero, one, min, and max for a representation type
  * 
@@ -57,4 +64,40 @@ struct quantity_values {
   static constexpr Rep max() noexcept { return std::numeric_limits<Rep>::max(); }
 };
 
+template<ScalableNumber Rep>
+  requires detail::data_parallel<Rep>
+struct quantity_values<Rep> {
+  static constexpr Rep zero() noexcept { return Rep(quantity_values<typename Rep::value_type>::zero()); }
+  static constexpr Rep one() noexcept { return Rep(quantity_values<typename Rep::value_type>::one()); }
+  static constexpr Rep min() noexcept { return Rep(quantity_values<typename Rep::value_type>::min()); }
+  static constexpr Rep max() noexcept { return Rep(quantity_values<typename Rep::value_type>::max()); }
+};
+
+namespace detail {
+
+// packs up to 8 characters of `name` into an integer (used as the first element of `serialization_rep_id`)
+[[nodiscard]] constexpr std::int64_t rep_id_name(std::string_view name) noexcept
+{
+  std::uint64_t v = 0;
+  for (std::size_t i = 0; i < name.size() && i < 8; ++i)
+    v |= static_cast<std::uint64_t>(static_cast<unsigned char>(name[i])) << (8 * i);
+  return static_cast<std::int64_t>(v);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Identifies the binary encoding of a custom representation type in serialized data
+ *
+ * Serialized records of quantities with a non-arithmetic representation type carry this identifier
+ * and are read back only into a representation type of the same size and identifier. It has to be
+ * specialized for every custom representation type that is serialized: the first element names the
+ * encoding (i.e. `detail::rep_id_name("float16")`) and the rest hold the parameters that change
+ * the meaning of its bits (i.e. a number of fractional bits). All zeros mean "not identified".
+ *
+ * @tparam Rep a representation type for which the identifier is defined
+ */
+template<typename Rep>
+inline constexpr std::array<std::int64_t, 4> serialization_rep_id{};
+
 } // namespace units
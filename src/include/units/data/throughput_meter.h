@@ -0,0 +1,183 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/clock.h>
+#include <units/data/data.h>
+#include <units/physical/bits/time.h>
+#include <units/quantity_cast.h>
+#include <gsl/gsl_assert>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace units::data {
+
+namespace detail {
+
+inline constexpr std::size_t cache_line_size = 64;
+
+struct alignas(cache_line_size) counter_shard {
+  std::atomic<std::int64_t> value{0};
+};
+
+// shards are assigned to threads round-robin on their first use
+inline std::size_t thread_shard() noexcept
+{
+  static std::atomic<std::size_t> next{0};
+  thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+}  // namespace detail
+
+/**
+ * @brief A lock-free meter of the throughput of data
+ *
+ * `add()` may be called concurrently from any number of threads. It is a single relaxed atomic
+ * increment of a counter on a cache line shared only by a subset of the threads (threads are
+ * spread across `Shards` counters) so the I/O paths being measured do not contend on the meter.
+ *
+ * Rates are estimated from samples of the total taken by a single monitoring thread with
+ * `sample()`, i.e. periodically from a timer. `rate()` computes the average throughput over
+ * a sliding window of the last samples and `ewma()` an exponentially weighted moving average
+ * updated with every sample.
+ *
+ * @tparam Shards the number of counters
+ * @tparam History the number of samples kept for the sliding window
+ */
+template<std::size_t Shards = 16, std::size_t History = 64>
+  requires (Shards > 0 && History > 1)
+class basic_throughput_meter {
+public:
+  using information_type = information<bit, std::int64_t>;
+  using bitrate_type = bitrate<bit_per_second>;
+
+  /**
+   * @param time_constant the time constant of the exponentially weighted moving average
+   */
+  explicit basic_throughput_meter(const physical::si::time<physical::si::second>& time_constant = physical::si::time<physical::si::second>(1.)) :
+      time_constant_(time_constant.count())
+  {
+    Expects(time_constant_ > 0);
+  }
+
+  basic_throughput_meter(const basic_throughput_meter&) = delete;
+  basic_throughput_meter& operator=(const basic_throughput_meter&) = delete;
+
+  /**
+   * @brief Accounts an amount of transferred data
+   */
+  void add(const information_type& amount) noexcept
+  {
+    shards_[detail::thread_shard() % Shards].value.fetch_add(amount.count(), std::memory_order_relaxed);
+  }
+
+  template<Information I>
+  void add(const I& amount) noexcept
+  {
+    add(quantity_cast<information_type>(amount));
+  }
+
+  /**
+   * @brief The amount of data accounted so far
+   */
+  [[nodiscard]] information_type total() const noexcept
+  {
+    std::int64_t sum = 0;
+    for (const auto& s : shards_) sum += s.value.load(std::memory_order_relaxed);
+    return information_type(sum);
+  }
+
+  /**
+   * @brief Samples the total at `now` and updates the moving average
+   *
+   * Must be called from a single thread (the same one as `rate()` and `ewma()`) with
+   * non-decreasing time points.
+   */
+  void sample(const clock::time_point& now = clock::steady::now()) noexcept
+  {
+    const sample_type s{now, total()};
+    if (size_ > 0) {
+      const sample_type& prev = samples_[(head_ + History - 1) % History];
+      const auto dt = seconds(s.time - prev.time);
+      if (dt > 0) {
+        const double instant = static_cast<double>((s.total - prev.total).count()) / dt;
+        const double alpha = 1 - std::exp(-dt / time_constant_);
+        ewma_ = size_ == 1 ? instant : ewma_ + alpha * (instant - ewma_);
+      }
+    }
+    samples_[head_] = s;
+    head_ = (head_ + 1) % History;
+    if (size_ < History) ++size_;
+  }
+
+  /**
+   * @brief The average throughput over the last `window`
+   *
+   * The window starts at the newest sample that is at least `window` older than the last one
+   * (or at the oldest sample kept). Returns zero if there are less than two samples.
+   */
+  template<physical::Time T>
+  [[nodiscard]] bitrate_type rate(const T& window) const noexcept
+  {
+    if (size_ < 2) return bitrate_type::zero();
+    const clock::duration w = quantity_cast<clock::duration>(window);
+    const sample_type& last = samples_[(head_ + History - 1) % History];
+    const sample_type* first = nullptr;
+    for (std::size_t i = 2; i <= size_; ++i) {
+      first = &samples_[(head_ + History - i) % History];
+      if (last.time - first->time >= w) break;
+    }
+    const double dt = seconds(last.time - first->time);
+    if (dt <= 0) return bitrate_type::zero();
+    return bitrate_type(static_cast<double>((last.total - first->total).count()) / dt);
+  }
+
+  /**
+   * @brief The exponentially weighted moving average of the throughput
+   */
+  [[nodiscard]] bitrate_type ewma() const noexcept { return bitrate_type(ewma_); }
+
+private:
+  struct sample_type {
+    clock::time_point time;
+    information_type total;
+  };
+
+  std::array<detail::counter_shard, Shards> shards_{};
+  std::array<sample_type, History> samples_{};
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+  double time_constant_;
+  double ewma_ = 0;
+
+  [[nodiscard]] static double seconds(const clock::duration& d) noexcept { return static_cast<double>(d.count()) * 1e-9; }
+};
+
+using throughput_meter = basic_throughput_meter<>;
+
+}  // namespace units::data
@@ -0,0 +1,402 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/constexpr_math.h>
+#include <units/generic/angle.h>
+#include <units/math.h>
+#include <units/quantity_cast.h>
+#include <gsl/gsl_assert>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+namespace units {
+
+/**
+ * @brief A dual number for forward-mode automatic differentiation
+ *
+ * Holds a value and its partial derivatives with respect to `N` independent variables. The
+ * partials are stored contiguously and every operation updates all of them in a single loop
+ * over the lanes, so a whole gradient is computed in one pass (vectorized for `N` > 1).
+ *
+ * Used as a representation type of a quantity it propagates derivatives through quantity
+ * arithmetic and `<units/math.h>`. Seed independent variables with `make_dual()` and read the
+ * results with `primal()` and `derivative()` which return quantities of proper dimensions
+ * (i.e. a derivative of an energy with respect to a length is a force).
+ *
+ * @tparam T the type of the value and of the partials
+ * @tparam N the number of independent variables (lanes)
+ */
+template<std::floating_point T, std::size_t N = 1>
+  requires (N > 0)
+class dual {
+public:
+  using value_type = T;
+  using partials_type = std::array<T, N>;
+  static constexpr std::size_t lanes = N;
+
+  dual() = default;
+
+  /**
+   * @brief A constant (all partials are zero)
+   */
+  constexpr dual(const value_type& v) noexcept : value_(v) {}
+
+  constexpr dual(const value_type& v, const partials_type& partials) noexcept : value_(v), partials_(partials) {}
+
+  /**
+   * @brief An independent variable with the partial of the `lane` set to one
+   */
+  [[nodiscard]] static constexpr dual variable(const value_type& v, std::size_t lane)
+  {
+    Expects(lane < N);
+    dual d(v);
+    d.partials_[lane] = T(1);
+    return d;
+  }
+
+  [[nodiscard]] constexpr const value_type& value() const noexcept { return value_; }
+  [[nodiscard]] constexpr const partials_type& partials() const noexcept { return partials_; }
+  [[nodiscard]] constexpr const value_type& partial(std::size_t lane) const
+  {
+    Expects(lane < N);
+    return partials_[lane];
+  }
+
+  [[nodiscard]] constexpr dual operator+() const noexcept { return *this; }
+  [[nodiscard]] constexpr dual operator-() const noexcept
+  {
+    return map(-value_, [&](std::size_t i) { return -partials_[i]; });
+  }
+
+  [[nodiscard]] friend constexpr dual operator+(const dual& lhs, const dual& rhs) noexcept
+  {
+    return map(lhs.value_ + rhs.value_, [&](std::size_t i) { return lhs.partials_[i] + rhs.partials_[i]; });
+  }
+
+  [[nodiscard]] friend constexpr dual operator-(const dual& lhs, const dual& rhs) noexcept
+  {
+    return map(lhs.value_ - rhs.value_, [&](std::size_t i) { return lhs.partials_[i] - rhs.partials_[i]; });
+  }
+
+  [[nodiscard]] friend constexpr dual operator*(const dual& lhs, const dual& rhs) noexcept
+  {
+    return map(lhs.value_ * rhs.value_,
+               [&](std::size_t i) { return lhs.partials_[i] * rhs.value_ + rhs.partials_[i] * lhs.value_; });
+  }
+
+  [[nodiscard]] friend constexpr dual operator/(const dual& lhs, const dual& rhs) noexcept
+  {
+    const T inv = T(1) / rhs.value_;
+    const T val = lhs.value_ * inv;
+    return map(val, [&](std::size_t i) { return (lhs.partials_[i] - val * rhs.partials_[i]) * inv; });
+  }
+
+  [[nodiscard]] friend constexpr dual operator+(const dual& lhs, const value_type& rhs) noexcept { return dual(lhs.value_ + rhs, lhs.partials_); }
+  [[nodiscard]] friend constexpr dual operator+(const value_type& lhs, const dual& rhs) noexcept { return rhs + lhs; }
+  [[nodiscard]] friend constexpr dual operator-(const dual& lhs, const value_type& rhs) noexcept { return dual(lhs.value_ - rhs, lhs.partials_); }
+  [[nodiscard]] friend constexpr dual operator-(const value_type& lhs, const dual& rhs) noexcept { return -rhs + lhs; }
+
+  [[nodiscard]] friend constexpr dual operator*(const dual& lhs, const value_type& rhs) noexcept
+  {
+    return map(lhs.value_ * rhs, [&](std::size_t i) { return lhs.partials_[i] * rhs; });
+  }
+
+  [[nodiscard]] friend constexpr dual operator*(const value_type& lhs, const dual& rhs) noexcept { return rhs * lhs; }
+
+  [[nodiscard]] friend constexpr dual operator/(const dual& lhs, const value_type& rhs) noexcept { return lhs * (T(1) / rhs); }
+
+  [[nodiscard]] friend constexpr dual operator/(const value_type& lhs, const dual& rhs) noexcept
+  {
+    const T inv = T(1) / rhs.value_;
+    const T val = lhs * inv;
+    return chain(rhs, val, -val * inv);
+  }
+
+  constexpr dual& operator+=(const dual& rhs) noexcept { return *this = *this + rhs; }
+  constexpr dual& operator-=(const dual& rhs) noexcept { return *this = *this - rhs; }
+  constexpr dual& operator*=(const dual& rhs) noexcept { return *this = *this * rhs; }
+  constexpr dual& operator/=(const dual& rhs) noexcept { return *this = *this / rhs; }
+
+  [[nodiscard]] friend constexpr bool operator==(const dual&, const dual&) = default;
+
+  /**
+   * @brief Applies the chain rule
+   *
+   * @return a dual number with the value `f` and the partials of `x` scaled by `df`
+   *         (the derivative of the function at `x.value()`)
+   */
+  [[nodiscard]] friend constexpr dual chain(const dual& x, const value_type& f, const value_type& df) noexcept
+  {
+    return map(f, [&](std::size_t i) { return x.partials_[i] * df; });
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const dual& v)
+  {
+    os << v.value_ << " [";
+    for (std::size_t i = 0; i < N; ++i) os << (i ? ", " : "") << v.partials_[i];
+    return os << ']';
+  }
+
+private:
+  value_type value_{};
+  partials_type partials_{};
+
+  template<typename F>
+  [[nodiscard]] static constexpr dual map(const value_type& v, F f) noexcept
+  {
+    dual ret(v);
+    for (std::size_t i = 0; i < N; ++i) ret.partials_[i] = f(i);
+    return ret;
+  }
+};
+
+template<std::floating_point T, std::size_t N>
+inline constexpr bool treat_as_floating_point<dual<T, N>> = true;
+
+template<std::floating_point T, std::size_t N>
+struct quantity_values<dual<T, N>> {
+  static constexpr dual<T, N> zero() noexcept { return dual<T, N>(T(0)); }
+  static constexpr dual<T, N> one() noexcept { return dual<T, N>(T(1)); }
+  static constexpr dual<T, N> min() noexcept { return dual<T, N>(std::numeric_limits<T>::lowest()); }
+  static constexpr dual<T, N> max() noexcept { return dual<T, N>(std::numeric_limits<T>::max()); }
+};
+
+// functions of a dual number
+
+template<std::intmax_t Exp, std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr dual<T, N> pow(const dual<T, N>& x)
+{
+  if constexpr (Exp == 0) {
+    return dual<T, N>(T(1));
+  } else if constexpr (Exp < 0) {
+    return T(1) / pow<-Exp>(x);
+  } else {
+    const T prev = detail::pow_by_squaring(x.value(), Exp - 1);
+    return chain(x, prev * x.value(), T(Exp) * prev);
+  }
+}
+
+template<std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr dual<T, N> sqrt(const dual<T, N>& x)
+{
+  const T f = detail::sqrt(x.value());
+  return chain(x, f, T(1) / (T(2) * f));
+}
+
+template<std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr dual<T, N> cbrt(const dual<T, N>& x)
+{
+  const T f = detail::cbrt(x.value());
+  return chain(x, f, T(1) / (T(3) * f * f));
+}
+
+template<std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr dual<T, N> abs(const dual<T, N>& x)
+{
+  return x.value() < T(0) ? -x : x;
+}
+
+template<std::floating_point T, std::size_t N>
+[[nodiscard]] inline dual<T, N> exp(const dual<T, N>& x)
+{
+  const T f = std::exp(x.value());
+  return chain(x, f, f);
+}
+
+template<std::floating_point T, std::size_t N>
+[[nodiscard]] inline dual<T, N> log(const dual<T, N>& x)
+{
+  return chain(x, std::log(x.value()), T(1) / x.value());
+}
+
+template<std::floating_point T, std::size_t N>
+[[nodiscard]] inline dual<T, N> sin(const dual<T, N>& x)
+{
+  return chain(x, std::sin(x.value()), std::cos(x.value()));
+}
+
+template<std::floating_point T, std::size_t N>
+[[nodiscard]] inline dual<T, N> cos(const dual<T, N>& x)
+{
+  return chain(x, std::cos(x.value()), -std::sin(x.value()));
+}
+
+template<std::floating_point T, std::size_t N>
+[[nodiscard]] inline dual<T, N> tan(const dual<T, N>& x)
+{
+  const T f = std::tan(x.value());
+  return chain(x, f, T(1) + f * f);
+}
+
+template<std::floating_point T, std::size_t N>
+[[nodiscard]] inline dual<T, N> asin(const dual<T, N>& x)
+{
+  return chain(x, std::asin(x.value()), T(1) / std::sqrt(T(1) - x.value() * x.value()));
+}
+
+template<std::floating_point T, std::size_t N>
+[[nodiscard]] inline dual<T, N> acos(const dual<T, N>& x)
+{
+  return chain(x, std::acos(x.value()), T(-1) / std::sqrt(T(1) - x.value() * x.value()));
+}
+
+template<std::floating_point T, std::size_t N>
+[[nodiscard]] inline dual<T, N> atan(const dual<T, N>& x)
+{
+  return chain(x, std::atan(x.value()), T(1) / (T(1) + x.value() * x.value()));
+}
+
+template<std::floating_point T, std::size_t N>
+[[nodiscard]] inline dual<T, N> atan2(const dual<T, N>& y, const dual<T, N>& x)
+{
+  const T inv = T(1) / (x.value() * x.value() + y.value() * y.value());
+  typename dual<T, N>::partials_type d;
+  for (std::size_t i = 0; i < N; ++i) d[i] = (x.value() * y.partials()[i] - y.value() * x.partials()[i]) * inv;
+  return dual<T, N>(std::atan2(y.value(), x.value()), d);
+}
+
+// quantities with dual representation
+
+/**
+ * @brief Makes the independent variable of the lane `I`
+ *
+ * @tparam I the lane of the variable
+ * @tparam N the number of lanes (independent variables)
+ */
+template<std::size_t I, std::size_t N = I + 1, typename D, typename U, std::floating_point T>
+  requires (I < N)
+[[nodiscard]] constexpr quantity<D, U, dual<T, N>> make_dual(const quantity<D, U, T>& q)
+{
+  return quantity<D, U, dual<T, N>>(dual<T, N>::variable(q.count(), I));
+}
+
+/**
+ * @brief The value of a quantity without its derivatives
+ */
+template<typename D, typename U, std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr quantity<D, U, T> primal(const quantity<D, U, dual<T, N>>& q) noexcept
+{
+  return quantity<D, U, T>(q.count().value());
+}
+
+/**
+ * @brief The partial derivative of `y` with respect to the independent variable of the lane `I`
+ *
+ * @param y the dependent quantity
+ * @param wrt the independent variable (only its type is used)
+ * @return the derivative as a quantity of the dimension of `y` divided by the dimension of `wrt`
+ */
+template<std::size_t I = 0, typename D, typename U, std::floating_point T, std::size_t N, typename DX, typename UX, typename RepX>
+  requires (I < N)
+[[nodiscard]] constexpr Quantity auto derivative(const quantity<D, U, dual<T, N>>& y, const quantity<DX, UX, RepX>&)
+{
+  using ret = decltype(std::declval<quantity<D, U, T>>() / std::declval<quantity<DX, UX, T>>());
+  return ret(y.count().partial(I));
+}
+
+// (more specialized than the overloads in <units/math.h> and <units/trigonometry.h> so they are always preferred)
+
+template<std::intmax_t Exp, typename D, typename U, std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr auto pow(const quantity<D, U, dual<T, N>>& q)
+{
+  if constexpr (Exp == 0) {
+    return dual<T, N>(T(1));
+  } else {
+    using dim = dimension_pow<D, Exp>;
+    using unit = downcast_unit<dim, pow<Exp>(U::ratio)>;
+    return quantity<dim, unit, dual<T, N>>(pow<Exp>(q.count()));
+  }
+}
+
+template<typename D, typename U, std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr Quantity auto sqrt(const quantity<D, U, dual<T, N>>& q)
+{
+  using dim = dimension_sqrt<D>;
+  using unit = downcast_unit<dim, sqrt(U::ratio)>;
+  return quantity<dim, unit, dual<T, N>>(sqrt(q.count()));
+}
+
+template<typename D, typename U, std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr Quantity auto cbrt(const quantity<D, U, dual<T, N>>& q)
+{
+  using dim = dimension_cbrt<D>;
+  using unit = downcast_unit<dim, cbrt(U::ratio)>;
+  return quantity<dim, unit, dual<T, N>>(cbrt(q.count()));
+}
+
+template<typename D, typename U, std::floating_point T, std::size_t N>
+[[nodiscard]] constexpr quantity<D, U, dual<T, N>> abs(const quantity<D, U, dual<T, N>>& q)
+{
+  return quantity<D, U, dual<T, N>>(abs(q.count()));
+}
+
+template<typename U, std::floating_point T, std::size_t N>
+[[nodiscard]] inline dimensionless<one, dual<T, N>> exp(const quantity<dim_one, U, dual<T, N>>& q)
+{
+  return dimensionless<one, dual<T, N>>(exp(q.count() * detail::quantity_scale<dimensionless<U, T>, dimensionless<one, T>>));
+}
+
+template<typename U, std::floating_point T, std::size_t N>
+[[nodiscard]] inline Dimensionless auto sin(const quantity<dim_angle<>, U, dual<T, N>>& q)
+{
+  return dimensionless<one, dual<T, N>>(sin(q.count() * detail::quantity_scale<angle<U, T>, angle<radian, T>>));
+}
+
+template<typename U, std::floating_point T, std::size_t N>
+[[nodiscard]] inline Dimensionless auto cos(const quantity<dim_angle<>, U, dual<T, N>>& q)
+{
+  return dimensionless<one, dual<T, N>>(cos(q.count() * detail::quantity_scale<angle<U, T>, angle<radian, T>>));
+}
+
+template<typename U, std::floating_point T, std::size_t N>
+[[nodiscard]] inline Dimensionless auto tan(const quantity<dim_angle<>, U, dual<T, N>>& q)
+{
+  return dimensionless<one, dual<T, N>>(tan(q.count() * detail::quantity_scale<angle<U, T>, angle<radian, T>>));
+}
+
+template<typename U, std::floating_point T, std::size_t N>
+[[nodiscard]] inline Angle auto asin(const quantity<dim_one, U, dual<T, N>>& q)
+{
+  return angle<radian, dual<T, N>>(asin(q.count() * detail::quantity_scale<dimensionless<U, T>, dimensionless<one, T>>));
+}
+
+template<typename U, std::floating_point T, std::size_t N>
+[[nodiscard]] inline Angle auto acos(const quantity<dim_one, U, dual<T, N>>& q)
+{
+  return angle<radian, dual<T, N>>(acos(q.count() * detail::quantity_scale<dimensionless<U, T>, dimensionless<one, T>>));
+}
+
+template<typename U, std::floating_point T, std::size_t N>
+[[nodiscard]] inline Angle auto atan(const quantity<dim_one, U, dual<T, N>>& q)
+{
+  return angle<radian, dual<T, N>>(atan(q.count() * detail::quantity_scale<dimensionless<U, T>, dimensionless<one, T>>));
+}
+
+}  // namespace units
@@ -0,0 +1,166 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/constexpr_math.h>
+#include <units/bits/pow.h>
+#include <units/bits/unit_lookup.h>
+#include <units/quantity.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace units {
+
+namespace detail {
+
+// engineering prefixes are the powers of 1000 in [10^min_exp, 10^max_exp]
+inline constexpr int engineering_min_exp = -24;
+inline constexpr int engineering_max_exp = 24;
+inline constexpr std::size_t engineering_table_size = (engineering_max_exp - engineering_min_exp) / 3 + 1;
+inline constexpr int engineering_no_prefix_index = -engineering_min_exp / 3;
+
+struct engineering_prefix {
+  unit_symbol_entry symbol;
+  bool defined = false;
+};
+
+template<PrefixFamily PF, std::intmax_t Exp>
+constexpr engineering_prefix make_engineering_prefix()
+{
+  if constexpr (Exp == 0) {
+    return {{}, true};
+  } else {
+    using base = prefix_base<PF, ratio(1, 1, Exp)>;
+    using prefix = downcast<base>;
+    if constexpr (is_same_v<prefix, base>) {
+      // the family does not define such a prefix
+      return {};
+    } else {
+      return {{std::string_view(prefix::symbol.standard().c_str(), prefix::symbol.standard().size()),
+               std::string_view(prefix::symbol.ascii().c_str(), prefix::symbol.ascii().size())},
+              true};
+    }
+  }
+}
+
+template<PrefixFamily PF, std::size_t... Is>
+constexpr std::array<engineering_prefix, sizeof...(Is)> make_engineering_prefix_table(std::index_sequence<Is...>)
+{
+  return {make_engineering_prefix<PF, engineering_min_exp + 3 * static_cast<std::intmax_t>(Is)>()...};
+}
+
+/**
+ * @brief Symbols of the prefixes of the family `PF` indexed by `(exponent - engineering_min_exp) / 3`
+ */
+template<PrefixFamily PF>
+inline constexpr auto engineering_prefix_table = make_engineering_prefix_table<PF>(std::make_index_sequence<engineering_table_size>());
+
+template<std::floating_point T>
+inline constexpr auto engineering_scale_table = [] {
+  std::array<T, engineering_table_size> table{};
+  for (std::size_t i = 0; i < table.size(); ++i) table[i] = fpow10<T>(engineering_min_exp + 3 * static_cast<int>(i));
+  return table;
+}();
+
+// a unit may be auto-prefixed if it is a decimal multiple of a reference unit having a prefix family
+template<Unit U>
+inline constexpr bool is_engineering_prefixable =
+    !is_same_v<typename U::reference::prefix_family, no_prefix> && (U::ratio / U::reference::ratio).num == 1 &&
+    (U::ratio / U::reference::ratio).den == 1;
+
+template<typename Rep>
+using engineering_rep = std::conditional_t<std::is_floating_point_v<Rep>, Rep, double>;
+
+}  // namespace detail
+
+/**
+ * @brief A quantity value rescaled to an engineering prefix of its unit
+ *
+ * @tparam T a floating-point type of the value
+ */
+template<std::floating_point T>
+struct engineering_quantity {
+  T value{};                           ///< the value expressed in the prefixed unit
+  int exponent = 0;                    ///< the power of 10 of the prefix (a multiple of 3)
+  detail::unit_symbol_entry prefix{};  ///< the symbol of the prefix (empty for 10^0)
+  detail::unit_symbol_entry symbol{};  ///< the symbol of the unprefixed unit
+
+  template<class CharT, class Traits>
+  friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const engineering_quantity& q)
+  {
+    os << q.value;
+    if (!q.prefix.standard.empty() || !q.symbol.standard.empty()) os << ' ' << q.prefix.standard << q.symbol.standard;
+    return os;
+  }
+};
+
+/**
+ * @brief Rescales a quantity to the engineering prefix that brings its value into [1, 1000)
+ *
+ * The prefix is looked up in a constexpr table of the prefix family of the reference unit
+ * (i.e. `si::prefix` for `si::volt` or `si::gram`) after a single exponent computation, so
+ * there are no cascades of comparisons and `quantity_cast`s. Values beyond the range of the
+ * table use its smallest or largest prefix. Units that are not decimal multiples of a unit with
+ * a prefix family (i.e. `si::hour` or `si::metre_per_second`) are returned unchanged.
+ *
+ * @param q a quantity to rescale
+ */
+template<typename D, typename U, typename Rep>
+  requires std::is_arithmetic_v<Rep>
+[[nodiscard]] engineering_quantity<detail::engineering_rep<Rep>> to_engineering(const quantity<D, U, Rep>& q)
+{
+  using T = detail::engineering_rep<Rep>;
+  if constexpr (!detail::is_engineering_prefixable<U>) {
+    return {static_cast<T>(q.count()), 0, {}, detail::unit_symbol_entry_of<D, U>};
+  } else {
+    using reference = TYPENAME U::reference;
+    constexpr auto& prefixes = detail::engineering_prefix_table<typename reference::prefix_family>;
+    constexpr auto& scales = detail::engineering_scale_table<T>;
+    constexpr int last = static_cast<int>(detail::engineering_table_size) - 1;
+
+    const T v = static_cast<T>(q.count()) * detail::fpow10<T>((U::ratio / reference::ratio).exp);
+    const T mag = v < T(0) ? -v : v;
+    int i = detail::engineering_no_prefix_index;
+    if (mag > T(0) && detail::is_finite(mag)) {
+      // floor(log10(mag) / 3) with the correction of a possibly inexact logarithm
+      const int e = static_cast<int>(std::floor(std::log10(mag)));
+      i = std::clamp((e >= 0 ? e / 3 : (e - 2) / 3) + detail::engineering_no_prefix_index, 0, last);
+      if (i < last && mag >= scales[static_cast<std::size_t>(i + 1)]) ++i;
+      if (i > 0 && mag < scales[static_cast<std::size_t>(i)]) --i;
+    }
+    if (!prefixes[static_cast<std::size_t>(i)].defined) i = detail::engineering_no_prefix_index;
+    const auto idx = static_cast<std::size_t>(i);
+    return {v / scales[idx], detail::engineering_min_exp + 3 * i, prefixes[idx].symbol,
+            detail::unit_symbol_entry_of<D, reference>};
+  }
+}
+
+}  // namespace units
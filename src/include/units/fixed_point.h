@@ -0,0 +1,285 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <units/bits/constexpr_math.h>
+#include <units/customization_points.h>
+#include <units/quantity_cast.h>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+namespace units {
+
+namespace detail {
+
+// intermediate type wide enough to hold a product of two raw values
+template<std::signed_integral Int>
+struct fixed_point_wide {
+  static_assert(sizeof(Int) < sizeof(std::int64_t),
+                "fixed_point with a 64-bit raw type requires a 128-bit integer type (__int128)");
+  using type = std::int64_t;
+};
+
+#ifdef __SIZEOF_INT128__
+template<std::signed_integral Int>
+  requires (sizeof(Int) == 8)
+struct fixed_point_wide<Int> {
+  __extension__ using type = __int128;
+};
+#endif
+
+template<std::signed_integral Int>
+using fixed_point_wide_t = TYPENAME fixed_point_wide<Int>::type;
+
+// rescales `v` by 2^(To - From) truncating toward zero
+template<std::size_t From, std::size_t To, typename T>
+[[nodiscard]] constexpr T fixed_point_rescale(T v) noexcept
+{
+  if constexpr (To >= From)
+    return v * (T(1) << (To - From));
+  else
+    return v / (T(1) << (From - To));
+}
+
+}  // namespace detail
+
+/**
+ * @brief A binary fixed-point number
+ *
+ * Stores a value `v` as the integer `v * 2^FracBits` so all the arithmetic is integral, deterministic
+ * across platforms, and vectorizable. Intended to be used as a representation type of a quantity:
+ *
+ * @code{.cpp}
+ * using namespace units::physical::si;
+ * length<millimetre, fixed_point<std::int32_t, 8>> d(fixed_point<std::int32_t, 8>(1.5));
+ * @endcode
+ *
+ * Products and quotients are computed in a wider integer type and, same as every other conversion
+ * that drops fractional bits, truncated toward zero. Overflow is not checked.
+ *
+ * @tparam Int a signed integral type used to store the value (64-bit types are supported only on
+ *             compilers providing `__int128`)
+ * @tparam FracBits a number of fractional bits
+ */
+template<std::signed_integral Int, std::size_t FracBits>
+  requires (FracBits < std::numeric_limits<Int>::digits)
+class fixed_point {
+  Int raw_{};
+
+  using wide = detail::fixed_point_wide_t<Int>;
+  static constexpr wide scale = wide(1) << FracBits;
+
+  struct raw_tag {};
+  constexpr fixed_point(raw_tag, Int raw) noexcept : raw_(raw) {}
+
+public:
+  using raw_type = Int;
+  static constexpr std::size_t fractional_bits = FracBits;
+
+  fixed_point() = default;
+
+  template<std::integral T>
+  constexpr explicit fixed_point(T v) noexcept : raw_(static_cast<Int>(static_cast<wide>(v) * scale)) {}
+
+  // rounds to the nearest representable value
+  template<std::floating_point T>
+  constexpr explicit fixed_point(T v) noexcept : raw_(static_cast<Int>(detail::round(v * static_cast<T>(scale)))) {}
+
+  template<std::signed_integral Int2, std::size_t FracBits2>
+  constexpr explicit fixed_point(const fixed_point<Int2, FracBits2>& v) noexcept :
+    raw_(static_cast<Int>(detail::fixed_point_rescale<FracBits2, FracBits>(static_cast<wide>(v.raw()))))
+  {
+  }
+
+  /**
+   * @brief Creates a value from its underlying integer (i.e. `v * 2^FracBits`)
+   */
+  [[nodiscard]] static constexpr fixed_point from_raw(Int raw) noexcept { return fixed_point(raw_tag{}, raw); }
+  [[nodiscard]] constexpr Int raw() const noexcept { return raw_; }
+
+  template<std::floating_point T>
+  [[nodiscard]] constexpr explicit operator T() const noexcept { return static_cast<T>(raw_) / static_cast<T>(scale); }
+
+  // truncates toward zero
+  template<std::integral T>
+  [[nodiscard]] constexpr explicit operator T() const noexcept { return static_cast<T>(raw_ / scale); }
+
+  [[nodiscard]] constexpr fixed_point operator+() const noexcept { return *this; }
+  [[nodiscard]] constexpr fixed_point operator-() const noexcept { return from_raw(static_cast<Int>(-raw_)); }
+
+  constexpr fixed_point& operator++() noexcept { return *this += fixed_point(1); }
+  constexpr fixed_point operator++(int) noexcept { const fixed_point v = *this; ++*this; return v; }
+  constexpr fixed_point& operator--() noexcept { return *this -= fixed_point(1); }
+  constexpr fixed_point operator--(int) noexcept { const fixed_point v = *this; --*this; return v; }
+
+  constexpr fixed_point& operator+=(const fixed_point& rhs) noexcept { raw_ = static_cast<Int>(raw_ + rhs.raw_); return *this; }
+  constexpr fixed_point& operator-=(const fixed_point& rhs) noexcept { raw_ = static_cast<Int>(raw_ - rhs.raw_); return *this; }
+  constexpr fixed_point& operator*=(const fixed_point& rhs) noexcept { return *this = *this * rhs; }
+  constexpr fixed_point& operator/=(const fixed_point& rhs) noexcept { return *this = *this / rhs; }
+
+  template<std::integral T>
+  constexpr fixed_point& operator*=(T rhs) noexcept { return *this = *this * rhs; }
+  template<std::integral T>
+  constexpr fixed_point& operator/=(T rhs) noexcept { return *this = *this / rhs; }
+
+  // Hidden Friends
+  // Below friend functions are to be found via argument-dependent lookup only
+
+  [[nodiscard]] friend constexpr fixed_point operator+(fixed_point lhs, const fixed_point& rhs) noexcept { return lhs += rhs; }
+  [[nodiscard]] friend constexpr fixed_point operator-(fixed_point lhs, const fixed_point& rhs) noexcept { return lhs -= rhs; }
+
+  [[nodiscard]] friend constexpr fixed_point operator*(const fixed_point& lhs, const fixed_point& rhs) noexcept
+  {
+    return from_raw(static_cast<Int>(static_cast<wide>(lhs.raw_) * rhs.raw_ / scale));
+  }
+
+  [[nodiscard]] friend constexpr fixed_point operator/(const fixed_point& lhs, const fixed_point& rhs) noexcept
+  {
+    return from_raw(static_cast<Int>(static_cast<wide>(lhs.raw_) * scale / rhs.raw_));
+  }
+
+  // scaling by an integer is exact (apart from overflow) for multiplication
+  template<std::integral T>
+  [[nodiscard]] friend constexpr fixed_point operator*(const fixed_point& lhs, T rhs) noexcept
+  {
+    return from_raw(static_cast<Int>(static_cast<wide>(lhs.raw_) * static_cast<wide>(rhs)));
+  }
+
+  template<std::integral T>
+  [[nodiscard]] friend constexpr fixed_point operator*(T lhs, const fixed_point& rhs) noexcept { return rhs * lhs; }
+
+  template<std::integral T>
+  [[nodiscard]] friend constexpr fixed_point operator/(const fixed_point& lhs, T rhs) noexcept
+  {
+    return from_raw(static_cast<Int>(static_cast<wide>(lhs.raw_) / static_cast<wide>(rhs)));
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const fixed_point&, const fixed_point&) = default;
+  [[nodiscard]] friend constexpr auto operator<=>(const fixed_point&, const fixed_point&) = default;
+
+  template<class CharT, class Traits>
+  friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const fixed_point& v)
+  {
+    return os << static_cast<long double>(v);
+  }
+};
+
+// values are scaled integers so conversions that would drop fractional bits stay explicit
+template<typename Int, std::size_t FracBits>
+inline constexpr bool treat_as_floating_point<fixed_point<Int, FracBits>> = false;
+
+template<typename Int, std::size_t FracBits>
+inline constexpr std::array<std::int64_t, 4> serialization_rep_id<fixed_point<Int, FracBits>>{
+  detail::rep_id_name("fixedpt"), std::numeric_limits<Int>::digits, static_cast<std::int64_t>(FracBits)};
+
+template<typename Int, std::size_t FracBits>
+struct quantity_values<fixed_point<Int, FracBits>> {
+  using rep = fixed_point<Int, FracBits>;
+  static constexpr rep zero() noexcept { return rep::from_raw(Int(0)); }
+  static constexpr rep one() noexcept { return rep(1); }
+  static constexpr rep min() noexcept { return rep::from_raw(std::numeric_limits<Int>::lowest()); }
+  static constexpr rep max() noexcept { return rep::from_raw(std::numeric_limits<Int>::max()); }
+};
+
+namespace detail {
+
+/**
+ * @brief Unit conversion of a quantity stored with a fixed-point representation
+ *
+ * The whole conversion ratio is folded at compile time into a single integral multiplier and
+ * divisor applied to the raw value in the wide type, so no intermediate value is truncated and
+ * the constant division is strength-reduced by the compiler to a multiply and a shift.
+ */
+template<typename To, ratio CRatio, typename Int, std::size_t FracBits>
+struct fixed_point_cast_impl {
+  using c_rep = fixed_point<Int, FracBits>;
+  using wide = fixed_point_wide_t<Int>;
+
+  static constexpr wide num = static_cast<wide>(CRatio.num) * (CRatio.exp > 0 ? static_cast<wide>(ipow10(CRatio.exp)) : wide(1));
+  static constexpr wide den = static_cast<wide>(CRatio.den) * (CRatio.exp < 0 ? static_cast<wide>(ipow10(-CRatio.exp)) : wide(1));
+
+  template<Quantity Q>
+  static constexpr To cast(const Q& q)
+  {
+    const wide raw = static_cast<c_rep>(q.count()).raw();
+    return To(static_cast<TYPENAME To::rep>(c_rep::from_raw(static_cast<Int>(raw * num / den))));
+  }
+};
+
+template<typename To, ratio CRatio, typename Int, std::size_t FracBits>
+struct quantity_cast_impl<To, CRatio, fixed_point<Int, FracBits>, true, true, false> : fixed_point_cast_impl<To, CRatio, Int, FracBits> {};
+
+template<typename To, ratio CRatio, typename Int, std::size_t FracBits>
+struct quantity_cast_impl<To, CRatio, fixed_point<Int, FracBits>, true, false, true> : fixed_point_cast_impl<To, CRatio, Int, FracBits> {};
+
+template<typename To, ratio CRatio, typename Int, std::size_t FracBits>
+struct quantity_cast_impl<To, CRatio, fixed_point<Int, FracBits>, true, false, false> : fixed_point_cast_impl<To, CRatio, Int, FracBits> {};
+
+template<typename To, ratio CRatio, typename Int, std::size_t FracBits>
+struct quantity_cast_impl<To, CRatio, fixed_point<Int, FracBits>, false, true, true> : fixed_point_cast_impl<To, CRatio, Int, FracBits> {};
+
+template<typename To, ratio CRatio, typename Int, std::size_t FracBits>
+struct quantity_cast_impl<To, CRatio, fixed_point<Int, FracBits>, false, true, false> : fixed_point_cast_impl<To, CRatio, Int, FracBits> {};
+
+template<typename To, ratio CRatio, typename Int, std::size_t FracBits>
+struct quantity_cast_impl<To, CRatio, fixed_point<Int, FracBits>, false, false, true> : fixed_point_cast_impl<To, CRatio, Int, FracBits> {};
+
+template<typename To, ratio CRatio, typename Int, std::size_t FracBits>
+struct quantity_cast_impl<To, CRatio, fixed_point<Int, FracBits>, false, false, false> : fixed_point_cast_impl<To, CRatio, Int, FracBits> {};
+
+}  // namespace detail
+
+}  // namespace units
+
+namespace std {
+
+template<typename Int1, std::size_t FracBits1, typename Int2, std::size_t FracBits2>
+struct common_type<units::fixed_point<Int1, FracBits1>, units::fixed_point<Int2, FracBits2>> {
+  using type = units::fixed_point<std::common_type_t<Int1, Int2>, (FracBits1 > FracBits2 ? FracBits1 : FracBits2)>;
+};
+
+template<typename Int, std::size_t FracBits, std::integral T>
+struct common_type<units::fixed_point<Int, FracBits>, T> {
+  using type = units::fixed_point<Int, FracBits>;
+};
+
+template<typename Int, std::size_t FracBits, std::integral T>
+struct common_type<T, units::fixed_point<Int, FracBits>> {
+  using type = units::fixed_point<Int, FracBits>;
+};
+
+template<typename Int, std::size_t FracBits, std::floating_point T>
+struct common_type<units::fixed_point<Int, FracBits>, T> {
+  using type = T;
+};
+
+template<typename Int, std::size_t FracBits, std::floating_point T>
+struct common_type<T, units::fixed_point<Int, FracBits>> {
+  using type = T;
+};
+
+}  // namespace std
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <units/customization_points.h>
+#include <units/engineering.h>
 #include <units/quantity.h>
 #include <string_view>
 
@@ -47,11 +48,12 @@
 // literal-char        ::=  any character other than '{' or '}'
 // conversion-spec     ::=  '%' units-type
 // units-type          ::=  [units-rep-modifier] 'Q'
-//                          [units-unit-modifier] 'q'
+//                          [units-unit-modifiers] 'q'
 //                          one of "nt%"
 // units-rep-modifier  ::=  [sign] [#] [precision] [L] [units-rep-type]
 // units-rep-type      ::=  one of "aAbBdeEfFgGoxX"
-// units-unit-modifier ::=  'A'
+// units-unit-modifiers ::= units-unit-modifier [units-unit-modifier]
+// units-unit-modifier ::=  one of "aA"
 
 // Guide for editing
 //
@@ -107,6 +109,7 @@ namespace units {
     struct unit_format_specs
     {
       char modifier = '\0';
+      bool auto_prefix = false;  // 'a': rescale the value and the unit with `to_engineering()`
     };
 
     // Parse a `units-rep-modifier`
@@ -201,7 +204,7 @@ namespace units {
           if (*new_end == 'Q') {
             handler.on_quantity_value(begin, new_end); // Edit `on_quantity_value` to add rep modifiers
           } else {
-            handler.on_quantity_unit(*begin);          // Edit `on_quantity_unit` to add an unit modifier
+            handler.on_quantity_unit(begin, new_end);  // Edit `on_quantity_unit` to add an unit modifier
           }
           ptr = new_end + 1;
         }
@@ -265,6 +268,7 @@ namespace units {
       rep_format_specs const & rep_specs;
       unit_format_specs const & unit_specs;
       LocaleRef loc;
+      engineering_quantity<engineering_rep<Rep>> eng{};
 
       explicit units_formatter(
         OutputIt o, quantity<Dimension, Unit, Rep> q,
@@ -274,6 +278,10 @@ namespace units {
       ):
         out(o), val(q.count()), global_specs(gspecs), rep_specs(rspecs), unit_specs(uspecs), loc(lc)
       {
+        if constexpr (std::is_arithmetic_v<Rep>) {
+          // the prefix is chosen once and shared by the value and the unit
+          if (unit_specs.auto_prefix) eng = to_engineering(q);
+        }
       }
 
       template<typename CharT2>
@@ -284,11 +292,28 @@ namespace units {
 
       void on_quantity_value([[maybe_unused]] const CharT*, [[maybe_unused]] const CharT*)
       {
+        if constexpr (std::is_arithmetic_v<Rep>) {
+          if (unit_specs.auto_prefix) {
+            out = format_units_quantity_value<CharT>(out, eng.value, rep_specs, loc);
+            return;
+          }
+        }
         out = format_units_quantity_value<CharT>(out, val, rep_specs, loc);
       }
 
-      void on_quantity_unit([[maybe_unused]] const CharT)
+      void on_quantity_unit([[maybe_unused]] const CharT*, [[maybe_unused]] const CharT*)
       {
+        if constexpr (std::is_arithmetic_v<Rep>) {
+          if (unit_specs.auto_prefix) {
+            if (unit_specs.modifier == 'A') {
+              format_to(out, "{}{}", eng.prefix.ascii, eng.symbol.ascii);
+            }
+            else {
+              format_to(out, "{}{}", eng.prefix.standard, eng.symbol.standard);
+            }
+            return;
+          }
+        }
         auto txt = unit_text<Dimension, Unit>();
         if(unit_specs.modifier == 'A') {
           format_to(out, "{}", txt.ascii().c_str());
@@ -363,8 +388,10 @@ private:
       }
     }
     constexpr void on_modifier(char mod) {
-      constexpr auto valid_modifiers = std::string_view{"A"};
-      if (valid_modifiers.find(mod) != std::string_view::npos) {
+      constexpr auto valid_modifiers = std::string_view{"aA"};
+      if (mod == 'a') {
+        f.unit_specs.auto_prefix = true;
+      } else if (valid_modifiers.find(mod) != std::string_view::npos) {
         f.unit_specs.modifier = mod;
       } else {
         on_error("invalid unit modifier specified");
@@ -392,10 +419,10 @@ private:
       }
       f.quantity_value = true;
     }
-    constexpr void on_quantity_unit(const CharT mod)
+    constexpr void on_quantity_unit(const CharT* begin, const CharT* end)
     {
-      if (mod != 'q') {
-        f.unit_specs.modifier = mod;
+      for (; begin != end; ++begin) {
+        on_modifier(static_cast<char>(*begin));
       }
       f.quantity_unit = true;
     }
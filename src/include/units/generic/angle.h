@@ -29,6 +29,9 @@ namespace units {
 
 struct radian : named_unit<radian, "rad", physical::si::prefix> {};
 
+// pi/180 rounded to the precision of `ratio`
+struct degree : named_scaled_unit<degree, basic_symbol_text{"°", "deg"}, no_prefix, ratio(17'453'292'519'943'296, 1, -18), radian> {};
+
 template<Unit U = radian>
 struct dim_angle : base_dimension<"A", U> {};
 
@@ -44,6 +47,10 @@ inline namespace literals {
 constexpr auto operator"" _q_rad(unsigned long long l) { return angle<radian, std::int64_t>(l); }
 constexpr auto operator"" _q_rad(long double l) { return angle<radian, long double>(l); }
 
+// deg
+constexpr auto operator"" _q_deg(unsigned long long l) { return angle<degree, std::int64_t>(l); }
+constexpr auto operator"" _q_deg(long double l) { return angle<degree, long double>(l); }
+
 
 }  // namespace literals
 
@@ -0,0 +1,411 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/ratio_maths.h>
+#include <units/quantity.h>
+#include <gsl/gsl_assert>
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Vectors and matrices of quantities of different dimensions
+//
+// A matrix is described by a vector of row factors `R` and a vector of column factors `C`; the
+// quantity in the cell (i, j) is of type `R[i] * C[j]`. Every matrix that transforms vectors of
+// quantities, as well as every covariance matrix, can be expressed in that way, and the types of
+// products, transposes, and inverses follow directly from the factors:
+//
+//   (R1, C1) * (R2, C2) = (R1 * K, C2)   where `K = C1[k] * R2[k]` is the same for every k
+//   transpose(R, C) = (C, R)
+//   inverse(R, C) = (1 / C, 1 / R)
+//
+// Values are stored as a dense row-major block of `double` expressed in the units of the cells.
+
+namespace units {
+
+template<Quantity... Qs>
+  requires (sizeof...(Qs) > 0) && (std::same_as<typename Qs::rep, double> && ...)
+class hvec;
+
+template<typename Rows, typename Columns>
+class hmat;
+
+namespace detail {
+
+// both wrap quantities so they are never `ScalableNumber`
+template<Quantity... Qs>
+inline constexpr bool is_wrapped_quantity<hvec<Qs...>> = true;
+
+template<typename Rows, typename Columns>
+inline constexpr bool is_wrapped_quantity<hmat<Rows, Columns>> = true;
+
+template<Quantity Q1, Quantity Q2>
+using hmat_product = decltype(std::declval<Q1>() * std::declval<Q2>());
+
+template<Quantity Q>
+using hmat_inverse = decltype(1. / std::declval<Q>());
+
+template<typename... Ts>
+inline constexpr bool all_same = true;
+
+template<typename T, typename... Ts>
+inline constexpr bool all_same<T, Ts...> = (std::same_as<T, Ts> && ...);
+
+// the common type of the products `Cs[k] * Rs[k]` contracted by a matrix product
+template<typename Cs, typename Rs>
+struct hmat_contraction;
+
+template<typename... Cs, typename... Rs>
+  requires (sizeof...(Cs) == sizeof...(Rs)) && all_same<hmat_product<Cs, Rs>...>
+struct hmat_contraction<hvec<Cs...>, hvec<Rs...>> {
+  using type = std::tuple_element_t<0, std::tuple<hmat_product<Cs, Rs>...>>;
+};
+
+template<typename Cs, typename Rs>
+using hmat_contraction_t = TYPENAME hmat_contraction<Cs, Rs>::type;
+
+template<typename V>
+struct hvec_inverse;
+
+template<typename... Qs>
+struct hvec_inverse<hvec<Qs...>> {
+  using type = hvec<hmat_inverse<Qs>...>;
+};
+
+template<typename V, typename K>
+struct hvec_scaled;
+
+template<typename... Qs, typename K>
+struct hvec_scaled<hvec<Qs...>, K> {
+  using type = hvec<hmat_product<Qs, K>...>;
+};
+
+}  // namespace detail
+
+/**
+ * @brief A vector of quantities of possibly different dimensions
+ *
+ * @tparam Qs types of the elements (all with `double` representation)
+ */
+template<Quantity... Qs>
+  requires (sizeof...(Qs) > 0) && (std::same_as<typename Qs::rep, double> && ...)
+class hvec {
+  static constexpr std::size_t N = sizeof...(Qs);
+
+public:
+  template<std::size_t I>
+  using element_type = std::tuple_element_t<I, std::tuple<Qs...>>;
+
+  hvec() = default;
+
+  template<typename... Args>
+    requires (sizeof...(Args) == N) && (std::convertible_to<Args, Qs> && ...)
+  constexpr hvec(const Args&... args) : data_{Qs(args).count()...}
+  {
+  }
+
+  [[nodiscard]] static constexpr std::size_t size() noexcept { return N; }
+
+  template<std::size_t I>
+    requires (I < N)
+  [[nodiscard]] constexpr element_type<I> get() const noexcept
+  {
+    return element_type<I>(data_[I]);
+  }
+
+  template<std::size_t I, typename Q>
+    requires (I < N) && std::convertible_to<Q, element_type<I>>
+  constexpr void set(const Q& q) noexcept
+  {
+    data_[I] = element_type<I>(q).count();
+  }
+
+  [[nodiscard]] constexpr const double* data() const noexcept { return data_.data(); }
+  [[nodiscard]] constexpr double* data() noexcept { return data_.data(); }
+
+  constexpr hvec& operator+=(const hvec& v) noexcept
+  {
+    for (std::size_t i = 0; i < N; ++i) data_[i] += v.data_[i];
+    return *this;
+  }
+
+  constexpr hvec& operator-=(const hvec& v) noexcept
+  {
+    for (std::size_t i = 0; i < N; ++i) data_[i] -= v.data_[i];
+    return *this;
+  }
+
+  constexpr hvec& operator*=(double s) noexcept
+  {
+    for (double& v : data_) v *= s;
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr hvec operator+(hvec lhs, const hvec& rhs) noexcept { return lhs += rhs; }
+  [[nodiscard]] friend constexpr hvec operator-(hvec lhs, const hvec& rhs) noexcept { return lhs -= rhs; }
+  [[nodiscard]] friend constexpr hvec operator*(hvec lhs, double rhs) noexcept { return lhs *= rhs; }
+  [[nodiscard]] friend constexpr hvec operator*(double lhs, hvec rhs) noexcept { return rhs *= lhs; }
+  [[nodiscard]] friend constexpr bool operator==(const hvec&, const hvec&) = default;
+
+  template<class CharT, class Traits>
+  friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const hvec& v)
+  {
+    os << '[';
+    v.print(os, std::make_index_sequence<N>());
+    return os << ']';
+  }
+
+private:
+  std::array<double, N> data_{};
+
+  template<class CharT, class Traits, std::size_t... Is>
+  void print(std::basic_ostream<CharT, Traits>& os, std::index_sequence<Is...>) const
+  {
+    ((os << (Is == 0 ? "" : ", ") << get<Is>()), ...);
+  }
+};
+
+/**
+ * @brief A matrix of quantities of different dimensions
+ *
+ * The quantity in the cell (i, j) is of type `Rs[i] * Cs[j]`, i.e. the covariance of a state
+ * vector `X` is `hmat<X, X>`. A matrix transforming vectors `X` into vectors `Y` is
+ * `linear_map<Y, X>`.
+ *
+ * @tparam Rows `hvec` of row factors
+ * @tparam Columns `hvec` of column factors
+ */
+template<Quantity... Rs, Quantity... Cs>
+class hmat<hvec<Rs...>, hvec<Cs...>> {
+  static constexpr std::size_t R = sizeof...(Rs);
+  static constexpr std::size_t C = sizeof...(Cs);
+
+  template<std::size_t I>
+  using row_factor = std::tuple_element_t<I, std::tuple<Rs...>>;
+
+  template<std::size_t J>
+  using column_factor = std::tuple_element_t<J, std::tuple<Cs...>>;
+
+public:
+  using row_factors = hvec<Rs...>;
+  using column_factors = hvec<Cs...>;
+
+  template<std::size_t I, std::size_t J>
+  using cell_type = detail::hmat_product<row_factor<I>, column_factor<J>>;
+
+  hmat() = default;
+
+  /**
+   * @brief The identity matrix
+   *
+   * Available only if all the cells on the diagonal are dimensionless.
+   */
+  [[nodiscard]] static constexpr hmat identity() noexcept
+    requires (R == C) && (std::same_as<detail::hmat_product<Rs, Cs>, dimensionless<one, double>> && ...)
+  {
+    hmat m;
+    for (std::size_t i = 0; i < R; ++i) m.data_[i * C + i] = 1.;
+    return m;
+  }
+
+  [[nodiscard]] static constexpr std::size_t rows() noexcept { return R; }
+  [[nodiscard]] static constexpr std::size_t columns() noexcept { return C; }
+
+  template<std::size_t I, std::size_t J>
+    requires (I < R && J < C)
+  [[nodiscard]] constexpr cell_type<I, J> get() const noexcept
+  {
+    return cell_type<I, J>(data_[I * C + J]);
+  }
+
+  template<std::size_t I, std::size_t J, typename Q>
+    requires (I < R && J < C) && std::convertible_to<Q, cell_type<I, J>>
+  constexpr void set(const Q& q) noexcept
+  {
+    data_[I * C + J] = cell_type<I, J>(q).count();
+  }
+
+  /**
+   * @brief The row-major block of values expressed in the units of the cells
+   */
+  [[nodiscard]] constexpr const double* data() const noexcept { return data_.data(); }
+  [[nodiscard]] constexpr double* data() noexcept { return data_.data(); }
+
+  [[nodiscard]] constexpr hmat<hvec<Cs...>, hvec<Rs...>> transpose() const noexcept
+  {
+    hmat<hvec<Cs...>, hvec<Rs...>> m;
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t j = 0; j < C; ++j) m.data()[j * R + i] = data_[i * C + j];
+    return m;
+  }
+
+  constexpr hmat& operator+=(const hmat& m) noexcept
+  {
+    for (std::size_t i = 0; i < R * C; ++i) data_[i] += m.data_[i];
+    return *this;
+  }
+
+  constexpr hmat& operator-=(const hmat& m) noexcept
+  {
+    for (std::size_t i = 0; i < R * C; ++i) data_[i] -= m.data_[i];
+    return *this;
+  }
+
+  constexpr hmat& operator*=(double s) noexcept
+  {
+    for (double& v : data_) v *= s;
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr hmat operator+(hmat lhs, const hmat& rhs) noexcept { return lhs += rhs; }
+  [[nodiscard]] friend constexpr hmat operator-(hmat lhs, const hmat& rhs) noexcept { return lhs -= rhs; }
+  [[nodiscard]] friend constexpr hmat operator*(hmat lhs, double rhs) noexcept { return lhs *= rhs; }
+  [[nodiscard]] friend constexpr hmat operator*(double lhs, hmat rhs) noexcept { return rhs *= lhs; }
+  [[nodiscard]] friend constexpr bool operator==(const hmat&, const hmat&) = default;
+
+  template<typename Rows2, typename Columns2>
+    requires requires { typename detail::hmat_contraction_t<hvec<Cs...>, Rows2>; }
+  [[nodiscard]] friend constexpr auto operator*(const hmat& lhs, const hmat<Rows2, Columns2>& rhs) noexcept
+  {
+    using contraction = detail::hmat_contraction_t<hvec<Cs...>, Rows2>;
+    using ret = hmat<typename detail::hvec_scaled<hvec<Rs...>, contraction>::type, Columns2>;
+    constexpr std::size_t C2 = ret::columns();
+
+    ret m;
+    for (std::size_t i = 0; i < R; ++i)
+      for (std::size_t k = 0; k < C; ++k) {
+        const double a = lhs.data_[i * C + k];
+        for (std::size_t j = 0; j < C2; ++j) m.data()[i * C2 + j] += a * rhs.data()[k * C2 + j];
+      }
+    return m;
+  }
+
+  template<Quantity... Xs>
+    requires requires { typename detail::hmat_contraction_t<hvec<Cs...>, hvec<Xs...>>; }
+  [[nodiscard]] friend constexpr auto operator*(const hmat& lhs, const hvec<Xs...>& rhs) noexcept
+  {
+    using contraction = detail::hmat_contraction_t<hvec<Cs...>, hvec<Xs...>>;
+    using ret = TYPENAME detail::hvec_scaled<hvec<Rs...>, contraction>::type;
+
+    ret v;
+    for (std::size_t i = 0; i < R; ++i) {
+      double sum = 0.;
+      for (std::size_t j = 0; j < C; ++j) sum += lhs.data_[i * C + j] * rhs.data()[j];
+      v.data()[i] = sum;
+    }
+    return v;
+  }
+
+  template<class CharT, class Traits>
+  friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const hmat& m)
+  {
+    os << '[';
+    m.print(os, std::make_index_sequence<R * C>());
+    return os << ']';
+  }
+
+private:
+  std::array<double, R * C> data_{};
+
+  template<class CharT, class Traits, std::size_t... Is>
+  void print(std::basic_ostream<CharT, Traits>& os, std::index_sequence<Is...>) const
+  {
+    ((os << (Is == 0 ? "[" : Is % C == 0 ? "], [" : ", ") << get<Is / C, Is % C>()), ...);
+    os << ']';
+  }
+};
+
+/**
+ * @brief A matrix transforming vectors `From` into vectors `To`
+ */
+template<typename To, typename From>
+using linear_map = hmat<To, typename detail::hvec_inverse<From>::type>;
+
+/**
+ * @brief Outer product of two vectors
+ */
+template<Quantity... As, Quantity... Bs>
+[[nodiscard]] constexpr hmat<hvec<As...>, hvec<Bs...>> outer(const hvec<As...>& a, const hvec<Bs...>& b) noexcept
+{
+  constexpr std::size_t C = sizeof...(Bs);
+  hmat<hvec<As...>, hvec<Bs...>> m;
+  for (std::size_t i = 0; i < sizeof...(As); ++i)
+    for (std::size_t j = 0; j < C; ++j) m.data()[i * C + j] = a.data()[i] * b.data()[j];
+  return m;
+}
+
+/**
+ * @brief Inverse of a square matrix
+ *
+ * The cell (i, j) of the result is of type `1 / (Cs[i] * Rs[j])`. Computed with the Gauss-Jordan
+ * elimination with partial pivoting.
+ *
+ * @note The matrix has to be non-singular.
+ */
+template<Quantity... Rs, Quantity... Cs>
+  requires (sizeof...(Rs) == sizeof...(Cs))
+[[nodiscard]] constexpr auto inverse(const hmat<hvec<Rs...>, hvec<Cs...>>& m)
+{
+  constexpr std::size_t N = sizeof...(Rs);
+  using ret = hmat<hvec<detail::hmat_inverse<Cs>...>, hvec<detail::hmat_inverse<Rs>...>>;
+
+  std::array<double, N * N> a{};
+  for (std::size_t i = 0; i < N * N; ++i) a[i] = m.data()[i];
+  ret inv;
+  double* b = inv.data();
+  for (std::size_t i = 0; i < N; ++i) b[i * N + i] = 1.;
+
+  for (std::size_t col = 0; col < N; ++col) {
+    std::size_t pivot = col;
+    for (std::size_t r = col + 1; r < N; ++r)
+      if (detail::abs(a[r * N + col]) > detail::abs(a[pivot * N + col])) pivot = r;
+    Expects(a[pivot * N + col] != 0.);
+    if (pivot != col)
+      for (std::size_t j = 0; j < N; ++j) {
+        std::swap(a[pivot * N + j], a[col * N + j]);
+        std::swap(b[pivot * N + j], b[col * N + j]);
+      }
+
+    const double d = a[col * N + col];
+    for (std::size_t j = 0; j < N; ++j) {
+      a[col * N + j] /= d;
+      b[col * N + j] /= d;
+    }
+    for (std::size_t r = 0; r < N; ++r) {
+      if (r == col) continue;
+      const double f = a[r * N + col];
+      for (std::size_t j = 0; j < N; ++j) {
+        a[r * N + j] -= f * a[col * N + j];
+        b[r * N + j] -= f * b[col * N + j];
+      }
+    }
+  }
+  return inv;
+}
+
+}  // namespace units
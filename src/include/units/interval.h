@@ -0,0 +1,346 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/constexpr_math.h>
+#include <units/math.h>
+#include <units/quantity.h>
+#include <gsl/gsl_assert>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+namespace units {
+
+namespace detail {
+
+// Outward rounding of a result computed in the default (round to nearest) mode.
+//
+// A correctly rounded result is at most half an ulp away from the exact one and an ulp is never
+// larger than `|x| * epsilon`, so moving by that amount (plus the smallest normal value to
+// cover underflow; a subnormal constant would trigger slow microcode assists on every
+// operation) always crosses the exact value. Scaling by `1 -+ epsilon` keeps infinities intact
+// and costs a select and a fused multiply-add instead of switching the rounding mode of the FPU,
+// which would serialize the pipeline and prevent vectorization. The bounds get at most two ulps
+// wider than with true directed rounding.
+//
+// `Ulps` scales the step for functions that are not correctly rounded.
+template<int Ulps = 1, std::floating_point T>
+[[nodiscard]] constexpr T round_down(T x) noexcept
+{
+  constexpr T step = T(Ulps) * std::numeric_limits<T>::epsilon();
+  return x * (x < T(0) ? T(1) + step : T(1) - step) - std::numeric_limits<T>::min();
+}
+
+template<int Ulps = 1, std::floating_point T>
+[[nodiscard]] constexpr T round_up(T x) noexcept
+{
+  constexpr T step = T(Ulps) * std::numeric_limits<T>::epsilon();
+  return x * (x < T(0) ? T(1) - step : T(1) + step) + std::numeric_limits<T>::min();
+}
+
+// selects instead of `std::min()`/`std::max()` (which return references) keep loops vectorizable
+template<std::floating_point T>
+[[nodiscard]] constexpr T min4(T a, T b, T c, T d) noexcept
+{
+  const T ab = a < b ? a : b;
+  const T cd = c < d ? c : d;
+  return ab < cd ? ab : cd;
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T max4(T a, T b, T c, T d) noexcept
+{
+  const T ab = a > b ? a : b;
+  const T cd = c > d ? c : d;
+  return ab > cd ? ab : cd;
+}
+
+}  // namespace detail
+
+/**
+ * @brief A closed interval of floating-point values guaranteed to contain the exact result
+ *
+ * A representation type for computations that need guaranteed bounds (i.e. safety margins).
+ * Every operation computes the bounds of the result and rounds them outward, so the exact
+ * result of the same computation on any values from the operands is always contained in the
+ * result. Conversions of quantities (`quantity_cast`) scale both bounds with an interval
+ * containing the exact conversion factor.
+ *
+ * All the operations are branch-free (selects only), so loops over contiguous storage of
+ * intervals vectorize. Over large (memory-bound) batches they cost about twice as much as the
+ * same loops over plain numbers; multiplications and divisions of data already in cache are
+ * up to five times slower.
+ * Directed rounding is emulated (see `detail::round_down()`) rather than set in the FPU so the
+ * default rounding mode is required.
+ *
+ * Division by an interval containing zero results in `[-inf, inf]`.
+ *
+ * @tparam T the type of the bounds
+ */
+template<std::floating_point T>
+class interval {
+public:
+  using value_type = T;
+
+  interval() = default;
+
+  /**
+   * @brief A degenerate interval containing exactly `v`
+   */
+  constexpr interval(const value_type& v) noexcept : lower_(v), upper_(v) {}
+
+  constexpr interval(const value_type& lower, const value_type& upper) : lower_(lower), upper_(upper)
+  {
+    Expects(!(upper < lower));
+  }
+
+  /**
+   * @brief The tightest interval containing an integral value
+   *
+   * Values that are not exactly representable in `T` are rounded outward.
+   */
+  template<std::integral I>
+  constexpr explicit interval(I v) noexcept : lower_(static_cast<T>(v)), upper_(static_cast<T>(v))
+  {
+    constexpr T exact = static_cast<T>(std::uintmax_t(1) << std::numeric_limits<T>::digits);
+    if (!(lower_ < exact && lower_ > -exact)) {
+      lower_ = detail::round_down(lower_);
+      upper_ = detail::round_up(upper_);
+    }
+  }
+
+  [[nodiscard]] constexpr const value_type& lower() const noexcept { return lower_; }
+  [[nodiscard]] constexpr const value_type& upper() const noexcept { return upper_; }
+
+  [[nodiscard]] constexpr value_type width() const noexcept { return detail::round_up(upper_ - lower_); }
+  [[nodiscard]] constexpr value_type midpoint() const noexcept { return lower_ / T(2) + upper_ / T(2); }
+  [[nodiscard]] constexpr bool contains(const value_type& v) const noexcept { return lower_ <= v && v <= upper_; }
+
+  [[nodiscard]] constexpr interval operator+() const noexcept { return *this; }
+  [[nodiscard]] constexpr interval operator-() const noexcept { return make(-upper_, -lower_); }
+
+  [[nodiscard]] friend constexpr interval operator+(const interval& lhs, const interval& rhs) noexcept
+  {
+    return make(detail::round_down(lhs.lower_ + rhs.lower_), detail::round_up(lhs.upper_ + rhs.upper_));
+  }
+
+  [[nodiscard]] friend constexpr interval operator-(const interval& lhs, const interval& rhs) noexcept
+  {
+    return make(detail::round_down(lhs.lower_ - rhs.upper_), detail::round_up(lhs.upper_ - rhs.lower_));
+  }
+
+  [[nodiscard]] friend constexpr interval operator*(const interval& lhs, const interval& rhs) noexcept
+  {
+    const T p1 = lhs.lower_ * rhs.lower_;
+    const T p2 = lhs.lower_ * rhs.upper_;
+    const T p3 = lhs.upper_ * rhs.lower_;
+    const T p4 = lhs.upper_ * rhs.upper_;
+    return make(detail::round_down(detail::min4(p1, p2, p3, p4)), detail::round_up(detail::max4(p1, p2, p3, p4)));
+  }
+
+  [[nodiscard]] friend constexpr interval operator/(const interval& lhs, const interval& rhs) noexcept
+  {
+    const T q1 = lhs.lower_ / rhs.lower_;
+    const T q2 = lhs.lower_ / rhs.upper_;
+    const T q3 = lhs.upper_ / rhs.lower_;
+    const T q4 = lhs.upper_ / rhs.upper_;
+    const bool unbounded = rhs.lower_ <= T(0) && rhs.upper_ >= T(0);
+    const T lower = detail::round_down(detail::min4(q1, q2, q3, q4));
+    const T upper = detail::round_up(detail::max4(q1, q2, q3, q4));
+    return make(unbounded ? -std::numeric_limits<T>::infinity() : lower,
+                unbounded ? std::numeric_limits<T>::infinity() : upper);
+  }
+
+  constexpr interval& operator+=(const interval& rhs) noexcept { return *this = *this + rhs; }
+  constexpr interval& operator-=(const interval& rhs) noexcept { return *this = *this - rhs; }
+  constexpr interval& operator*=(const interval& rhs) noexcept { return *this = *this * rhs; }
+  constexpr interval& operator/=(const interval& rhs) noexcept { return *this = *this / rhs; }
+
+  [[nodiscard]] friend constexpr bool operator==(const interval&, const interval&) = default;
+
+  friend std::ostream& operator<<(std::ostream& os, const interval& v)
+  {
+    return os << '[' << v.lower() << ", " << v.upper() << ']';
+  }
+
+private:
+  value_type lower_{};
+  value_type upper_{};
+
+  // no precondition check on the paths that produce the bounds in order
+  [[nodiscard]] static constexpr interval make(T lower, T upper) noexcept
+  {
+    interval ret;
+    ret.lower_ = lower;
+    ret.upper_ = upper;
+    return ret;
+  }
+};
+
+template<std::floating_point T>
+inline constexpr bool treat_as_floating_point<interval<T>> = true;
+
+template<std::floating_point T>
+struct quantity_values<interval<T>> {
+  static constexpr interval<T> zero() noexcept { return interval<T>(T(0)); }
+  static constexpr interval<T> one() noexcept { return interval<T>(T(1)); }
+  static constexpr interval<T> min() noexcept { return interval<T>(std::numeric_limits<T>::lowest()); }
+  static constexpr interval<T> max() noexcept { return interval<T>(std::numeric_limits<T>::max()); }
+};
+
+/**
+ * @brief The smallest interval containing both arguments
+ */
+template<std::floating_point T>
+[[nodiscard]] constexpr interval<T> hull(const interval<T>& lhs, const interval<T>& rhs) noexcept
+{
+  return interval<T>(lhs.lower() < rhs.lower() ? lhs.lower() : rhs.lower(),
+                     lhs.upper() > rhs.upper() ? lhs.upper() : rhs.upper());
+}
+
+/**
+ * @brief `true` if every value of `lhs` is less than every value of `rhs`
+ */
+template<std::floating_point T>
+[[nodiscard]] constexpr bool certainly_less(const interval<T>& lhs, const interval<T>& rhs) noexcept
+{
+  return lhs.upper() < rhs.lower();
+}
+
+/**
+ * @brief `true` if some value of `lhs` is less than some value of `rhs`
+ */
+template<std::floating_point T>
+[[nodiscard]] constexpr bool possibly_less(const interval<T>& lhs, const interval<T>& rhs) noexcept
+{
+  return lhs.lower() < rhs.upper();
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr interval<T> abs(const interval<T>& v) noexcept
+{
+  const T l = v.lower() < T(0) ? -v.lower() : v.lower();
+  const T u = v.upper() < T(0) ? -v.upper() : v.upper();
+  const bool straddles = v.lower() < T(0) && v.upper() > T(0);
+  return interval<T>(straddles ? T(0) : (l < u ? l : u), l > u ? l : u);
+}
+
+/**
+ * @brief Raises an interval to the power `N`
+ *
+ * Tighter than repeated multiplication because the same value is used for every factor
+ * (i.e. `pow<2>` of `[-1, 2]` is `[0, 4]` rather than `[-2, 4]`).
+ */
+template<std::intmax_t N, std::floating_point T>
+[[nodiscard]] constexpr interval<T> pow(const interval<T>& v) noexcept
+{
+  if constexpr (N == 0) {
+    return interval<T>(T(1));
+  } else if constexpr (N < 0) {
+    return interval<T>(T(1)) / pow<-N>(v);
+  } else if constexpr (N % 2 == 0) {
+    // monotonic on |v|; every multiplication of the exponentiation by squaring rounds once
+    const interval<T> a = abs(v);
+    const T l = detail::round_down<static_cast<int>(N)>(detail::pow_by_squaring(a.lower(), N));
+    const T u = detail::round_up<static_cast<int>(N)>(detail::pow_by_squaring(a.upper(), N));
+    return interval<T>(l > T(0) ? l : T(0), u);
+  } else {
+    return interval<T>(detail::round_down<static_cast<int>(N)>(detail::pow_by_squaring(v.lower(), N)),
+                       detail::round_up<static_cast<int>(N)>(detail::pow_by_squaring(v.upper(), N)));
+  }
+}
+
+/**
+ * @brief Square root of the non-negative part of an interval
+ */
+template<std::floating_point T>
+[[nodiscard]] constexpr interval<T> sqrt(const interval<T>& v) noexcept
+{
+  const T l = detail::round_down(detail::sqrt(v.lower() > T(0) ? v.lower() : T(0)));
+  return interval<T>(l > T(0) ? l : T(0), detail::round_up(detail::sqrt(v.upper())));
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr interval<T> cbrt(const interval<T>& v) noexcept
+{
+  // `std::cbrt()` is not guaranteed to be correctly rounded
+  return interval<T>(detail::round_down<2>(detail::cbrt(v.lower())), detail::round_up<2>(detail::cbrt(v.upper())));
+}
+
+// quantities with interval representation
+// (more specialized than the overloads in <units/math.h> and <units/trigonometry.h> so they are always preferred)
+
+template<std::intmax_t N, typename D, typename U, std::floating_point T>
+[[nodiscard]] constexpr auto pow(const quantity<D, U, interval<T>>& q) noexcept
+{
+  if constexpr (N == 0) {
+    return interval<T>(T(1));
+  } else {
+    using dim = dimension_pow<D, N>;
+    using unit = downcast_unit<dim, pow<N>(U::ratio)>;
+    return quantity<dim, unit, interval<T>>(pow<N>(q.count()));
+  }
+}
+
+template<typename D, typename U, std::floating_point T>
+[[nodiscard]] constexpr Quantity auto sqrt(const quantity<D, U, interval<T>>& q) noexcept
+{
+  using dim = dimension_sqrt<D>;
+  using unit = downcast_unit<dim, sqrt(U::ratio)>;
+  return quantity<dim, unit, interval<T>>(sqrt(q.count()));
+}
+
+template<typename D, typename U, std::floating_point T>
+[[nodiscard]] constexpr Quantity auto cbrt(const quantity<D, U, interval<T>>& q) noexcept
+{
+  using dim = dimension_cbrt<D>;
+  using unit = downcast_unit<dim, cbrt(U::ratio)>;
+  return quantity<dim, unit, interval<T>>(cbrt(q.count()));
+}
+
+template<typename D, typename U, std::floating_point T>
+[[nodiscard]] constexpr quantity<D, U, interval<T>> abs(const quantity<D, U, interval<T>>& q) noexcept
+{
+  return quantity<D, U, interval<T>>(abs(q.count()));
+}
+
+template<typename D1, typename U1, typename D2, typename U2, std::floating_point T>
+  requires equivalent<D1, D2>
+[[nodiscard]] constexpr bool certainly_less(const quantity<D1, U1, interval<T>>& lhs, const quantity<D2, U2, interval<T>>& rhs) noexcept
+{
+  using type = common_quantity<quantity<D1, U1, interval<T>>, quantity<D2, U2, interval<T>>>;
+  return certainly_less(type(lhs).count(), type(rhs).count());
+}
+
+template<typename D1, typename U1, typename D2, typename U2, std::floating_point T>
+  requires equivalent<D1, D2>
+[[nodiscard]] constexpr bool possibly_less(const quantity<D1, U1, interval<T>>& lhs, const quantity<D2, U2, interval<T>>& rhs) noexcept
+{
+  using type = common_quantity<quantity<D1, U1, interval<T>>, quantity<D2, U2, interval<T>>>;
+  return possibly_less(type(lhs).count(), type(rhs).count());
+}
+
+}  // namespace units
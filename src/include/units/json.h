@@ -0,0 +1,504 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/charconv.h>
+#include <units/bits/unit_lookup.h>
+#include <units/quantity.h>
+#include <units/quantity_cast.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// JSON encoding of quantities
+//
+// Quantities are bound to JSON object members with `json_field()` and then encoded or decoded
+// directly from/to the bound variables without building a document tree. A quantity is encoded
+// in one of two styles:
+//
+//   {"speed": {"value": 12.3, "unit": "km/h"}}   // json_style::object
+//   {"speed": "12.3 km/h"}                        // json_style::string
+//
+// Both styles, as well as a plain number expressed in the unit of the bound quantity, are
+// accepted by the decoder. Members that are not bound are skipped. Names are escaped by the
+// encoder and keys are compared with the escaped names (no other escape sequences are processed).
+
+namespace units {
+
+/**
+ * @brief An error reported when the JSON text is malformed or does not match the bound fields
+ */
+class json_error : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+enum class json_style { object, string };
+
+/**
+ * @brief A binding of a JSON object member to a quantity variable
+ *
+ * The unit of the decoded value may be either `Q::unit` or one of `Us`.
+ *
+ * @tparam Q the type of the bound quantity (`const` for encoding only)
+ * @tparam Us additional units accepted by the decoder
+ */
+template<typename Q, Unit... Us>
+  requires Quantity<std::remove_const_t<Q>> && std::is_arithmetic_v<typename Q::rep> &&
+           (UnitOf<Us, typename Q::dimension> && ...)
+struct json_binding {
+  using quantity_type = std::remove_const_t<Q>;
+
+  std::string_view name;
+  Q& value;
+};
+
+/**
+ * @brief Binds the member `name` of a JSON object to `q`
+ *
+ * @tparam Us additional units accepted by the decoder
+ */
+template<Unit... Us, typename Q>
+  requires Quantity<std::remove_const_t<Q>>
+[[nodiscard]] constexpr json_binding<Q, Us...> json_field(std::string_view name, Q& q) noexcept
+{
+  return {name, q};
+}
+
+namespace detail {
+
+template<typename T>
+inline constexpr bool is_json_binding = false;
+
+template<typename Q, Unit... Us>
+inline constexpr bool is_json_binding<json_binding<Q, Us...>> = true;
+
+template<typename T>
+concept json_field_binding = is_json_binding<T>;
+
+template<typename T>
+concept json_mutable_field_binding = json_field_binding<T> && !std::is_const_v<std::remove_reference_t<decltype(std::declval<T>().value)>>;
+
+template<std::output_iterator<char> Out>
+Out json_write(Out out, std::string_view txt)
+{
+  return std::ranges::copy(txt, out).out;
+}
+
+// the escape sequence of `c` in a JSON string or an empty view if `c` does not need one
+[[nodiscard]] inline std::string_view json_escape_sequence(char c, std::array<char, 6>& buf) noexcept
+{
+  switch (c) {
+    case '"': return "\\\"";
+    case '\\': return "\\\\";
+    case '\b': return "\\b";
+    case '\f': return "\\f";
+    case '\n': return "\\n";
+    case '\r': return "\\r";
+    case '\t': return "\\t";
+    default: break;
+  }
+  const auto u = static_cast<unsigned char>(c);
+  if (u >= 0x20) return {};
+  constexpr std::string_view hex = "0123456789abcdef";
+  buf = {'\\', 'u', '0', '0', hex[u >> 4], hex[u & 0xF]};
+  return {buf.data(), buf.size()};
+}
+
+template<std::output_iterator<char> Out>
+Out json_write_escaped(Out out, std::string_view txt)
+{
+  std::array<char, 6> buf;
+  for (const char c : txt) {
+    const std::string_view esc = json_escape_sequence(c, buf);
+    if (esc.empty())
+      *out++ = c;
+    else
+      out = json_write(out, esc);
+  }
+  return out;
+}
+
+// whether the raw contents of a JSON string are `txt` as written by `json_write_escaped()`
+[[nodiscard]] inline bool json_key_equals(std::string_view raw, std::string_view txt) noexcept
+{
+  std::array<char, 6> buf;
+  std::size_t pos = 0;
+  for (const char& c : txt) {
+    std::string_view esc = json_escape_sequence(c, buf);
+    if (esc.empty()) esc = std::string_view(&c, 1);
+    if (raw.substr(pos, esc.size()) != esc) return false;
+    pos += esc.size();
+  }
+  return pos == raw.size();
+}
+
+template<typename Rep, std::output_iterator<char> Out>
+Out json_write_number(Out out, Rep v)
+{
+  // JSON has no representation of infinities and NaNs
+  if constexpr (std::is_floating_point_v<Rep>)
+    if (!std::isfinite(v)) throw json_error("units: a non-finite value can not be encoded in JSON");
+  std::array<char, 64> buf;
+  const auto res = detail::to_chars(buf.data(), buf.data() + buf.size(), v);
+  return std::copy(buf.data(), res.ptr, out);
+}
+
+template<Quantity Q, std::output_iterator<char> Out>
+Out json_write_value(Out out, const Q& q, json_style style)
+{
+  const std::string_view symbol = unit_symbol_entry_of<typename Q::dimension, typename Q::unit>.standard;
+  if (style == json_style::object) {
+    out = json_write(out, "{\"value\":");
+    out = json_write_number(out, q.count());
+    out = json_write(out, ",\"unit\":\"");
+    out = json_write(out, symbol);
+    return json_write(out, "\"}");
+  }
+  *out++ = '"';
+  out = json_write_number(out, q.count());
+  if (!symbol.empty()) {
+    *out++ = ' ';
+    out = json_write(out, symbol);
+  }
+  *out++ = '"';
+  return out;
+}
+
+// converts a value expressed in the `unit`-th unit of `Us` to `Q`
+template<Quantity Q, Unit... Us>
+[[nodiscard]] Q quantity_from_unit(std::size_t unit, typename Q::rep v)
+{
+  Q result{};
+  std::size_t index = 0;
+  static_cast<void>(((unit == index++ ? (result = quantity_cast<Q>(quantity<typename Q::dimension, Us, typename Q::rep>(v)), true) : false) || ...));
+  return result;
+}
+
+// a non-allocating cursor over JSON text
+class json_cursor {
+public:
+  constexpr json_cursor(std::string_view txt) noexcept : begin_(txt.data()), pos_(txt.data()), end_(txt.data() + txt.size()) {}
+  constexpr json_cursor(std::string_view doc, std::string_view part) noexcept : begin_(doc.data()), pos_(part.data()), end_(part.data() + part.size()) {}
+
+  [[noreturn]] void fail(std::string_view what) const
+  {
+    throw json_error("json: " + std::string(what) + " at offset " + std::to_string(pos_ - begin_));
+  }
+
+  void skip_ws() noexcept
+  {
+    while (pos_ != end_ && (*pos_ == ' ' || *pos_ == '\t' || *pos_ == '\n' || *pos_ == '\r')) ++pos_;
+  }
+
+  [[nodiscard]] bool at_end() noexcept
+  {
+    skip_ws();
+    return pos_ == end_;
+  }
+
+  [[nodiscard]] char peek()
+  {
+    skip_ws();
+    if (pos_ == end_) fail("unexpected end of input");
+    return *pos_;
+  }
+
+  [[nodiscard]] bool consume(char c)
+  {
+    if (peek() != c) return false;
+    ++pos_;
+    return true;
+  }
+
+  void expect(char c)
+  {
+    if (!consume(c)) fail(std::string("expected '") + c + "'");
+  }
+
+  // the raw contents of a string (escape sequences are not processed)
+  [[nodiscard]] std::string_view string()
+  {
+    expect('"');
+    const char* first = pos_;
+    for (; pos_ != end_ && *pos_ != '"'; ++pos_)
+      if (*pos_ == '\\' && ++pos_ == end_) break;
+    if (pos_ == end_) fail("unterminated string");
+    return {first, static_cast<std::size_t>(pos_++ - first)};
+  }
+
+  // a number or a literal (`true`, `false`, `null`)
+  [[nodiscard]] std::string_view scalar()
+  {
+    skip_ws();
+    const char* first = pos_;
+    while (pos_ != end_ && *pos_ != ',' && *pos_ != '}' && *pos_ != ']' && *pos_ != ' ' && *pos_ != '\t' && *pos_ != '\n' &&
+           *pos_ != '\r')
+      ++pos_;
+    if (first == pos_) fail("expected a value");
+    return {first, static_cast<std::size_t>(pos_ - first)};
+  }
+
+  void skip_value()
+  {
+    switch (peek()) {
+      case '"':
+        static_cast<void>(string());
+        break;
+      case '{':
+      case '[': {
+        const char close = *pos_ == '{' ? '}' : ']';
+        ++pos_;
+        if (consume(close)) break;
+        do {
+          if (close == '}') {
+            static_cast<void>(string());
+            expect(':');
+          }
+          skip_value();
+        } while (consume(','));
+        expect(close);
+        break;
+      }
+      default:
+        static_cast<void>(scalar());
+    }
+  }
+
+private:
+  const char* begin_;
+  const char* pos_;
+  const char* end_;
+};
+
+// processes escape sequences of a short string (i.e. `µm`) into `buf`
+template<std::size_t N>
+[[nodiscard]] std::string_view json_unescape(std::string_view raw, std::array<char, N>& buf, const json_cursor& cur)
+{
+  if (raw.find('\\') == std::string_view::npos) return raw;
+
+  std::size_t len = 0;
+  const auto put = [&](char c) {
+    if (len == N) cur.fail("string too long");
+    buf[len++] = c;
+  };
+  for (std::size_t i = 0; i < raw.size(); ++i) {
+    if (raw[i] != '\\') {
+      put(raw[i]);
+      continue;
+    }
+    if (++i == raw.size()) cur.fail("invalid escape sequence");
+    switch (raw[i]) {
+      case 'b': put('\b'); break;
+      case 'f': put('\f'); break;
+      case 'n': put('\n'); break;
+      case 'r': put('\r'); break;
+      case 't': put('\t'); break;
+      case 'u': {
+        unsigned cp = 0;
+        if (i + 4 >= raw.size() || std::from_chars(raw.data() + i + 1, raw.data() + i + 5, cp, 16).ptr != raw.data() + i + 5)
+          cur.fail("invalid escape sequence");
+        i += 4;
+        // UTF-8 encoding of a code point from the Basic Multilingual Plane
+        if (cp < 0x80) {
+          put(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+          put(static_cast<char>(0xC0 | (cp >> 6)));
+          put(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+          put(static_cast<char>(0xE0 | (cp >> 12)));
+          put(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+          put(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+        break;
+      }
+      default: put(raw[i]);
+    }
+  }
+  return {buf.data(), len};
+}
+
+template<typename Q, Unit... Us>
+void json_read_value(json_cursor& cur, const json_binding<Q, Us...>& field)
+{
+  using rep = TYPENAME Q::rep;
+  // returns the number and the rest of the text
+  const auto parse_number = [&](std::string_view txt, bool whole) {
+    rep v{};
+    const auto [ptr, ec] = detail::from_chars(txt.data(), txt.data() + txt.size(), v);
+    if (ec != std::errc{} || (whole && ptr != txt.data() + txt.size()))
+      cur.fail("invalid value of field '" + std::string(field.name) + "'");
+    // `nan` and `inf` are accepted by `from_chars()` but are not JSON numbers
+    if constexpr (std::is_floating_point_v<rep>)
+      if (!std::isfinite(v)) cur.fail("invalid value of field '" + std::string(field.name) + "'");
+    return std::pair(v, txt.substr(static_cast<std::size_t>(ptr - txt.data())));
+  };
+  const auto find_unit = [&](std::string_view symbol) {
+    const std::size_t unit = symbol.empty() ? 0 : find_unit_by_symbol<typename Q::dimension, typename Q::unit, Us...>(symbol);
+    if (unit > sizeof...(Us))
+      cur.fail("unsupported unit '" + std::string(symbol) + "' of field '" + std::string(field.name) + "'");
+    return unit;
+  };
+
+  std::array<char, 32> buf;
+  switch (cur.peek()) {
+    case '"': {
+      const auto [v, rest] = parse_number(json_unescape(cur.string(), buf, cur), false);
+      const auto symbol_pos = rest.find_first_not_of(' ');
+      const std::string_view symbol = symbol_pos == std::string_view::npos ? std::string_view() : rest.substr(symbol_pos);
+      field.value = quantity_from_unit<Q, typename Q::unit, Us...>(find_unit(symbol), v);
+      break;
+    }
+    case '{': {
+      cur.expect('{');
+      std::string_view value;
+      std::string_view symbol;
+      if (!cur.consume('}')) {
+        do {
+          const std::string_view key = cur.string();
+          cur.expect(':');
+          if (key == "value")
+            value = cur.scalar();
+          else if (key == "unit")
+            symbol = json_unescape(cur.string(), buf, cur);
+          else
+            cur.skip_value();
+        } while (cur.consume(','));
+        cur.expect('}');
+      }
+      if (value.empty()) cur.fail("missing value of field '" + std::string(field.name) + "'");
+      field.value = quantity_from_unit<Q, typename Q::unit, Us...>(find_unit(symbol), parse_number(value, true).first);
+      break;
+    }
+    default:
+      field.value = Q(parse_number(cur.scalar(), true).first);
+  }
+}
+
+template<std::size_t... Is, typename... Bindings>
+void json_read_object(json_cursor& cur, std::index_sequence<Is...>, const Bindings&... fields)
+{
+  std::array<bool, sizeof...(Bindings)> seen{};
+  cur.expect('{');
+  if (!cur.consume('}')) {
+    do {
+      const std::string_view key = cur.string();
+      cur.expect(':');
+      const bool bound = ((json_key_equals(key, fields.name) && (json_read_value(cur, fields), seen[Is] = true)) || ...);
+      if (!bound) cur.skip_value();
+    } while (cur.consume(','));
+    cur.expect('}');
+  }
+  static_cast<void>(((seen[Is] || (cur.fail("missing field '" + std::string(fields.name) + "'"), false)) && ...));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Writes `q` as a JSON value
+ *
+ * Values are printed with `std::to_chars()` in the shortest form that round-trips.
+ *
+ * @throws json_error if the value is not finite
+ */
+template<std::output_iterator<char> Out, Quantity Q>
+  requires std::is_arithmetic_v<typename Q::rep>
+Out json_encode(Out out, const Q& q, json_style style = json_style::object)
+{
+  return detail::json_write_value(out, q, style);
+}
+
+/**
+ * @brief Writes a JSON object with a member for every binding
+ *
+ * @throws json_error if a value is not finite
+ */
+template<std::output_iterator<char> Out, detail::json_field_binding... Bindings>
+Out json_encode_object(Out out, json_style style, const Bindings&... fields)
+{
+  *out++ = '{';
+  bool first = true;
+  const auto write_field = [&](const auto& field) {
+    if (!std::exchange(first, false)) *out++ = ',';
+    *out++ = '"';
+    out = detail::json_write_escaped(out, field.name);
+    out = detail::json_write(out, "\":");
+    out = detail::json_write_value(out, field.value, style);
+  };
+  (write_field(fields), ...);
+  *out++ = '}';
+  return out;
+}
+
+/**
+ * @brief Reads a JSON object into the bound quantities
+ *
+ * @throws json_error if the text is malformed, a bound member is missing, or its value or unit
+ *                    can not be represented by the bound quantity
+ */
+template<detail::json_mutable_field_binding... Bindings>
+void json_decode(std::string_view txt, const Bindings&... fields)
+{
+  detail::json_cursor cur(txt);
+  detail::json_read_object(cur, std::index_sequence_for<Bindings...>(), fields...);
+  if (!cur.at_end()) cur.fail("unexpected trailing characters");
+}
+
+/**
+ * @brief Reads newline-delimited JSON objects
+ *
+ * For every non-empty line the bound quantities are updated and `on_record` is invoked.
+ *
+ * @return the number of records read
+ *
+ * @throws json_error as `json_decode()`; the offset in the message is relative to the beginning of `txt`
+ */
+template<std::invocable F, detail::json_mutable_field_binding... Bindings>
+std::size_t ndjson_decode(std::string_view txt, F&& on_record, const Bindings&... fields)
+{
+  std::size_t count = 0;
+  std::size_t first = 0;
+  while (first < txt.size()) {
+    const std::size_t eol = std::min(txt.find('\n', first), txt.size());
+    detail::json_cursor cur(txt, txt.substr(first, eol - first));
+    if (!cur.at_end()) {
+      detail::json_read_object(cur, std::index_sequence_for<Bindings...>(), fields...);
+      if (!cur.at_end()) cur.fail("unexpected trailing characters");
+      on_record();
+      ++count;
+    }
+    first = eol + 1;
+  }
+  return count;
+}
+
+}  // namespace units
@@ -0,0 +1,257 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/clock.h>
+#include <units/physical/bits/time.h>
+#include <units/quantity_cast.h>
+#include <gsl/gsl_assert>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace units {
+
+/**
+ * @brief A histogram of latencies with buckets of bounded relative width (HDR-style)
+ *
+ * Values below `2^SubBucketBits` ns have their own buckets. Above that every power of two is
+ * split into `2^(SubBucketBits - 1)` equal buckets so the width of a bucket is at most
+ * `2^(1 - SubBucketBits)` of its lower bound (about 1.6% for the default of 7 bits). The
+ * buckets cover the whole range of `clock::duration`.
+ *
+ * A histogram has a single writer: recording is a few integer instructions and relaxed
+ * stores without read-modify-write operations. Other threads may read it at any time
+ * (i.e. `merge()` it into their own histogram) without locks. The usual setup is one
+ * histogram per thread that are merged for reporting.
+ *
+ * @tparam SubBucketBits the number of significant bits of the bucket boundaries
+ */
+template<std::size_t SubBucketBits = 7>
+  requires (SubBucketBits >= 2 && SubBucketBits <= 16)
+class basic_latency_histogram {
+  static constexpr std::uint64_t sub_bucket_count = std::uint64_t(1) << SubBucketBits;
+  static constexpr std::uint64_t half_count = sub_bucket_count / 2;
+
+public:
+  using duration = clock::duration;
+
+  /**
+   * @brief The number of buckets
+   */
+  static constexpr std::size_t bucket_count = (63 - SubBucketBits + 2) * half_count;
+
+  basic_latency_histogram() = default;
+  basic_latency_histogram(const basic_latency_histogram&) = delete;
+  basic_latency_histogram& operator=(const basic_latency_histogram&) = delete;
+
+  /**
+   * @brief The index of the bucket holding `d` (negative durations are counted as zero)
+   */
+  [[nodiscard]] static constexpr std::size_t bucket_index(const duration& d) noexcept
+  {
+    const std::uint64_t v = d.count() > 0 ? static_cast<std::uint64_t>(d.count()) : 0;
+    const auto width = static_cast<std::uint64_t>(std::bit_width(v));
+    if (width <= SubBucketBits) return static_cast<std::size_t>(v);
+    const std::uint64_t shift = width - SubBucketBits;
+    return static_cast<std::size_t>(shift * half_count + (v >> shift));
+  }
+
+  /**
+   * @brief The smallest duration counted in the bucket `i`
+   */
+  [[nodiscard]] static constexpr duration bucket_lower_bound(std::size_t i) noexcept
+  {
+    if (i < sub_bucket_count) return duration(static_cast<std::int64_t>(i));
+    const std::uint64_t shift = i / half_count - 1;
+    return duration(static_cast<std::int64_t>((i - shift * half_count) << shift));
+  }
+
+  /**
+   * @brief The largest duration counted in the bucket `i`
+   */
+  [[nodiscard]] static constexpr duration bucket_upper_bound(std::size_t i) noexcept
+  {
+    if (i + 1 == bucket_count) return duration::max();
+    return bucket_lower_bound(i + 1) - duration(1);
+  }
+
+  /**
+   * @brief Records a latency
+   *
+   * Must be called only by the owning thread.
+   */
+  void record(const duration& d) noexcept
+  {
+    increment(counts_[bucket_index(d)], 1);
+    increment(total_, 1);
+    increment(sum_, d.count() > 0 ? static_cast<std::uint64_t>(d.count()) : 0);
+    if (d > max_recorded()) max_.store(d.count(), std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Records a latency of any time quantity
+   */
+  template<physical::Time T>
+  void record(const T& d) noexcept
+  {
+    record(quantity_cast<duration>(d));
+  }
+
+  /**
+   * @brief Adds the counts of `other` (which may be concurrently written) to this histogram
+   *
+   * Must be called only by the owning thread.
+   */
+  void merge(const basic_latency_histogram& other) noexcept
+  {
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      const std::uint64_t c = other.counts_[i].load(std::memory_order_relaxed);
+      if (c != 0) increment(counts_[i], c);
+    }
+    increment(total_, other.total_.load(std::memory_order_relaxed));
+    increment(sum_, other.sum_.load(std::memory_order_relaxed));
+    if (other.max_recorded() > max_recorded()) max_.store(other.max_recorded().count(), std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Removes all the recorded values
+   *
+   * Must be called only by the owning thread.
+   */
+  void reset() noexcept
+  {
+    for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+    total_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] std::uint64_t count() const noexcept { return total_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief The number of values recorded in the bucket `i`
+   */
+  [[nodiscard]] std::uint64_t count(std::size_t i) const noexcept
+  {
+    Expects(i < bucket_count);
+    return counts_[i].load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] duration max_recorded() const noexcept { return duration(max_.load(std::memory_order_relaxed)); }
+
+  /**
+   * @brief The arithmetic mean of the recorded values (zero if there are none)
+   */
+  [[nodiscard]] physical::si::time<physical::si::microsecond> mean() const noexcept
+  {
+    const std::uint64_t n = count();
+    if (n == 0) return physical::si::time<physical::si::microsecond>::zero();
+    return physical::si::time<physical::si::nanosecond>(static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(n));
+  }
+
+  /**
+   * @brief The value below or at which `p` percent of the recorded values are
+   *
+   * The percentile is the recorded value of rank `ceil(p / 100 * count())` (nearest-rank method).
+   * The result is the upper bound of the bucket holding it (not more than the largest recorded
+   * value) so it overestimates the exact percentile by at most the width of a bucket.
+   *
+   * @param p a percentile in [0, 100]
+   */
+  [[nodiscard]] physical::si::time<physical::si::microsecond> percentile(double p) const noexcept
+  {
+    Expects(p >= 0 && p <= 100);
+    const std::uint64_t n = count();
+    if (n == 0) return physical::si::time<physical::si::microsecond>::zero();
+    // nearest rank (`p * n` is exact for whole percentiles so multiples of 100 are not rounded up)
+    auto rank = static_cast<std::uint64_t>(std::ceil(p * static_cast<double>(n) / 100));
+    rank = std::clamp<std::uint64_t>(rank, 1, n);
+    std::uint64_t seen = 0;
+    std::size_t i = 0;
+    for (; i + 1 < bucket_count; ++i) {
+      seen += counts_[i].load(std::memory_order_relaxed);
+      if (seen >= rank) break;
+    }
+    const duration upper = bucket_upper_bound(i) < max_recorded() ? bucket_upper_bound(i) : max_recorded();
+    return physical::si::time<physical::si::nanosecond>(static_cast<double>(upper.count()));
+  }
+
+private:
+  std::array<std::atomic<std::uint64_t>, bucket_count> counts_{};
+  std::atomic<std::uint64_t> total_{0};
+  std::atomic<std::uint64_t> sum_{0};
+  std::atomic<std::int64_t> max_{0};
+
+  // single writer so a relaxed load and store are enough (and cheaper than `fetch_add`)
+  static void increment(std::atomic<std::uint64_t>& c, std::uint64_t n) noexcept
+  {
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+};
+
+using latency_histogram = basic_latency_histogram<>;
+
+/**
+ * @brief Records the lifetime of a scope into a latency histogram
+ *
+ * @code{.cpp}
+ * thread_local units::latency_histogram parse_latency;
+ *
+ * void parse(std::string_view msg)
+ * {
+ *   units::scoped_timer t(parse_latency);
+ *   // ...
+ * }
+ * @endcode
+ *
+ * @tparam Histogram a histogram type
+ * @tparam Clock a clock of the library
+ */
+template<typename Histogram = latency_histogram, typename Clock = clock::fast>
+class scoped_timer {
+public:
+  explicit scoped_timer(Histogram& histogram) noexcept : h_(histogram), start_(Clock::now()) {}
+  scoped_timer(const scoped_timer&) = delete;
+  scoped_timer& operator=(const scoped_timer&) = delete;
+  ~scoped_timer() { h_.record(Clock::now() - start_); }
+
+  /**
+   * @brief The time elapsed since the construction of the timer
+   */
+  [[nodiscard]] typename Clock::duration elapsed() const noexcept { return Clock::now() - start_; }
+
+private:
+  Histogram& h_;
+  typename Clock::time_point start_;
+};
+
+template<typename Histogram>
+scoped_timer(Histogram&) -> scoped_timer<Histogram>;
+
+}  // namespace units
@@ -0,0 +1,450 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/constexpr_math.h>
+#include <units/bits/vec_kernels.h>
+#include <units/quantity.h>
+#include <gsl/gsl_assert>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace units {
+
+template<Quantity Q, std::size_t N>
+  requires (N > 0)
+class vec;
+
+template<Quantity Q, std::size_t R, std::size_t C>
+  requires (R > 0 && C > 0)
+class mat;
+
+namespace detail {
+
+// returns a reference to `in` when no conversion is needed
+template<typename To, typename From, std::size_t N>
+[[nodiscard]] constexpr decltype(auto) convert_reps(const std::array<From, N>& in)
+{
+  if constexpr (std::is_same_v<To, From>) {
+    return (in);
+  } else {
+    std::array<To, N> out{};
+    for (std::size_t i = 0; i < N; ++i) out[i] = static_cast<To>(in[i]);
+    return out;
+  }
+}
+
+// the result of a product (or a quotient) of quantities computes the dimension with `dimension_multiply`
+// (or `dimension_divide`) and just multiplies (or divides) the representation values
+template<Quantity Q1, typename T2>
+using product_type = decltype(std::declval<Q1>() * std::declval<T2>());
+
+template<Quantity Q1, typename T2>
+using quotient_type = decltype(std::declval<Q1>() / std::declval<T2>());
+
+}  // namespace detail
+
+/**
+ * @brief A fixed-size vector of quantities
+ *
+ * The vector stores `N` contiguous representation values of `Q`. Products of vectors and quantities
+ * produce vectors of the same dimension as the product of the corresponding quantities.
+ * Operations on vectors of 2, 3, and 4 arithmetic values use SIMD kernels where available.
+ *
+ * @tparam Q the type of the elements
+ * @tparam N the number of elements
+ */
+template<Quantity Q, std::size_t N>
+  requires (N > 0)
+class vec {
+public:
+  using value_type = Q;  // makes it a `WrappedQuantity` rather than a `ScalableNumber`
+  using rep = TYPENAME Q::rep;
+
+  vec() = default;
+
+  template<typename... Qs>
+    requires (sizeof...(Qs) == N) && (std::constructible_from<Q, Qs> && ...)
+  constexpr explicit(!(std::convertible_to<Qs, Q> && ...)) vec(const Qs&... qs) : reps_{Q(qs).count()...}
+  {
+  }
+
+  template<typename Q2>
+    requires (!std::same_as<Q2, Q>) && std::constructible_from<Q, Q2>
+  constexpr explicit(!std::convertible_to<Q2, Q>) vec(const vec<Q2, N>& v)
+  {
+    for (std::size_t i = 0; i < N; ++i) reps_[i] = Q(v[i]).count();
+  }
+
+  [[nodiscard]] static constexpr vec from_reps(const std::array<rep, N>& reps) noexcept
+  {
+    vec v;
+    v.reps_ = reps;
+    return v;
+  }
+
+  [[nodiscard]] static constexpr std::size_t size() noexcept { return N; }
+
+  [[nodiscard]] constexpr Q operator[](std::size_t i) const
+  {
+    Expects(i < N);
+    return Q(reps_[i]);
+  }
+
+  [[nodiscard]] constexpr const std::array<rep, N>& reps() const noexcept { return reps_; }
+  [[nodiscard]] constexpr std::array<rep, N>& reps() noexcept { return reps_; }
+
+  [[nodiscard]] constexpr vec operator+() const { return *this; }
+  [[nodiscard]] constexpr vec operator-() const
+  {
+    vec v;
+    for (std::size_t i = 0; i < N; ++i) v.reps_[i] = -reps_[i];
+    return v;
+  }
+
+  constexpr vec& operator+=(const vec& v)
+  {
+    detail::vec_add<rep, N>(reps_.data(), v.reps_.data(), reps_.data());
+    return *this;
+  }
+
+  constexpr vec& operator-=(const vec& v)
+  {
+    detail::vec_sub<rep, N>(reps_.data(), v.reps_.data(), reps_.data());
+    return *this;
+  }
+
+  constexpr vec& operator*=(const rep& s)
+  {
+    detail::vec_scale<rep, N>(reps_.data(), s, reps_.data());
+    return *this;
+  }
+
+  constexpr vec& operator/=(const rep& s)
+  {
+    Expects(s != rep{});
+    detail::vec_divide<rep, N>(reps_.data(), s, reps_.data());
+    return *this;
+  }
+
+  template<typename Q2>
+  [[nodiscard]] friend constexpr auto operator+(const vec& lhs, const vec<Q2, N>& rhs)
+    requires requires { typename std::common_type_t<Q, Q2>; }
+  {
+    using ret = vec<std::common_type_t<Q, Q2>, N>;
+    ret v(lhs);
+    return v += ret(rhs);
+  }
+
+  template<typename Q2>
+  [[nodiscard]] friend constexpr auto operator-(const vec& lhs, const vec<Q2, N>& rhs)
+    requires requires { typename std::common_type_t<Q, Q2>; }
+  {
+    using ret = vec<std::common_type_t<Q, Q2>, N>;
+    ret v(lhs);
+    return v -= ret(rhs);
+  }
+
+  template<typename T>
+    requires ScalableNumber<T> || Quantity<T>
+  [[nodiscard]] friend constexpr auto operator*(const vec& lhs, const T& rhs)
+  {
+    using ret = vec<detail::product_type<Q, T>, N>;
+    using ret_rep = TYPENAME ret::rep;
+    std::array<ret_rep, N> out;
+    detail::vec_scale<ret_rep, N>(detail::convert_reps<ret_rep>(lhs.reps_).data(), static_cast<ret_rep>(rep_of(rhs)), out.data());
+    return ret::from_reps(out);
+  }
+
+  template<typename T>
+    requires ScalableNumber<T> || Quantity<T>
+  [[nodiscard]] friend constexpr auto operator*(const T& lhs, const vec& rhs)
+  {
+    return rhs * lhs;
+  }
+
+  template<typename T>
+    requires ScalableNumber<T> || Quantity<T>
+  [[nodiscard]] friend constexpr auto operator/(const vec& lhs, const T& rhs)
+  {
+    using ret = vec<detail::quotient_type<Q, T>, N>;
+    using ret_rep = TYPENAME ret::rep;
+    const auto divisor = static_cast<ret_rep>(rep_of(rhs));
+    Expects(divisor != ret_rep{});
+    std::array<ret_rep, N> out;
+    detail::vec_divide<ret_rep, N>(detail::convert_reps<ret_rep>(lhs.reps_).data(), divisor, out.data());
+    return ret::from_reps(out);
+  }
+
+  template<typename Q2>
+    requires std::equality_comparable_with<Q, Q2>
+  [[nodiscard]] friend constexpr bool operator==(const vec& lhs, const vec<Q2, N>& rhs)
+  {
+    for (std::size_t i = 0; i < N; ++i)
+      if (lhs[i] != rhs[i]) return false;
+    return true;
+  }
+
+  template<class CharT, class Traits>
+  friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const vec& v)
+  {
+    os << '[';
+    for (std::size_t i = 0; i < N; ++i) {
+      if (i != 0) os << ", ";
+      os << v[i];
+    }
+    return os << ']';
+  }
+
+private:
+  std::array<rep, N> reps_;
+
+  template<typename T>
+  [[nodiscard]] static constexpr auto rep_of(const T& v)
+  {
+    if constexpr (Quantity<T>)
+      return v.count();
+    else
+      return v;
+  }
+};
+
+template<Quantity Q, Quantity... Qs>
+vec(Q, Qs...) -> vec<Q, sizeof...(Qs) + 1>;
+
+/**
+ * @brief Dot product of two vectors
+ */
+template<Quantity Q1, Quantity Q2, std::size_t N>
+[[nodiscard]] constexpr Quantity auto dot(const vec<Q1, N>& lhs, const vec<Q2, N>& rhs)
+{
+  using ret = detail::product_type<Q1, Q2>;
+  using ret_rep = TYPENAME ret::rep;
+  return ret(detail::vec_dot<ret_rep, N>(detail::convert_reps<ret_rep>(lhs.reps()).data(),
+                                         detail::convert_reps<ret_rep>(rhs.reps()).data()));
+}
+
+/**
+ * @brief Cross product of two 3-dimensional vectors
+ */
+template<Quantity Q1, Quantity Q2>
+[[nodiscard]] constexpr auto cross(const vec<Q1, 3>& lhs, const vec<Q2, 3>& rhs)
+{
+  using ret = vec<detail::product_type<Q1, Q2>, 3>;
+  using ret_rep = TYPENAME ret::rep;
+  std::array<ret_rep, 3> out;
+  detail::vec_cross(detail::convert_reps<ret_rep>(lhs.reps()).data(), detail::convert_reps<ret_rep>(rhs.reps()).data(), out.data());
+  return ret::from_reps(out);
+}
+
+/**
+ * @brief Euclidean norm of a vector
+ *
+ * For integral representation types the result is truncated.
+ */
+template<Quantity Q, std::size_t N>
+  requires requires(typename Q::rep v) { detail::sqrt(v * v); }
+[[nodiscard]] constexpr Q norm(const vec<Q, N>& v)
+{
+  using rep = TYPENAME Q::rep;
+  using sq_rep = decltype(std::declval<rep>() * std::declval<rep>());
+  const auto& reps = detail::convert_reps<sq_rep>(v.reps());
+  return Q(static_cast<rep>(detail::sqrt(detail::vec_dot<sq_rep, N>(reps.data(), reps.data()))));
+}
+
+/**
+ * @brief A fixed-size matrix of quantities
+ *
+ * The matrix stores `R`x`C` contiguous representation values of `Q` in the row-major order.
+ *
+ * @tparam Q the type of the elements
+ * @tparam R the number of rows
+ * @tparam C the number of columns
+ */
+template<Quantity Q, std::size_t R, std::size_t C>
+  requires (R > 0 && C > 0)
+class mat {
+public:
+  using value_type = Q;  // makes it a `WrappedQuantity` rather than a `ScalableNumber`
+  using rep = TYPENAME Q::rep;
+
+  mat() = default;
+
+  constexpr mat(std::initializer_list<vec<Q, C>> rows)
+  {
+    Expects(rows.size() == R);
+    std::size_t r = 0;
+    for (const vec<Q, C>& row : rows) {
+      for (std::size_t c = 0; c < C; ++c) reps_[r * C + c] = row.reps()[c];
+      ++r;
+    }
+  }
+
+  template<typename Q2>
+    requires (!std::same_as<Q2, Q>) && std::constructible_from<Q, Q2>
+  constexpr explicit(!std::convertible_to<Q2, Q>) mat(const mat<Q2, R, C>& m)
+  {
+    for (std::size_t i = 0; i < R * C; ++i) reps_[i] = Q(Q2(m.reps()[i])).count();
+  }
+
+  [[nodiscard]] static constexpr mat from_reps(const std::array<rep, R * C>& reps) noexcept
+  {
+    mat m;
+    m.reps_ = reps;
+    return m;
+  }
+
+  [[nodiscard]] static constexpr std::size_t rows() noexcept { return R; }
+  [[nodiscard]] static constexpr std::size_t columns() noexcept { return C; }
+
+  [[nodiscard]] constexpr Q operator()(std::size_t r, std::size_t c) const
+  {
+    Expects(r < R && c < C);
+    return Q(reps_[r * C + c]);
+  }
+
+  [[nodiscard]] constexpr vec<Q, C> row(std::size_t r) const
+  {
+    Expects(r < R);
+    std::array<rep, C> out;
+    for (std::size_t c = 0; c < C; ++c) out[c] = reps_[r * C + c];
+    return vec<Q, C>::from_reps(out);
+  }
+
+  [[nodiscard]] constexpr const std::array<rep, R * C>& reps() const noexcept { return reps_; }
+  [[nodiscard]] constexpr std::array<rep, R * C>& reps() noexcept { return reps_; }
+
+  [[nodiscard]] constexpr mat<Q, C, R> transpose() const
+  {
+    std::array<rep, R * C> out;
+    for (std::size_t r = 0; r < R; ++r)
+      for (std::size_t c = 0; c < C; ++c) out[c * R + r] = reps_[r * C + c];
+    return mat<Q, C, R>::from_reps(out);
+  }
+
+  [[nodiscard]] constexpr mat operator-() const
+  {
+    mat m;
+    for (std::size_t i = 0; i < R * C; ++i) m.reps_[i] = -reps_[i];
+    return m;
+  }
+
+  template<typename Q2>
+  [[nodiscard]] friend constexpr auto operator+(const mat& lhs, const mat<Q2, R, C>& rhs)
+    requires requires { typename std::common_type_t<Q, Q2>; }
+  {
+    using ret = mat<std::common_type_t<Q, Q2>, R, C>;
+    ret m(lhs);
+    const ret other(rhs);
+    for (std::size_t i = 0; i < R * C; ++i) m.reps()[i] += other.reps()[i];
+    return m;
+  }
+
+  template<typename Q2>
+  [[nodiscard]] friend constexpr auto operator-(const mat& lhs, const mat<Q2, R, C>& rhs)
+    requires requires { typename std::common_type_t<Q, Q2>; }
+  {
+    return lhs + -rhs;
+  }
+
+  template<typename T>
+    requires ScalableNumber<T> || Quantity<T>
+  [[nodiscard]] friend constexpr auto operator*(const mat& lhs, const T& rhs)
+  {
+    using ret = mat<detail::product_type<Q, T>, R, C>;
+    using ret_rep = TYPENAME ret::rep;
+    std::array<ret_rep, R * C> out;
+    const auto s = static_cast<ret_rep>(rep_of(rhs));
+    for (std::size_t i = 0; i < R * C; ++i) out[i] = static_cast<ret_rep>(lhs.reps_[i]) * s;
+    return ret::from_reps(out);
+  }
+
+  template<typename T>
+    requires ScalableNumber<T> || Quantity<T>
+  [[nodiscard]] friend constexpr auto operator*(const T& lhs, const mat& rhs)
+  {
+    return rhs * lhs;
+  }
+
+  template<Quantity Q2>
+  [[nodiscard]] friend constexpr auto operator*(const mat& lhs, const vec<Q2, C>& rhs)
+  {
+    using ret = vec<detail::product_type<Q, Q2>, R>;
+    using ret_rep = TYPENAME ret::rep;
+    std::array<ret_rep, R> out;
+    detail::mat_vec<ret_rep, R, C>(detail::convert_reps<ret_rep>(lhs.reps_).data(), detail::convert_reps<ret_rep>(rhs.reps()).data(),
+                                   out.data());
+    return ret::from_reps(out);
+  }
+
+  template<Quantity Q2, std::size_t C2>
+  [[nodiscard]] friend constexpr auto operator*(const mat& lhs, const mat<Q2, C, C2>& rhs)
+  {
+    using ret = mat<detail::product_type<Q, Q2>, R, C2>;
+    using ret_rep = TYPENAME ret::rep;
+    std::array<ret_rep, R * C2> out;
+    detail::mat_mat<ret_rep, R, C, C2>(detail::convert_reps<ret_rep>(lhs.reps_).data(),
+                                       detail::convert_reps<ret_rep>(rhs.reps()).data(), out.data());
+    return ret::from_reps(out);
+  }
+
+  template<typename Q2>
+    requires std::equality_comparable_with<Q, Q2>
+  [[nodiscard]] friend constexpr bool operator==(const mat& lhs, const mat<Q2, R, C>& rhs)
+  {
+    for (std::size_t r = 0; r < R; ++r)
+      for (std::size_t c = 0; c < C; ++c)
+        if (lhs(r, c) != rhs(r, c)) return false;
+    return true;
+  }
+
+  template<class CharT, class Traits>
+  friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const mat& m)
+  {
+    os << '[';
+    for (std::size_t r = 0; r < R; ++r) {
+      if (r != 0) os << ", ";
+      os << m.row(r);
+    }
+    return os << ']';
+  }
+
+private:
+  std::array<rep, R * C> reps_;
+
+  template<typename T>
+  [[nodiscard]] static constexpr auto rep_of(const T& v)
+  {
+    if constexpr (Quantity<T>)
+      return v.count();
+    else
+      return v;
+  }
+};
+
+}  // namespace units
@@ -0,0 +1,371 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <units/serialization.h>
+
+#if !__has_include(<sys/mman.h>)
+#error "units/mapped_column.h requires POSIX memory mapping support"
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Memory-mapped columnar quantity files
+//
+// A column file holds a stream of quantities of one type. It starts with the record header
+// described in `units/serialization.h` (its element count is updated in place as data are
+// appended), padded with zeros to `column_data_alignment` bytes, followed by the raw
+// representation values. Readers map the file and access the values in place.
+
+namespace units {
+
+/**
+ * @brief Offset and alignment of the payload in a column file
+ */
+inline constexpr std::size_t column_data_alignment = 64;
+
+namespace detail {
+
+[[noreturn]] inline void throw_errno(const char* what)
+{
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+// closes the descriptor on scope exit unless released
+class file_descriptor {
+  int fd_ = -1;
+public:
+  file_descriptor() = default;
+  explicit file_descriptor(int fd) noexcept : fd_(fd) {}
+  file_descriptor(file_descriptor&& other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+  file_descriptor& operator=(file_descriptor&& other) noexcept
+  {
+    if (this != &other) {
+      reset();
+      fd_ = std::exchange(other.fd_, -1);
+    }
+    return *this;
+  }
+  ~file_descriptor() { reset(); }
+
+  [[nodiscard]] int get() const noexcept { return fd_; }
+  void reset() noexcept
+  {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+  }
+};
+
+template<Quantity Q>
+inline constexpr std::size_t column_count_offset = serialization_signature<Q, column_header::record_kind::quantity>.size();
+
+template<Quantity Q>
+inline constexpr std::size_t column_data_offset =
+    (column_count_offset<Q> + 8 + column_data_alignment - 1) / column_data_alignment * column_data_alignment;
+
+// checks that the header matches `Q` exactly and returns the number of elements
+template<Quantity Q>
+std::uint64_t check_column_header(std::span<const std::byte> file)
+{
+  constexpr auto& sig = serialization_signature<Q, column_header::record_kind::quantity>;
+  if (file.size() < column_data_offset<Q> || std::memcmp(file.data(), sig.data(), sig.size()) != 0) {
+    // decode the header to report a meaningful error
+    const column_header h = read_header(file);
+    std::array<std::byte, sig.size() + 8> buf{};
+    std::ranges::copy(sig, buf.begin());
+    const column_header expected = read_header(buf);
+    if (h.kind != expected.kind || h.exponents != expected.exponents)
+      throw serialization_error("units: dimension mismatch");
+    throw serialization_error("units: unit or representation mismatch (a mapped column cannot be converted)");
+  }
+  return load_le<std::uint64_t>(file.data() + sig.size());
+}
+
+inline void write_all(int fd, const std::byte* data, std::size_t size)
+{
+  while (size > 0) {
+    const ::ssize_t n = ::write(fd, data, size);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw_errno("units: write failed");
+    }
+    data += n;
+    size -= static_cast<std::size_t>(n);
+  }
+}
+
+inline void pwrite_all(int fd, const std::byte* data, std::size_t size, std::size_t offset)
+{
+  while (size > 0) {
+    const ::ssize_t n = ::pwrite(fd, data, size, static_cast<::off_t>(offset));
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw_errno("units: write failed");
+    }
+    data += n;
+    size -= static_cast<std::size_t>(n);
+    offset += static_cast<std::size_t>(n);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Appends quantities to a column file
+ *
+ * Values are buffered and written in chunks. The element count in the header is updated after every chunk
+ * so a reader opening the file at any time sees a consistent prefix of the stream.
+ *
+ * @tparam Q a type of the quantities stored in the column
+ */
+template<Quantity Q>
+  requires std::is_trivially_copyable_v<typename Q::rep>
+class column_writer {
+  static_assert(sizeof(Q) == sizeof(typename Q::rep));
+
+  detail::file_descriptor fd_;
+  std::vector<Q> buffer_;
+  std::size_t chunk_size_;
+  std::uint64_t count_ = 0;
+
+public:
+  enum class open_mode { create, append };
+
+  /**
+   * @brief Opens a column file for writing
+   *
+   * `open_mode::create` truncates an existing file. `open_mode::append` creates the file if needed or continues
+   * an existing column, in which case its header has to match `Q` exactly (data of an unfinished chunk past the
+   * stored element count are discarded).
+   *
+   * @param chunk_size the number of quantities buffered before they are written to the file
+   *
+   * @throws std::system_error on I/O errors
+   * @throws serialization_error if an existing column does not match `Q`
+   */
+  explicit column_writer(const std::filesystem::path& path, open_mode mode = open_mode::create, std::size_t chunk_size = 64 * 1024) :
+    chunk_size_(chunk_size)
+  {
+    Expects(chunk_size > 0);
+    const int flags = O_RDWR | O_CREAT | (mode == open_mode::create ? O_TRUNC : 0);
+    fd_ = detail::file_descriptor(::open(path.c_str(), flags, 0644));
+    if (fd_.get() < 0) detail::throw_errno("units: cannot open column file");
+
+    struct ::stat st{};
+    if (::fstat(fd_.get(), &st) < 0) detail::throw_errno("units: cannot stat column file");
+    const auto file_size = static_cast<std::size_t>(st.st_size);
+
+    constexpr std::size_t data_offset = detail::column_data_offset<Q>;
+    if (file_size == 0) {
+      std::array<std::byte, data_offset> header{};
+      constexpr auto& sig = detail::serialization_signature<Q, column_header::record_kind::quantity>;
+      std::ranges::copy(sig, header.begin());
+      detail::write_all(fd_.get(), header.data(), header.size());
+    } else {
+      std::vector<std::byte> header(std::min(file_size, data_offset));
+      if (::pread(fd_.get(), header.data(), header.size(), 0) != static_cast<::ssize_t>(header.size()))
+        detail::throw_errno("units: cannot read column header");
+      count_ = detail::check_column_header<Q>(header);
+      const std::size_t end = data_offset + static_cast<std::size_t>(count_) * sizeof(Q);
+      if (file_size < end) throw serialization_error("units: truncated column file");
+      if (file_size > end && ::ftruncate(fd_.get(), static_cast<::off_t>(end)) < 0)
+        detail::throw_errno("units: cannot truncate column file");
+      if (::lseek(fd_.get(), static_cast<::off_t>(end), SEEK_SET) < 0) detail::throw_errno("units: seek failed");
+    }
+    buffer_.reserve(chunk_size);
+  }
+
+  column_writer(column_writer&&) = default;
+
+  /**
+   * @brief Flushes the buffered quantities before taking over the column of `other`
+   *
+   * @throws std::system_error on I/O errors
+   */
+  column_writer& operator=(column_writer&& other)
+  {
+    if (this != &other) {
+      if (fd_.get() >= 0) flush();
+      fd_ = std::move(other.fd_);
+      buffer_ = std::move(other.buffer_);
+      chunk_size_ = other.chunk_size_;
+      count_ = other.count_;
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Flushes the buffered quantities (errors are ignored, call `flush()` to handle them)
+   */
+  ~column_writer()
+  {
+    try {
+      if (fd_.get() >= 0) flush();
+    } catch (...) {
+    }
+  }
+
+  /**
+   * @brief The number of quantities in the column (including the buffered ones)
+   */
+  [[nodiscard]] std::uint64_t size() const noexcept { return count_ + buffer_.size(); }
+
+  void append(const Q& q)
+  {
+    buffer_.push_back(q);
+    if (buffer_.size() == chunk_size_) flush();
+  }
+
+  template<std::size_t Extent>
+  void append(quantity_span<const Q, Extent> qs)
+  {
+    for (const Q& q : qs) append(q);
+  }
+
+  /**
+   * @brief Writes the buffered quantities and updates the element count in the header
+   *
+   * @throws std::system_error on I/O errors
+   */
+  void flush()
+  {
+    if (buffer_.empty()) return;
+    detail::write_all(fd_.get(), reinterpret_cast<const std::byte*>(buffer_.data()), buffer_.size() * sizeof(Q));
+    count_ += buffer_.size();
+    buffer_.clear();
+
+    std::array<std::byte, 8> count{};
+    detail::store_le(count.data(), count_);
+    detail::pwrite_all(fd_.get(), count.data(), count.size(), detail::column_count_offset<Q>);
+  }
+};
+
+/**
+ * @brief A read-only column file mapped into memory
+ *
+ * Opening a column only maps it, so it takes constant time regardless of the file size. The quantities
+ * are accessed in place (no copies are made) and the pages are loaded on demand.
+ *
+ * @tparam Q a type of the quantities stored in the column
+ */
+template<Quantity Q>
+  requires std::is_trivially_copyable_v<typename Q::rep>
+class mapped_column {
+  static_assert(sizeof(Q) == sizeof(typename Q::rep));
+
+  void* data_ = nullptr;
+  std::size_t mapped_size_ = 0;
+  std::size_t count_ = 0;
+
+  void unmap() noexcept
+  {
+    if (data_ != nullptr) ::munmap(data_, mapped_size_);
+    data_ = nullptr;
+  }
+
+public:
+  enum class access_hint { normal, sequential, random };
+
+  /**
+   * @brief Maps a column file
+   *
+   * @param hint an access pattern advice for the operating system (i.e. `sequential` enables aggressive read-ahead)
+   *
+   * @throws std::system_error on I/O errors
+   * @throws serialization_error if the column is malformed or does not store quantities of type `Q`
+   */
+  explicit mapped_column(const std::filesystem::path& path, access_hint hint = access_hint::normal)
+  {
+    const detail::file_descriptor fd(::open(path.c_str(), O_RDONLY));
+    if (fd.get() < 0) detail::throw_errno("units: cannot open column file");
+
+    struct ::stat st{};
+    if (::fstat(fd.get(), &st) < 0) detail::throw_errno("units: cannot stat column file");
+    mapped_size_ = static_cast<std::size_t>(st.st_size);
+    if (mapped_size_ == 0) throw serialization_error("units: empty column file");
+
+    data_ = ::mmap(nullptr, mapped_size_, PROT_READ, MAP_SHARED, fd.get(), 0);
+    if (data_ == MAP_FAILED) {
+      data_ = nullptr;
+      detail::throw_errno("units: cannot map column file");
+    }
+
+    try {
+      const std::span<const std::byte> file(static_cast<const std::byte*>(data_), mapped_size_);
+      const auto count = detail::check_column_header<Q>(file);
+      if ((mapped_size_ - detail::column_data_offset<Q>) / sizeof(Q) < count)
+        throw serialization_error("units: truncated column file");
+      count_ = static_cast<std::size_t>(count);
+    } catch (...) {
+      unmap();
+      throw;
+    }
+
+    if (hint != access_hint::normal)
+      ::madvise(data_, mapped_size_, hint == access_hint::sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+  }
+
+  mapped_column(mapped_column&& other) noexcept :
+    data_(std::exchange(other.data_, nullptr)), mapped_size_(other.mapped_size_), count_(std::exchange(other.count_, 0))
+  {
+  }
+
+  mapped_column& operator=(mapped_column&& other) noexcept
+  {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      mapped_size_ = other.mapped_size_;
+      count_ = std::exchange(other.count_, 0);
+    }
+    return *this;
+  }
+
+  ~mapped_column() { unmap(); }
+
+  [[nodiscard]] std::size_t size() const noexcept { return count_; }
+  [[nodiscard]] bool empty() const noexcept { return count_ == 0; }
+
+  /**
+   * @brief The quantities stored in the column (valid as long as the column is mapped)
+   */
+  [[nodiscard]] quantity_span<const Q> quantities() const noexcept
+  {
+    if (data_ == nullptr) return {};
+    return quantity_span<const Q>(reinterpret_cast<const Q*>(static_cast<const std::byte*>(data_) + detail::column_data_offset<Q>), count_);
+  }
+};
+
+}  // namespace units
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <units/bits/constexpr_math.h>
 #include <units/concepts.h>
 #include <units/quantity.h>
 #include <cmath>
@@ -33,14 +34,18 @@ namespace units {
  * @brief Computes the value of a quantity raised to the power `N`
  * 
  * Both the quantity value and its dimension are the base of the operation.
+ *
+ * The value is computed with exponentiation by squaring so integral representations
+ * never go through the floating-point library and the function is usable in constant
+ * expressions.
  * 
  * @tparam N Exponent
  * @param q Quantity being the base of the operation
  * @return Quantity The result of computation 
  */
 template<std::intmax_t N, Quantity Q>
-[[nodiscard]] inline auto pow(const Q& q) noexcept
-  requires requires { std::pow(q.count(), N); }
+[[nodiscard]] constexpr auto pow(const Q& q) noexcept
+  requires requires(typename Q::rep v) { { v * v } -> std::convertible_to<typename Q::rep>; }
 {
   using rep = TYPENAME Q::rep;
   if constexpr(N == 0) {
@@ -49,7 +54,7 @@ template<std::intmax_t N, Quantity Q>
   else {
     using dim = dimension_pow<typename Q::dimension, N>;
     using unit = downcast_unit<dim, pow<N>(Q::unit::ratio)>;
-    return quantity<dim, unit, rep>(static_cast<rep>(std::pow(q.count(), N)));
+    return quantity<dim, unit, rep>(detail::pow_by_squaring(q.count(), N));
   }
 }
 
@@ -57,18 +62,227 @@ template<std::intmax_t N, Quantity Q>
  * @brief Computes the square root of a quantity
  * 
  * Both the quantity value and its dimension are the base of the operation.
+ *
+ * For integral representations the result is truncated (the integer square root).
  * 
  * @param q Quantity being the base of the operation
  * @return Quantity The result of computation 
  */
 template<Quantity Q>
-[[nodiscard]] inline Quantity auto sqrt(const Q& q) noexcept
-  requires requires { std::sqrt(q.count()); }
+[[nodiscard]] constexpr Quantity auto sqrt(const Q& q) noexcept
+  requires detail::arithmetic<typename Q::rep> || requires { std::sqrt(q.count()); }
 {
   using dim = dimension_sqrt<typename Q::dimension>;
   using unit = downcast_unit<dim, sqrt(Q::unit::ratio)>;
   using rep = TYPENAME Q::rep;
-  return quantity<dim, unit, rep>(static_cast<rep>(std::sqrt(q.count())));
+  if constexpr (detail::arithmetic<rep>)
+    return quantity<dim, unit, rep>(detail::sqrt(q.count()));
+  else
+    return quantity<dim, unit, rep>(static_cast<rep>(std::sqrt(q.count())));
+}
+
+/**
+ * @brief Computes the cubic root of a quantity
+ *
+ * Both the quantity value and its dimension are the base of the operation.
+ *
+ * For integral representations the result is truncated toward zero.
+ *
+ * @param q Quantity being the base of the operation
+ * @return Quantity The result of computation
+ */
+template<Quantity Q>
+[[nodiscard]] constexpr Quantity auto cbrt(const Q& q) noexcept
+  requires detail::arithmetic<typename Q::rep> || requires { std::cbrt(q.count()); }
+{
+  using dim = dimension_cbrt<typename Q::dimension>;
+  using unit = downcast_unit<dim, cbrt(Q::unit::ratio)>;
+  using rep = TYPENAME Q::rep;
+  if constexpr (detail::arithmetic<rep>)
+    return quantity<dim, unit, rep>(detail::cbrt(q.count()));
+  else
+    return quantity<dim, unit, rep>(static_cast<rep>(std::cbrt(q.count())));
+}
+
+/**
+ * @brief Computes the square root of the sum of the squares of x and y,
+ *        without undue overflow or underflow at intermediate stages of the computation
+ *
+ * @return Quantity The result expressed in the common unit of both arguments
+ */
+template<Quantity Q1, Quantity Q2>
+[[nodiscard]] constexpr Quantity auto hypot(const Q1& x, const Q2& y) noexcept
+  requires requires { typename common_quantity<Q1, Q2>; } &&
+           (detail::arithmetic<typename common_quantity<Q1, Q2>::rep> || requires { std::hypot(x.count(), y.count()); })
+{
+  using type = common_quantity<Q1, Q2>;
+  if constexpr (detail::arithmetic<typename type::rep>)
+    return type(detail::hypot(type(x).count(), type(y).count()));
+  else
+    return type(std::hypot(type(x).count(), type(y).count()));
+}
+
+/**
+ * @brief Computes the square root of the sum of the squares of x, y, and z,
+ *        without undue overflow or underflow at intermediate stages of the computation
+ *
+ * @return Quantity The result expressed in the common unit of all the arguments
+ */
+template<Quantity Q1, Quantity Q2, Quantity Q3>
+[[nodiscard]] constexpr Quantity auto hypot(const Q1& x, const Q2& y, const Q3& z) noexcept
+  requires requires { typename common_quantity<common_quantity<Q1, Q2>, Q3>; } &&
+           (detail::arithmetic<typename common_quantity<common_quantity<Q1, Q2>, Q3>::rep> ||
+            requires { std::hypot(x.count(), y.count(), z.count()); })
+{
+  using type = common_quantity<common_quantity<Q1, Q2>, Q3>;
+  if constexpr (detail::arithmetic<typename type::rep>)
+    return type(detail::hypot(type(x).count(), type(y).count(), type(z).count()));
+  else
+    return type(std::hypot(type(x).count(), type(y).count(), type(z).count()));
+}
+
+/**
+ * @brief Computes the fused multiply-add operation `a * x + b`
+ *
+ * The product of `a` and `x` has to be of a dimension equivalent to the one of `b`. If
+ * `b` can be expressed in the unit of the product without rescaling the product itself,
+ * the operation is computed with a single rounding (`std::fma`) for floating-point
+ * representations.
+ *
+ * @return Quantity The result expressed in the common unit of `a * x` and `b`
+ */
+template<Quantity QA, Quantity QX, Quantity QB>
+[[nodiscard]] constexpr Quantity auto fma(const QA& a, const QX& x, const QB& b) noexcept
+  requires requires { typename common_quantity<decltype(a * x), QB>; }
+{
+  using product = decltype(a * x);
+  using type = common_quantity<product, QB>;
+  using rep = TYPENAME type::rep;
+  if constexpr (detail::arithmetic<rep> && detail::cast_ratio(product(), type()) == ratio(1))
+    return type(detail::fma(static_cast<rep>(a.count()), static_cast<rep>(x.count()), type(b).count()));
+  else
+    return type(type(a * x).count() + type(b).count());
+}
+
+/**
+ * @brief Computes the largest quantity with integer representation and unit type To that is not greater than q
+ *
+ * @tparam To Target quantity type to round to
+ * @param q Quantity being the base of the operation
+ * @return Quantity The rounded quantity with unit type To
+ */
+template<Quantity To, typename D, typename U, typename Rep>
+  requires QuantityOf<To, D> &&
+           ((!treat_as_floating_point<typename To::rep>) ||
+            detail::arithmetic<typename To::rep> || requires(typename To::rep v) { std::floor(v); })
+[[nodiscard]] constexpr Quantity auto floor(const quantity<D, U, Rep>& q) noexcept
+{
+  const auto res = quantity_cast<To>(q);
+  using ret = decltype(res);
+  if constexpr (!treat_as_floating_point<typename To::rep>)
+    return res > q ? res - ret::one() : res;
+  else if constexpr (detail::arithmetic<typename To::rep>)
+    return ret(detail::floor(res.count()));
+  else
+    return ret(std::floor(res.count()));
+}
+
+/**
+ * @brief Computes the largest quantity with integer representation and unit type ToU that is not greater than q
+ *
+ * @tparam ToU Target unit to round to
+ */
+template<Unit ToU, typename D, typename U, typename Rep>
+  requires UnitOf<ToU, D>
+[[nodiscard]] constexpr Quantity auto floor(const quantity<D, U, Rep>& q) noexcept
+  requires requires { floor<quantity<D, ToU, Rep>>(q); }
+{
+  return floor<quantity<D, ToU, Rep>>(q);
+}
+
+/**
+ * @brief Computes the smallest quantity with integer representation and unit type To that is not less than q
+ *
+ * @tparam To Target quantity type to round to
+ * @param q Quantity being the base of the operation
+ * @return Quantity The rounded quantity with unit type To
+ */
+template<Quantity To, typename D, typename U, typename Rep>
+  requires QuantityOf<To, D> &&
+           ((!treat_as_floating_point<typename To::rep>) ||
+            detail::arithmetic<typename To::rep> || requires(typename To::rep v) { std::ceil(v); })
+[[nodiscard]] constexpr Quantity auto ceil(const quantity<D, U, Rep>& q) noexcept
+{
+  const auto res = quantity_cast<To>(q);
+  using ret = decltype(res);
+  if constexpr (!treat_as_floating_point<typename To::rep>)
+    return res < q ? res + ret::one() : res;
+  else if constexpr (detail::arithmetic<typename To::rep>)
+    return ret(detail::ceil(res.count()));
+  else
+    return ret(std::ceil(res.count()));
+}
+
+/**
+ * @brief Computes the smallest quantity with integer representation and unit type ToU that is not less than q
+ *
+ * @tparam ToU Target unit to round to
+ */
+template<Unit ToU, typename D, typename U, typename Rep>
+  requires UnitOf<ToU, D>
+[[nodiscard]] constexpr Quantity auto ceil(const quantity<D, U, Rep>& q) noexcept
+  requires requires { ceil<quantity<D, ToU, Rep>>(q); }
+{
+  return ceil<quantity<D, ToU, Rep>>(q);
+}
+
+/**
+ * @brief Computes the nearest quantity with integer representation and unit type To to q
+ *
+ * Integral representations round half to even (the same as `std::chrono::round`), while
+ * floating-point ones round half away from zero (the same as `std::round`).
+ *
+ * @tparam To Target quantity type to round to
+ * @param q Quantity being the base of the operation
+ * @return Quantity The rounded quantity with unit type To
+ */
+template<Quantity To, typename D, typename U, typename Rep>
+  requires QuantityOf<To, D> &&
+           ((!treat_as_floating_point<typename To::rep>) ||
+            detail::arithmetic<typename To::rep> || requires(typename To::rep v) { std::round(v); })
+[[nodiscard]] constexpr Quantity auto round(const quantity<D, U, Rep>& q) noexcept
+{
+  if constexpr (!treat_as_floating_point<typename To::rep>) {
+    const auto res_floor = floor<To>(q);
+    const auto res_ceil = res_floor + decltype(res_floor)::one();
+    const auto diff0 = q - res_floor;
+    const auto diff1 = res_ceil - q;
+    if (diff0 == diff1) {
+      return (res_floor.count() & 1) ? res_ceil : res_floor;
+    }
+    return diff0 < diff1 ? res_floor : res_ceil;
+  }
+  else {
+    const auto res = quantity_cast<To>(q);
+    using ret = decltype(res);
+    if constexpr (detail::arithmetic<typename To::rep>)
+      return ret(detail::round(res.count()));
+    else
+      return ret(std::round(res.count()));
+  }
+}
+
+/**
+ * @brief Computes the nearest quantity with integer representation and unit type ToU to q
+ *
+ * @tparam ToU Target unit to round to
+ */
+template<Unit ToU, typename D, typename U, typename Rep>
+  requires UnitOf<ToU, D>
+[[nodiscard]] constexpr Quantity auto round(const quantity<D, U, Rep>& q) noexcept
+  requires requires { round<quantity<D, ToU, Rep>>(q); }
+{
+  return round<quantity<D, ToU, Rep>>(q);
 }
 
 /**
@@ -0,0 +1,550 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/constexpr_math.h>
+#include <units/bits/ratio_maths.h>
+#include <units/generic/angle.h>
+#include <units/math.h>
+#include <units/quantity_cast.h>
+#include <units/quantity_span.h>
+#include <gsl/gsl_assert>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+namespace units {
+
+namespace detail {
+
+/**
+ * @brief Linear (first-order) propagation of two uncertainties
+ *
+ * Returns the standard deviation of `f(a, b)` where `da` and `db` are partial derivatives of
+ * `f` and `sa` and `sb` are standard deviations of `a` and `b`. The expression is free of
+ * branches (the clamp of a negative variance caused by rounding is a select) so that it is
+ * vectorizable.
+ */
+template<std::floating_point T>
+[[nodiscard]] constexpr T propagate(T da, T sa, T db, T sb, T correlation) noexcept
+{
+  const T x = da * sa;
+  const T y = db * sb;
+  const T var = x * x + y * y + T(2) * correlation * x * y;
+  return detail::sqrt(var > T(0) ? var : T(0));
+}
+
+}  // namespace detail
+
+/**
+ * @brief A value with its standard uncertainty
+ *
+ * A representation type propagating uncertainties through arithmetic with linear (first-order)
+ * error propagation. The operators assume that the operands are uncorrelated; use
+ * `correlated_add()`, `correlated_subtract()`, `correlated_multiply()`, and `correlated_divide()`
+ * when they are not. `pow()`, `sqrt()`, and the trigonometric functions are provided both for
+ * `measurement` values and for quantities using it as their representation type.
+ *
+ * For bulk processing see `measurement_span`.
+ *
+ * @tparam T the type of the value and of its uncertainty
+ */
+template<std::floating_point T>
+class measurement {
+public:
+  using value_type = T;
+
+  measurement() = default;
+
+  constexpr explicit measurement(const value_type& val, const value_type& err = {}) :
+      value_(val),
+      uncertainty_(detail::abs(err))
+  {
+  }
+
+  [[nodiscard]] constexpr const value_type& value() const { return value_; }
+  [[nodiscard]] constexpr const value_type& uncertainty() const { return uncertainty_; }
+
+  [[nodiscard]] constexpr value_type relative_uncertainty() const { return uncertainty() / value(); }
+  [[nodiscard]] constexpr value_type lower_bound() const { return value() - uncertainty(); }
+  [[nodiscard]] constexpr value_type upper_bound() const { return value() + uncertainty(); }
+
+  [[nodiscard]] constexpr measurement operator-() const { return measurement(-value(), uncertainty()); }
+
+  [[nodiscard]] friend constexpr measurement operator+(const measurement& lhs, const measurement& rhs)
+  {
+    return correlated_add(lhs, rhs, T(0));
+  }
+
+  [[nodiscard]] friend constexpr measurement operator-(const measurement& lhs, const measurement& rhs)
+  {
+    return correlated_subtract(lhs, rhs, T(0));
+  }
+
+  [[nodiscard]] friend constexpr measurement operator*(const measurement& lhs, const measurement& rhs)
+  {
+    return correlated_multiply(lhs, rhs, T(0));
+  }
+
+  [[nodiscard]] friend constexpr measurement operator*(const measurement& lhs, const value_type& value)
+  {
+    return measurement(lhs.value() * value, lhs.uncertainty() * value);
+  }
+
+  [[nodiscard]] friend constexpr measurement operator*(const value_type& value, const measurement& rhs)
+  {
+    return rhs * value;
+  }
+
+  [[nodiscard]] friend constexpr measurement operator/(const measurement& lhs, const measurement& rhs)
+  {
+    return correlated_divide(lhs, rhs, T(0));
+  }
+
+  [[nodiscard]] friend constexpr measurement operator/(const measurement& lhs, const value_type& value)
+  {
+    return measurement(lhs.value() / value, lhs.uncertainty() / value);
+  }
+
+  [[nodiscard]] friend constexpr measurement operator/(const value_type& value, const measurement& rhs)
+  {
+    const auto val = value / rhs.value();
+    return measurement(val, val * rhs.relative_uncertainty());
+  }
+
+  constexpr measurement& operator+=(const measurement& rhs) { return *this = *this + rhs; }
+  constexpr measurement& operator-=(const measurement& rhs) { return *this = *this - rhs; }
+  constexpr measurement& operator*=(const measurement& rhs) { return *this = *this * rhs; }
+  constexpr measurement& operator/=(const measurement& rhs) { return *this = *this / rhs; }
+  constexpr measurement& operator*=(const value_type& rhs) { return *this = *this * rhs; }
+  constexpr measurement& operator/=(const value_type& rhs) { return *this = *this / rhs; }
+
+  /**
+   * @brief Sum of two measurements with correlated errors
+   *
+   * @param correlation the correlation coefficient of the errors of `lhs` and `rhs` in [-1, 1]
+   */
+  [[nodiscard]] friend constexpr measurement correlated_add(const measurement& lhs, const measurement& rhs, T correlation)
+  {
+    return measurement(lhs.value() + rhs.value(),
+                       detail::propagate(T(1), lhs.uncertainty(), T(1), rhs.uncertainty(), correlation));
+  }
+
+  [[nodiscard]] friend constexpr measurement correlated_subtract(const measurement& lhs, const measurement& rhs, T correlation)
+  {
+    return measurement(lhs.value() - rhs.value(),
+                       detail::propagate(T(1), lhs.uncertainty(), T(-1), rhs.uncertainty(), correlation));
+  }
+
+  [[nodiscard]] friend constexpr measurement correlated_multiply(const measurement& lhs, const measurement& rhs, T correlation)
+  {
+    return measurement(lhs.value() * rhs.value(),
+                       detail::propagate(rhs.value(), lhs.uncertainty(), lhs.value(), rhs.uncertainty(), correlation));
+  }
+
+  [[nodiscard]] friend constexpr measurement correlated_divide(const measurement& lhs, const measurement& rhs, T correlation)
+  {
+    const auto val = lhs.value() / rhs.value();
+    return measurement(val, detail::propagate(T(1) / rhs.value(), lhs.uncertainty(), -val / rhs.value(),
+                                              rhs.uncertainty(), correlation));
+  }
+
+  [[nodiscard]] constexpr auto operator<=>(const measurement&) const = default;
+
+  friend std::ostream& operator<<(std::ostream& os, const measurement& v)
+  {
+    return os << v.value() << " ± " << v.uncertainty();
+  }
+
+private:
+  value_type value_{};
+  value_type uncertainty_{};
+};
+
+template<std::floating_point T>
+inline constexpr bool treat_as_floating_point<measurement<T>> = true;
+
+template<std::floating_point T>
+struct quantity_values<measurement<T>> {
+  static constexpr measurement<T> zero() noexcept { return measurement<T>(T(0)); }
+  static constexpr measurement<T> one() noexcept { return measurement<T>(T(1)); }
+  static constexpr measurement<T> min() noexcept { return measurement<T>(std::numeric_limits<T>::lowest()); }
+  static constexpr measurement<T> max() noexcept { return measurement<T>(std::numeric_limits<T>::max()); }
+};
+
+// functions of a single measurement
+// (the uncertainty is the one of the argument multiplied by the absolute value of the derivative)
+
+template<std::intmax_t N, std::floating_point T>
+[[nodiscard]] constexpr measurement<T> pow(const measurement<T>& m)
+{
+  if constexpr (N == 0) {
+    return measurement<T>(T(1));
+  } else if constexpr (N < 0) {
+    return T(1) / pow<-N>(m);
+  } else {
+    const T prev = detail::pow_by_squaring(m.value(), N - 1);
+    return measurement<T>(prev * m.value(), T(N) * prev * m.uncertainty());
+  }
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr measurement<T> sqrt(const measurement<T>& m)
+{
+  const T val = detail::sqrt(m.value());
+  return measurement<T>(val, m.uncertainty() / (T(2) * val));
+}
+
+template<std::floating_point T>
+[[nodiscard]] inline measurement<T> sin(const measurement<T>& m)
+{
+  return measurement<T>(std::sin(m.value()), std::cos(m.value()) * m.uncertainty());
+}
+
+template<std::floating_point T>
+[[nodiscard]] inline measurement<T> cos(const measurement<T>& m)
+{
+  return measurement<T>(std::cos(m.value()), std::sin(m.value()) * m.uncertainty());
+}
+
+template<std::floating_point T>
+[[nodiscard]] inline measurement<T> tan(const measurement<T>& m)
+{
+  const T c = std::cos(m.value());
+  return measurement<T>(std::tan(m.value()), m.uncertainty() / (c * c));
+}
+
+template<std::floating_point T>
+[[nodiscard]] inline measurement<T> asin(const measurement<T>& m)
+{
+  return measurement<T>(std::asin(m.value()), m.uncertainty() / std::sqrt(T(1) - m.value() * m.value()));
+}
+
+template<std::floating_point T>
+[[nodiscard]] inline measurement<T> acos(const measurement<T>& m)
+{
+  return measurement<T>(std::acos(m.value()), m.uncertainty() / std::sqrt(T(1) - m.value() * m.value()));
+}
+
+template<std::floating_point T>
+[[nodiscard]] inline measurement<T> atan(const measurement<T>& m)
+{
+  return measurement<T>(std::atan(m.value()), m.uncertainty() / (T(1) + m.value() * m.value()));
+}
+
+/**
+ * @brief The arc tangent of `y/x` of measurements with correlated errors
+ *
+ * @param correlation the correlation coefficient of the errors of `y` and `x` in [-1, 1]
+ */
+template<std::floating_point T>
+[[nodiscard]] inline measurement<T> atan2(const measurement<T>& y, const measurement<T>& x, T correlation = T(0))
+{
+  const T r2 = x.value() * x.value() + y.value() * y.value();
+  return measurement<T>(std::atan2(y.value(), x.value()),
+                        detail::propagate(x.value() / r2, y.uncertainty(), -y.value() / r2, x.uncertainty(), correlation));
+}
+
+// quantities with measurement representation
+// (more specialized than the overloads in <units/math.h> and <units/trigonometry.h> so they are always preferred)
+
+template<std::intmax_t N, typename D, typename U, std::floating_point T>
+[[nodiscard]] constexpr auto pow(const quantity<D, U, measurement<T>>& q)
+{
+  if constexpr (N == 0) {
+    return measurement<T>(T(1));
+  } else {
+    using dim = dimension_pow<D, N>;
+    using unit = downcast_unit<dim, pow<N>(U::ratio)>;
+    return quantity<dim, unit, measurement<T>>(pow<N>(q.count()));
+  }
+}
+
+template<typename D, typename U, std::floating_point T>
+[[nodiscard]] constexpr Quantity auto sqrt(const quantity<D, U, measurement<T>>& q)
+{
+  using dim = dimension_sqrt<D>;
+  using unit = downcast_unit<dim, sqrt(U::ratio)>;
+  return quantity<dim, unit, measurement<T>>(sqrt(q.count()));
+}
+
+template<typename U, std::floating_point T>
+[[nodiscard]] inline Dimensionless auto sin(const quantity<dim_angle<>, U, measurement<T>>& q)
+{
+  return dimensionless<one, measurement<T>>(sin(q.count() * detail::quantity_scale<angle<U, T>, angle<radian, T>>));
+}
+
+template<typename U, std::floating_point T>
+[[nodiscard]] inline Dimensionless auto cos(const quantity<dim_angle<>, U, measurement<T>>& q)
+{
+  return dimensionless<one, measurement<T>>(cos(q.count() * detail::quantity_scale<angle<U, T>, angle<radian, T>>));
+}
+
+template<typename U, std::floating_point T>
+[[nodiscard]] inline Dimensionless auto tan(const quantity<dim_angle<>, U, measurement<T>>& q)
+{
+  return dimensionless<one, measurement<T>>(tan(q.count() * detail::quantity_scale<angle<U, T>, angle<radian, T>>));
+}
+
+template<typename U, std::floating_point T>
+[[nodiscard]] inline Angle auto asin(const quantity<dim_one, U, measurement<T>>& q)
+{
+  return angle<radian, measurement<T>>(asin(q.count() * detail::quantity_scale<dimensionless<U, T>, dimensionless<one, T>>));
+}
+
+template<typename U, std::floating_point T>
+[[nodiscard]] inline Angle auto acos(const quantity<dim_one, U, measurement<T>>& q)
+{
+  return angle<radian, measurement<T>>(acos(q.count() * detail::quantity_scale<dimensionless<U, T>, dimensionless<one, T>>));
+}
+
+template<typename U, std::floating_point T>
+[[nodiscard]] inline Angle auto atan(const quantity<dim_one, U, measurement<T>>& q)
+{
+  return angle<radian, measurement<T>>(atan(q.count() * detail::quantity_scale<dimensionless<U, T>, dimensionless<one, T>>));
+}
+
+// correlated arithmetic on quantities
+
+template<typename D1, typename U1, typename D2, typename U2, std::floating_point T>
+  requires equivalent<D1, D2>
+[[nodiscard]] constexpr Quantity auto correlated_add(const quantity<D1, U1, measurement<T>>& lhs,
+                                                     const quantity<D2, U2, measurement<T>>& rhs, T correlation)
+{
+  using ret = common_quantity<quantity<D1, U1, measurement<T>>, quantity<D2, U2, measurement<T>>>;
+  return ret(correlated_add(ret(lhs).count(), ret(rhs).count(), correlation));
+}
+
+template<typename D1, typename U1, typename D2, typename U2, std::floating_point T>
+  requires equivalent<D1, D2>
+[[nodiscard]] constexpr Quantity auto correlated_subtract(const quantity<D1, U1, measurement<T>>& lhs,
+                                                          const quantity<D2, U2, measurement<T>>& rhs, T correlation)
+{
+  using ret = common_quantity<quantity<D1, U1, measurement<T>>, quantity<D2, U2, measurement<T>>>;
+  return ret(correlated_subtract(ret(lhs).count(), ret(rhs).count(), correlation));
+}
+
+template<typename D1, typename U1, typename D2, typename U2, std::floating_point T>
+[[nodiscard]] constexpr Quantity auto correlated_multiply(const quantity<D1, U1, measurement<T>>& lhs,
+                                                          const quantity<D2, U2, measurement<T>>& rhs, T correlation)
+{
+  using ret = decltype(lhs * rhs);
+  return ret(correlated_multiply(lhs.count(), rhs.count(), correlation));
+}
+
+template<typename D1, typename U1, typename D2, typename U2, std::floating_point T>
+[[nodiscard]] constexpr Quantity auto correlated_divide(const quantity<D1, U1, measurement<T>>& lhs,
+                                                        const quantity<D2, U2, measurement<T>>& rhs, T correlation)
+{
+  using ret = decltype(lhs / rhs);
+  return ret(correlated_divide(lhs.count(), rhs.count(), correlation));
+}
+
+/**
+ * @brief A non-owning view over measurements stored as a structure of arrays
+ *
+ * Values and uncertainties of `quantity<D, U, measurement<T>>` elements live in two separate
+ * contiguous sequences of `quantity<D, U, T>` so that the bulk `add()`, `subtract()`,
+ * `multiply()`, `divide()`, and `sqrt()` overloads are plain loops over floating-point columns
+ * which the compiler vectorizes. Values and uncertainties are computed in separate loops; the
+ * ones taking a square root vectorize only if math functions are not required to set `errno`
+ * (i.e. with `-fno-math-errno`).
+ *
+ * @tparam Q a (possibly const-qualified) quantity type with a floating-point representation
+ */
+template<typename Q>
+  requires Quantity<std::remove_const_t<Q>> && std::floating_point<typename std::remove_const_t<Q>::rep>
+class measurement_span {
+public:
+  using column_type = std::remove_const_t<Q>;
+  using rep = TYPENAME column_type::rep;
+  using value_type = quantity<typename column_type::dimension, typename column_type::unit, measurement<rep>>;
+
+  constexpr measurement_span(quantity_span<Q> values, quantity_span<Q> uncertainties) :
+      values_(values), uncertainties_(uncertainties)
+  {
+    Expects(values.size() == uncertainties.size());
+  }
+
+  template<typename Q2>
+    requires std::same_as<Q, const Q2>
+  constexpr measurement_span(const measurement_span<Q2>& other) noexcept :
+      values_(other.values()), uncertainties_(other.uncertainties())
+  {
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return values_.size(); }
+  [[nodiscard]] constexpr bool empty() const noexcept { return values_.empty(); }
+
+  [[nodiscard]] constexpr quantity_span<Q> values() const noexcept { return values_; }
+  [[nodiscard]] constexpr quantity_span<Q> uncertainties() const noexcept { return uncertainties_; }
+
+  [[nodiscard]] constexpr value_type operator[](std::size_t i) const
+  {
+    return value_type(measurement<rep>(values_[i].count(), uncertainties_[i].count()));
+  }
+
+  constexpr void set(std::size_t i, const value_type& m) const
+    requires (!std::is_const_v<Q>)
+  {
+    values_[i] = column_type(m.count().value());
+    uncertainties_[i] = column_type(m.count().uncertainty());
+  }
+
+private:
+  quantity_span<Q> values_;
+  quantity_span<Q> uncertainties_;
+};
+
+namespace detail {
+
+template<typename Q>
+using measurement_column_t = std::remove_const_t<Q>;
+
+}  // namespace detail
+
+/**
+ * @brief Element-wise sum of two columns of measurements
+ *
+ * The operands may use different units of the same dimension; the unit conversions are
+ * hoisted out of the loop.
+ *
+ * @param correlation the correlation coefficient of the errors of the operands in [-1, 1]
+ */
+template<typename Q1, typename Q2, typename R>
+  requires equivalent<typename detail::measurement_column_t<Q1>::dimension, typename R::dimension> &&
+           equivalent<typename detail::measurement_column_t<Q2>::dimension, typename R::dimension>
+void add(measurement_span<Q1> lhs, measurement_span<Q2> rhs, measurement_span<R> out, typename R::rep correlation = 0)
+{
+  Expects(lhs.size() == out.size() && rhs.size() == out.size());
+  using T = TYPENAME R::rep;
+  constexpr T f1 = detail::quantity_scale<detail::measurement_column_t<Q1>, R>;
+  constexpr T f2 = detail::quantity_scale<detail::measurement_column_t<Q2>, R>;
+  const auto v1 = lhs.values().data(), s1 = lhs.uncertainties().data();
+  const auto v2 = rhs.values().data(), s2 = rhs.uncertainties().data();
+  const auto v = out.values().data();
+  for (std::size_t i = 0; i < out.size(); ++i) v[i] = R(f1 * v1[i].count() + f2 * v2[i].count());
+  const auto s = out.uncertainties().data();
+  for (std::size_t i = 0; i < out.size(); ++i) s[i] = R(detail::propagate(f1, s1[i].count(), f2, s2[i].count(), correlation));
+}
+
+/**
+ * @brief Element-wise difference of two columns of measurements
+ *
+ * @param correlation the correlation coefficient of the errors of the operands in [-1, 1]
+ */
+template<typename Q1, typename Q2, typename R>
+  requires equivalent<typename detail::measurement_column_t<Q1>::dimension, typename R::dimension> &&
+           equivalent<typename detail::measurement_column_t<Q2>::dimension, typename R::dimension>
+void subtract(measurement_span<Q1> lhs, measurement_span<Q2> rhs, measurement_span<R> out, typename R::rep correlation = 0)
+{
+  Expects(lhs.size() == out.size() && rhs.size() == out.size());
+  using T = TYPENAME R::rep;
+  constexpr T f1 = detail::quantity_scale<detail::measurement_column_t<Q1>, R>;
+  constexpr T f2 = detail::quantity_scale<detail::measurement_column_t<Q2>, R>;
+  const auto v1 = lhs.values().data(), s1 = lhs.uncertainties().data();
+  const auto v2 = rhs.values().data(), s2 = rhs.uncertainties().data();
+  const auto v = out.values().data();
+  for (std::size_t i = 0; i < out.size(); ++i) v[i] = R(f1 * v1[i].count() - f2 * v2[i].count());
+  const auto s = out.uncertainties().data();
+  for (std::size_t i = 0; i < out.size(); ++i) s[i] = R(detail::propagate(f1, s1[i].count(), -f2, s2[i].count(), correlation));
+}
+
+/**
+ * @brief Element-wise product of two columns of measurements
+ *
+ * @param correlation the correlation coefficient of the errors of the operands in [-1, 1]
+ */
+template<typename Q1, typename Q2, typename R>
+  requires equivalent<typename decltype(std::declval<detail::measurement_column_t<Q1>>() *
+                                        std::declval<detail::measurement_column_t<Q2>>())::dimension,
+                      typename R::dimension>
+void multiply(measurement_span<Q1> lhs, measurement_span<Q2> rhs, measurement_span<R> out, typename R::rep correlation = 0)
+{
+  Expects(lhs.size() == out.size() && rhs.size() == out.size());
+  using T = TYPENAME R::rep;
+  using product = decltype(std::declval<detail::measurement_column_t<Q1>>() * std::declval<detail::measurement_column_t<Q2>>());
+  constexpr T f = detail::quantity_scale<product, R>;
+  const auto v1 = lhs.values().data(), s1 = lhs.uncertainties().data();
+  const auto v2 = rhs.values().data(), s2 = rhs.uncertainties().data();
+  const auto v = out.values().data();
+  for (std::size_t i = 0; i < out.size(); ++i) v[i] = R(f * v1[i].count() * v2[i].count());
+  const auto s = out.uncertainties().data();
+  for (std::size_t i = 0; i < out.size(); ++i)
+    s[i] = R(f * detail::propagate(v2[i].count(), s1[i].count(), v1[i].count(), s2[i].count(), correlation));
+}
+
+/**
+ * @brief Element-wise quotient of two columns of measurements
+ *
+ * @param correlation the correlation coefficient of the errors of the operands in [-1, 1]
+ */
+template<typename Q1, typename Q2, typename R>
+  requires equivalent<typename decltype(std::declval<detail::measurement_column_t<Q1>>() /
+                                        std::declval<detail::measurement_column_t<Q2>>())::dimension,
+                      typename R::dimension>
+void divide(measurement_span<Q1> lhs, measurement_span<Q2> rhs, measurement_span<R> out, typename R::rep correlation = 0)
+{
+  Expects(lhs.size() == out.size() && rhs.size() == out.size());
+  using T = TYPENAME R::rep;
+  using quotient = decltype(std::declval<detail::measurement_column_t<Q1>>() / std::declval<detail::measurement_column_t<Q2>>());
+  constexpr T f = detail::quantity_scale<quotient, R>;
+  const auto v1 = lhs.values().data(), s1 = lhs.uncertainties().data();
+  const auto v2 = rhs.values().data(), s2 = rhs.uncertainties().data();
+  const auto v = out.values().data();
+  for (std::size_t i = 0; i < out.size(); ++i) v[i] = R(f * v1[i].count() / v2[i].count());
+  const auto s = out.uncertainties().data();
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    const T inv = T(1) / v2[i].count();
+    s[i] = R(f * detail::propagate(inv, s1[i].count(), -v1[i].count() * inv * inv, s2[i].count(), correlation));
+  }
+}
+
+/**
+ * @brief Element-wise square root of a column of measurements
+ */
+template<typename Q, typename R>
+  requires equivalent<dimension_sqrt<typename detail::measurement_column_t<Q>::dimension>, typename R::dimension>
+void sqrt(measurement_span<Q> in, measurement_span<R> out)
+{
+  Expects(in.size() == out.size());
+  using T = TYPENAME R::rep;
+  using root = decltype(sqrt(std::declval<detail::measurement_column_t<Q>>()));
+  constexpr T f = detail::quantity_scale<root, R>;
+  const auto v1 = in.values().data(), s1 = in.uncertainties().data();
+  const auto v = out.values().data();
+  const auto s = out.uncertainties().data();
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    const T root_value = std::sqrt(v1[i].count());
+    v[i] = R(f * root_value);
+    s[i] = R(f * s1[i].count() / (T(2) * root_value));
+  }
+}
+
+}  // namespace units
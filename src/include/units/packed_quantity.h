@@ -0,0 +1,211 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/bits/pow.h>
+#include <units/concepts.h>
+#include <units/quantity_cast.h>
+#include <units/quantity_span.h>
+#include <units/ratio.h>
+#include <gsl/gsl_assert>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace units {
+
+/**
+ * @brief A quantity stored as a scaled integer in a wire format
+ *
+ * The value is stored as `Bits / 8` bytes in the `Endian` byte order with no padding and an
+ * alignment of 1 so the type is trivially copyable and can be overlaid directly onto packet
+ * buffers (i.e. as a member of a packed message structure or as a `std::span` over a payload).
+ * An integer `n` represents the quantity `n * Scale` expressed in the unit of `Q`.
+ *
+ * @code{.cpp}
+ * // altitude in steps of 0.25 ft as a big-endian signed 24-bit integer
+ * using altitude = packed_quantity<si::length<si::international::foot>, std::endian::big, 24, ratio(1, 4)>;
+ * @endcode
+ *
+ * @tparam Q a quantity type with a floating-point representation produced when reading
+ * @tparam Endian a byte order of the stored integer
+ * @tparam Bits a number of bits of the stored integer (8, 16, 24, or 32)
+ * @tparam Scale a value of one step expressed in the unit of `Q`
+ * @tparam Signed whether the stored integer is signed (two's complement)
+ */
+template<Quantity Q, std::endian Endian, std::size_t Bits, ratio Scale = ratio(1), bool Signed = true>
+  requires std::floating_point<typename Q::rep> && (Bits % 8 == 0 && Bits >= 8 && Bits <= 32) && (Scale.num > 0) &&
+           (Endian == std::endian::big || Endian == std::endian::little)
+class packed_quantity {
+  static constexpr std::size_t size = Bits / 8;
+  using rep = TYPENAME Q::rep;
+
+public:
+  using quantity_type = Q;
+  using raw_type = std::conditional_t<Signed, std::int32_t, std::uint32_t>;
+  static constexpr std::endian endian = Endian;
+  static constexpr std::size_t bits = Bits;
+  static constexpr ratio scale = Scale;
+
+  /**
+   * @brief The value of one step in the unit of `Q`
+   */
+  static constexpr rep factor = static_cast<rep>(static_cast<long double>(Scale.num) / static_cast<long double>(Scale.den) *
+                                                 detail::fpow10<long double>(Scale.exp));
+
+  static constexpr raw_type raw_min = Signed ? static_cast<raw_type>(-(std::int64_t(1) << (Bits - 1))) : 0;
+  static constexpr raw_type raw_max =
+      static_cast<raw_type>(Signed ? (std::int64_t(1) << (Bits - 1)) - 1 : (std::int64_t(1) << Bits) - 1);
+
+  packed_quantity() = default;
+
+  /**
+   * @brief Stores `q` rounded to the nearest step (saturated at the ends of the range, NaN as 0)
+   */
+  constexpr explicit packed_quantity(const Q& q) noexcept { set(q); }
+
+  [[nodiscard]] static constexpr packed_quantity from_raw(raw_type raw) noexcept
+  {
+    packed_quantity p;
+    p.store(raw);
+    return p;
+  }
+
+  /**
+   * @brief The stored integer in the native byte order
+   */
+  [[nodiscard]] constexpr raw_type raw() const noexcept
+  {
+    std::uint32_t u = 0;
+    for (std::size_t i = 0; i < size; ++i) u |= static_cast<std::uint32_t>(bytes_[i]) << shift(i);
+    if constexpr (Signed && Bits < 32) {
+      // sign extension
+      return static_cast<std::int32_t>(u << (32 - Bits)) >> (32 - Bits);
+    } else {
+      return static_cast<raw_type>(u);
+    }
+  }
+
+  [[nodiscard]] constexpr Q get() const noexcept { return Q(static_cast<rep>(raw()) * factor); }
+
+  constexpr void set(const Q& q) noexcept
+  {
+    // adding and subtracting it rounds to the nearest integer
+    constexpr double round_magic = 6'755'399'441'055'744.0;
+    double s = (static_cast<double>(q.count()) * (1. / static_cast<double>(factor)) + round_magic) - round_magic;
+    s = s == s ? s : 0.;
+    s = s > static_cast<double>(raw_max) ? static_cast<double>(raw_max) : s;
+    s = s < static_cast<double>(raw_min) ? static_cast<double>(raw_min) : s;
+    store(static_cast<raw_type>(s));
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const packed_quantity&, const packed_quantity&) = default;
+
+private:
+  unsigned char bytes_[size];
+
+  [[nodiscard]] static constexpr std::size_t shift(std::size_t i) noexcept
+  {
+    return Endian == std::endian::big ? 8 * (size - 1 - i) : 8 * i;
+  }
+
+  constexpr void store(raw_type raw) noexcept
+  {
+    const auto u = static_cast<std::uint32_t>(raw);
+    for (std::size_t i = 0; i < size; ++i) bytes_[i] = static_cast<unsigned char>(u >> shift(i));
+  }
+};
+
+namespace detail {
+
+template<typename T>
+inline constexpr bool is_packed_quantity = false;
+
+template<typename Q, std::endian Endian, std::size_t Bits, ratio Scale, bool Signed>
+inline constexpr bool is_packed_quantity<packed_quantity<Q, Endian, Bits, Scale, Signed>> = true;
+
+template<typename T>
+concept packed = is_packed_quantity<T>;
+
+// the factor converting a raw value of `P` to a count of `Q`
+template<packed P, Quantity Q>
+inline constexpr auto packed_factor =
+    static_cast<typename Q::rep>(P::factor) *
+    quantity_scale<quantity<typename P::quantity_type::dimension, typename P::quantity_type::unit, typename Q::rep>, Q>;
+
+}  // namespace detail
+
+/**
+ * @brief Decodes wire-format quantities
+ *
+ * `out[i] = quantity_cast<QOut>(in[i].get())` for every element. The byte order swap, the scale,
+ * and the unit conversion are folded into a single multiplication so the loop vectorizes.
+ */
+template<typename P, std::size_t InExtent, typename QOut, std::size_t OutExtent>
+  requires detail::packed<std::remove_const_t<P>> && std::floating_point<typename QOut::rep> &&
+           QuantityOf<QOut, typename std::remove_const_t<P>::quantity_type::dimension>
+constexpr void unpack(std::span<P, InExtent> in, quantity_span<QOut, OutExtent> out)
+{
+  Expects(in.size() == out.size());
+  constexpr auto f = detail::packed_factor<std::remove_const_t<P>, QOut>;
+  const P* src = in.data();
+  QOut* dst = out.data();
+  for (std::size_t i = 0; i < in.size(); ++i) dst[i] = QOut(static_cast<typename QOut::rep>(src[i].raw()) * f);
+}
+
+/**
+ * @brief Decodes one wire-format field of every packet of a sequence
+ *
+ * @param in packets (i.e. message structures overlaid onto a receive buffer)
+ * @param field a pointer to the packed quantity member of a packet
+ * @param out decoded quantities
+ */
+template<typename Packet, std::size_t InExtent, typename P, typename QOut, std::size_t OutExtent>
+  requires detail::packed<P> && std::floating_point<typename QOut::rep> && QuantityOf<QOut, typename P::quantity_type::dimension>
+constexpr void unpack(std::span<Packet, InExtent> in, P std::remove_const_t<Packet>::*field, quantity_span<QOut, OutExtent> out)
+{
+  Expects(in.size() == out.size());
+  constexpr auto f = detail::packed_factor<P, QOut>;
+  for (std::size_t i = 0; i < in.size(); ++i) out[i] = QOut(static_cast<typename QOut::rep>((in[i].*field).raw()) * f);
+}
+
+/**
+ * @brief Encodes quantities into a wire format
+ *
+ * `out[i] = P(quantity_cast<typename P::quantity_type>(in[i]))` for every element.
+ */
+template<typename QIn, std::size_t InExtent, typename P, std::size_t OutExtent>
+  requires detail::packed<P> && std::floating_point<typename std::remove_const_t<QIn>::rep> &&
+           QuantityOf<typename P::quantity_type, typename std::remove_const_t<QIn>::dimension>
+constexpr void pack(quantity_span<QIn, InExtent> in, std::span<P, OutExtent> out)
+{
+  Expects(in.size() == out.size());
+  using Q = TYPENAME P::quantity_type;
+  constexpr auto f = detail::quantity_scale<std::remove_const_t<QIn>, Q>;
+  for (std::size_t i = 0; i < in.size(); ++i) out[i].set(Q(in[i].count() * f));
+}
+
+}  // namespace units
@@ -30,6 +30,7 @@
 #include <units/generic/dimensionless.h>
 #include <units/quantity_cast.h>
 #include <compare>
+#include <functional>
 #include <ostream>
 
 namespace units {
@@ -46,6 +47,23 @@ concept safe_divisible = // exposition only
     treat_as_floating_point<Rep> ||
     is_integral(quantity_ratio(QuantityFrom{}) / quantity_ratio(QuantityTo{}));
 
+// collapses a result of a comparison to `bool` (a mask of a data-parallel type is true if all its elements are)
+template<typename T>
+[[nodiscard]] constexpr bool all_true(const T& v)
+{
+  if constexpr (std::convertible_to<T, bool>)
+    return static_cast<bool>(v);
+  else
+    return all_of(v);
+}
+
+template<typename Cmp, typename Q1, typename Q2>
+[[nodiscard]] constexpr auto compare_element_wise(const Q1& lhs, const Q2& rhs)
+{
+  using cq = common_quantity<Q1, Q2>;
+  return Cmp{}(cq(lhs).count(), cq(rhs).count());
+}
+
 } // namespace detail
 
 /**
@@ -54,6 +72,10 @@ concept safe_divisible = // exposition only
  * Property of a phenomenon, body, or substance, where the property has a magnitude that can be
  * expressed by means of a number and a measurement unit.
  *
+ * The only data member of a quantity is its value so a quantity has the same size and alignment
+ * as `Rep` and is a standard-layout type if `Rep` is. Contiguous ranges of quantities can
+ * therefore be viewed as ranges of `Rep` (see `as_reps()` and `as_quantities()`).
+ *
  * @tparam D a dimension of the quantity (can be either a BaseDimension or a DerivedDimension)
  * @tparam U a measurement unit of the quantity
  * @tparam Rep a type to be used to represent values of a quantity
@@ -258,7 +280,7 @@ public:
     requires std::regular_invocable<std::divides<>, Value, Rep>
   [[nodiscard]] friend constexpr Quantity auto operator/(const Value& v, const quantity& q)
   {
-    Expects(q.count() != zero().count());
+    Expects(detail::all_true(q.count() != zero().count()));
 
     using dim = dim_invert<D>;
     using ret_unit = downcast_unit<dim, ratio(U::ratio.den, U::ratio.num, -U::ratio.exp)>;
@@ -271,7 +293,7 @@ public:
     requires std::regular_invocable<std::divides<>, Rep, Value>
   [[nodiscard]] friend constexpr Quantity auto operator/(const quantity& q, const Value& v)
   {
-    Expects(v != zero().count());
+    Expects(detail::all_true(v != zero().count()));
 
     using common_rep = decltype(q.count() / v);
     using ret = quantity<D, U, common_rep>;
@@ -282,7 +304,7 @@ public:
     requires std::regular_invocable<std::divides<>, Rep, Rep2>
   [[nodiscard]] friend constexpr Quantity auto operator/(const quantity& lhs, const quantity<D2, U2, Rep2>& rhs)
   {
-    Expects(rhs.count() != zero().count());
+    Expects(detail::all_true(rhs.count() != zero().count()));
 
     using common_rep = decltype(lhs.count() / rhs.count());
     using dim = dimension_divide<D, D2>;
@@ -331,6 +353,50 @@ public:
     return cq(lhs).count() == cq(rhs).count();
   }
 
+  // data-parallel representation types (i.e. SIMD packs) compare element-wise and return masks
+
+  template<typename D2, typename U2, typename Rep2>
+    requires equivalent<D, D2> && detail::data_parallel<Rep> && detail::data_parallel<Rep2>
+  [[nodiscard]] friend constexpr auto operator==(const quantity& lhs, const quantity<D2, U2, Rep2>& rhs)
+  {
+    return detail::compare_element_wise<std::equal_to<>>(lhs, rhs);
+  }
+
+  template<typename D2, typename U2, typename Rep2>
+    requires equivalent<D, D2> && detail::data_parallel<Rep> && detail::data_parallel<Rep2>
+  [[nodiscard]] friend constexpr auto operator!=(const quantity& lhs, const quantity<D2, U2, Rep2>& rhs)
+  {
+    return detail::compare_element_wise<std::not_equal_to<>>(lhs, rhs);
+  }
+
+  template<typename D2, typename U2, typename Rep2>
+    requires equivalent<D, D2> && detail::data_parallel<Rep> && detail::data_parallel<Rep2>
+  [[nodiscard]] friend constexpr auto operator<(const quantity& lhs, const quantity<D2, U2, Rep2>& rhs)
+  {
+    return detail::compare_element_wise<std::less<>>(lhs, rhs);
+  }
+
+  template<typename D2, typename U2, typename Rep2>
+    requires equivalent<D, D2> && detail::data_parallel<Rep> && detail::data_parallel<Rep2>
+  [[nodiscard]] friend constexpr auto operator>(const quantity& lhs, const quantity<D2, U2, Rep2>& rhs)
+  {
+    return detail::compare_element_wise<std::greater<>>(lhs, rhs);
+  }
+
+  template<typename D2, typename U2, typename Rep2>
+    requires equivalent<D, D2> && detail::data_parallel<Rep> && detail::data_parallel<Rep2>
+  [[nodiscard]] friend constexpr auto operator<=(const quantity& lhs, const quantity<D2, U2, Rep2>& rhs)
+  {
+    return detail::compare_element_wise<std::less_equal<>>(lhs, rhs);
+  }
+
+  template<typename D2, typename U2, typename Rep2>
+    requires equivalent<D, D2> && detail::data_parallel<Rep> && detail::data_parallel<Rep2>
+  [[nodiscard]] friend constexpr auto operator>=(const quantity& lhs, const quantity<D2, U2, Rep2>& rhs)
+  {
+    return detail::compare_element_wise<std::greater_equal<>>(lhs, rhs);
+  }
+
   template<class CharT, class Traits>
   friend std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>& os, const quantity& q)
   {
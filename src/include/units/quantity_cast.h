@@ -294,6 +294,51 @@ constexpr ratio cast_ratio(const Q1& from, const Q2& to)
   }
 }
 
+// data-parallel representation types are scaled by a factor of their `value_type` so that
+// every lane is multiplied by the same broadcast constant
+template<typename To, ratio CRatio, data_parallel CRep>
+struct data_parallel_cast_impl {
+  template<Quantity Q>
+  static constexpr To cast(const Q& q)
+  {
+    using rep = TYPENAME To::rep;
+    using value_type = TYPENAME CRep::value_type;
+    if constexpr (treat_as_floating_point<CRep>) {
+      constexpr auto factor = static_cast<value_type>(static_cast<long double>(CRatio.num) / static_cast<long double>(CRatio.den) *
+                                                      fpow10<long double>(CRatio.exp));
+      return To(static_cast<rep>(static_cast<CRep>(q.count()) * factor));
+    } else {
+      constexpr auto num = static_cast<value_type>(CRatio.num * (CRatio.exp > 0 ? ipow10(CRatio.exp) : 1));
+      constexpr auto den = static_cast<value_type>(CRatio.den * (CRatio.exp < 0 ? ipow10(-CRatio.exp) : 1));
+      if constexpr (den == 1)
+        return To(static_cast<rep>(static_cast<CRep>(q.count()) * num));
+      else
+        return To(static_cast<rep>(static_cast<CRep>(q.count()) * num / den));
+    }
+  }
+};
+
+template<typename To, ratio CRatio, data_parallel CRep>
+struct quantity_cast_impl<To, CRatio, CRep, true, true, false> : data_parallel_cast_impl<To, CRatio, CRep> {};
+
+template<typename To, ratio CRatio, data_parallel CRep>
+struct quantity_cast_impl<To, CRatio, CRep, true, false, true> : data_parallel_cast_impl<To, CRatio, CRep> {};
+
+template<typename To, ratio CRatio, data_parallel CRep>
+struct quantity_cast_impl<To, CRatio, CRep, true, false, false> : data_parallel_cast_impl<To, CRatio, CRep> {};
+
+template<typename To, ratio CRatio, data_parallel CRep>
+struct quantity_cast_impl<To, CRatio, CRep, false, true, true> : data_parallel_cast_impl<To, CRatio, CRep> {};
+
+template<typename To, ratio CRatio, data_parallel CRep>
+struct quantity_cast_impl<To, CRatio, CRep, false, true, false> : data_parallel_cast_impl<To, CRatio, CRep> {};
+
+template<typename To, ratio CRatio, data_parallel CRep>
+struct quantity_cast_impl<To, CRatio, CRep, false, false, true> : data_parallel_cast_impl<To, CRatio, CRep> {};
+
+template<typename To, ratio CRatio, data_parallel CRep>
+struct quantity_cast_impl<To, CRatio, CRep, false, false, false> : data_parallel_cast_impl<To, CRatio, CRep> {};
+
 }  // namespace detail
 
 /**
@@ -399,6 +444,15 @@ template<ScalableNumber ToRep, typename D, typename U, typename Rep>
   return quantity_cast<quantity<D, U, ToRep>>(q);
 }
 
+namespace detail {
+
+// the factor converting a value of `From` to `To` computed at compile time
+// (lets loops and custom representation types apply a unit conversion as a single multiplication)
+template<Quantity From, Quantity To>
+inline constexpr TYPENAME To::rep quantity_scale = quantity_cast<To>(From(1)).count();
+
+}  // namespace detail
+
 /**
  * @brief Explicit cast of a quantity point
  *
@@ -0,0 +1,87 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <units/concepts.h>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace units {
+
+/**
+ * @brief A non-owning view over a contiguous sequence of quantities
+ *
+ * @tparam Q a (possibly const-qualified) quantity type
+ * @tparam Extent a number of elements in the sequence or `std::dynamic_extent`
+ */
+template<typename Q, std::size_t Extent = std::dynamic_extent>
+  requires Quantity<std::remove_const_t<Q>>
+using quantity_span = std::span<Q, Extent>;
+
+namespace detail {
+
+template<typename Q>
+concept rep_layout_compatible =
+    std::is_standard_layout_v<Q> && sizeof(Q) == sizeof(typename Q::rep) && alignof(Q) == alignof(typename Q::rep);
+
+}  // namespace detail
+
+/**
+ * @brief Views a contiguous sequence of quantities as their values without copying
+ *
+ * Useful to pass buffers of quantities to numerical libraries (BLAS, FFT, etc.) or I/O.
+ * The values are expressed in the unit of `Q`.
+ *
+ * @return a span of the representation type (`const` if `Q` is `const`) with the same extent
+ */
+template<typename Q, std::size_t Extent>
+  requires Quantity<std::remove_const_t<Q>>
+[[nodiscard]] auto as_reps(quantity_span<Q, Extent> qs) noexcept
+{
+  static_assert(detail::rep_layout_compatible<std::remove_const_t<Q>>,
+                "the representation type does not allow to reinterpret quantities as values");
+  using rep = std::conditional_t<std::is_const_v<Q>, const typename Q::rep, typename Q::rep>;
+  return std::span<rep, Extent>(reinterpret_cast<rep*>(qs.data()), qs.size());
+}
+
+/**
+ * @brief Views a contiguous sequence of values as quantities of type `Q` without copying
+ *
+ * The values are interpreted in the unit of `Q`. The element type of `reps` has to be exactly
+ * the representation type of `Q` so no implicit conversion can silently change the meaning of
+ * the data.
+ *
+ * @return a span of `Q` (`const` if `Rep` is `const`) with the same extent
+ */
+template<Quantity Q, typename Rep, std::size_t Extent>
+  requires std::same_as<std::remove_const_t<Rep>, typename Q::rep>
+[[nodiscard]] auto as_quantities(std::span<Rep, Extent> reps) noexcept
+{
+  static_assert(detail::rep_layout_compatible<Q>, "the representation type does not allow to reinterpret values as quantities");
+  using quantity_type = std::conditional_t<std::is_const_v<Rep>, const Q, Q>;
+  return quantity_span<quantity_type, Extent>(reinterpret_cast<quantity_type*>(reps.data()), reps.size());
+}
+
+}  // namespace units
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <units/bits/constexpr_math.h>
 #include <units/bits/external/hacks.h>
 #include <units/bits/ratio_maths.h>
 #include <cstdint>
@@ -133,6 +134,21 @@ namespace detail {
     return std::array{r.num, r.den * 10, r.exp + 1};
 }
 
+[[nodiscard]] constexpr auto make_exp_multiple_of_3(const ratio& r)
+{
+  std::array result{r.num, r.den, r.exp};
+  while (result[2] % 3 != 0) {
+    if (result[2] > 0) {
+      result[0] *= 10;
+      --result[2];
+    } else {
+      result[1] *= 10;
+      ++result[2];
+    }
+  }
+  return result;
+}
+
 }  // namespace detail
 
 [[nodiscard]] constexpr ratio sqrt(const ratio& r)
@@ -144,6 +160,15 @@ namespace detail {
   return ratio(detail::sqrt_impl(even[0]), detail::sqrt_impl(even[1]), even[2] / 2);
 }
 
+[[nodiscard]] constexpr ratio cbrt(const ratio& r)
+{
+  if(r.num == 0)
+    return ratio(0);
+
+  const auto adjusted = detail::make_exp_multiple_of_3(r);
+  return ratio(detail::cbrt(adjusted[0]), detail::cbrt(adjusted[1]), adjusted[2] / 3);
+}
+
 // common_ratio
 [[nodiscard]] constexpr ratio common_ratio(const ratio& r1, const ratio& r2)
 {
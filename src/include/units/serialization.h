@@ -0,0 +1,531 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <units/bits/bit_cast.h>
+#include <units/bits/pow.h>
+#include <units/customization_points.h>
+#include <units/exponent.h>
+#include <units/quantity.h>
+#include <units/quantity_point.h>
+#include <units/quantity_span.h>
+#include <units/ratio.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Binary encoding of quantities
+//
+// Every record (a column) starts with a header describing its static type followed by the number
+// of elements and the raw representation values:
+//
+//   offset | size | content
+//   -------+------+--------------------------------------------------------------------------
+//        0 |    4 | magic: 'M' 'P' 'U' and the format version (2)
+//        4 |    1 | record kind (`column_header::record_kind`)
+//        5 |    1 | representation kind (`column_header::rep_kind`)
+//        6 |    1 | size of the representation type in bytes
+//        7 |    1 | byte order of the payload (0 - little endian, 1 - big endian)
+//          |   32 | only for the `other` representation kind: `serialization_rep_id` (4 times 8 bytes)
+//          |    1 | number of base dimension exponents `n`
+//          |      | `n` times: base dimension symbol length (1 byte), the symbol (UTF-8),
+//          |      |            exponent numerator and denominator (8 bytes each)
+//          |   24 | unit ratio (num, den, exp; 8 bytes each) relative to the base units
+//          |    8 | number of elements `count`
+//          |      | `count` representation values in the byte order of the payload
+//
+// All the header integers are little endian. Everything up to the element count (the signature)
+// depends only on the static type of the quantity so it is computed at compile time.
+
+namespace units {
+
+/**
+ * @brief An error reported when the data being deserialized are malformed or do not match the target type
+ */
+class serialization_error : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief A decoded record header
+ */
+struct column_header {
+  enum class record_kind : std::uint8_t { quantity, quantity_point };
+  enum class rep_kind : std::uint8_t { signed_integral, unsigned_integral, floating_point, other };
+  using rep_id_type = std::array<std::int64_t, 4>;
+
+  struct exponent_entry {
+    std::string symbol;  ///< base dimension symbol
+    std::intmax_t num;
+    std::intmax_t den;
+    [[nodiscard]] friend bool operator==(const exponent_entry&, const exponent_entry&) = default;
+  };
+
+  record_kind kind;
+  rep_kind rep;
+  std::size_t rep_size;
+  rep_id_type rep_id{};  ///< `serialization_rep_id` of the representation type (only for `rep_kind::other`)
+  std::endian byte_order;
+  std::vector<exponent_entry> exponents;
+  ratio unit_ratio{1};
+  std::uint64_t count;
+  std::size_t size;  ///< number of bytes occupied by the header (including the element count)
+};
+
+namespace detail {
+
+inline constexpr std::array<std::byte, 4> serialization_magic{std::byte{'M'}, std::byte{'P'}, std::byte{'U'}, std::byte{2}};
+
+template<std::integral T>
+constexpr std::byte* store_le(std::byte* p, T v) noexcept
+{
+  auto u = static_cast<std::make_unsigned_t<T>>(v);
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    *p++ = static_cast<std::byte>(u & 0xffu);
+    u = static_cast<decltype(u)>(u >> 4 >> 4);
+  }
+  return p;
+}
+
+template<std::integral T>
+[[nodiscard]] constexpr T load_le(const std::byte* p) noexcept
+{
+  std::make_unsigned_t<T> u = 0;
+  for (std::size_t i = sizeof(T); i > 0; --i)
+    u = static_cast<decltype(u)>((u << 4 << 4) | std::to_integer<std::uint8_t>(p[i - 1]));
+  return static_cast<T>(u);
+}
+
+template<typename Rep>
+inline constexpr column_header::rep_kind rep_kind_of =
+    std::is_same_v<Rep, bool> ? column_header::rep_kind::other :
+    std::is_floating_point_v<Rep> && std::numeric_limits<Rep>::is_iec559 ? column_header::rep_kind::floating_point :
+    std::is_integral_v<Rep> && std::is_signed_v<Rep> ? column_header::rep_kind::signed_integral :
+    std::is_integral_v<Rep> ? column_header::rep_kind::unsigned_integral :
+    column_header::rep_kind::other;
+
+// exponents of base dimensions forming `D`
+template<Dimension D>
+struct dimension_exponents {
+  using type = TYPENAME D::exponents;
+};
+
+template<BaseDimension D>
+struct dimension_exponents<D> {
+  using type = exponent_list<exponent<D, 1>>;
+};
+
+template<typename List>
+struct signature_exponents;
+
+template<typename... Es>
+struct signature_exponents<exponent_list<Es...>> {
+  static constexpr std::size_t count = sizeof...(Es);
+  static constexpr std::size_t size = ((1 + Es::dimension::symbol.size() + 16) + ... + 0);
+
+  static constexpr std::byte* store(std::byte* p) noexcept
+  {
+    ((p = store_exponent<Es>(p)), ...);
+    return p;
+  }
+
+private:
+  template<typename E>
+  static constexpr std::byte* store_exponent(std::byte* p) noexcept
+  {
+    constexpr auto symbol = E::dimension::symbol;
+    static_assert(symbol.size() < 256);
+    *p++ = static_cast<std::byte>(symbol.size());
+    for (std::size_t i = 0; i < symbol.size(); ++i) *p++ = static_cast<std::byte>(symbol[i]);
+    p = store_le(p, E::num);
+    return store_le(p, E::den);
+  }
+};
+
+/**
+ * @brief The part of the header that depends only on the static type of a quantity
+ */
+template<Quantity Q, column_header::record_kind Kind>
+  requires std::is_trivially_copyable_v<typename Q::rep>
+inline constexpr auto serialization_signature = [] {
+  using rep = TYPENAME Q::rep;
+  using exponents = signature_exponents<typename dimension_exponents<typename Q::dimension>::type>;
+  static_assert(exponents::count < 256);
+  static_assert(sizeof(rep) < 256);
+  constexpr ratio r = quantity_ratio(Q());
+  // custom representation types of the same size are told apart only by their identifiers
+  constexpr bool custom = rep_kind_of<rep> == column_header::rep_kind::other;
+  static_assert(!custom || serialization_rep_id<rep> != column_header::rep_id_type{},
+                "units::serialization_rep_id has to be specialized for a custom representation type");
+
+  std::array<std::byte, 9 + (custom ? 32 : 0) + exponents::size + 24> sig{};
+  std::byte* p = std::copy(serialization_magic.begin(), serialization_magic.end(), sig.data());
+  *p++ = static_cast<std::byte>(Kind);
+  *p++ = static_cast<std::byte>(rep_kind_of<rep>);
+  *p++ = static_cast<std::byte>(sizeof(rep));
+  *p++ = static_cast<std::byte>(std::endian::native == std::endian::little ? 0 : 1);
+  if constexpr (custom)
+    for (std::int64_t v : serialization_rep_id<rep>) p = store_le(p, v);
+  *p++ = static_cast<std::byte>(exponents::count);
+  p = exponents::store(p);
+  p = store_le(p, r.num);
+  p = store_le(p, r.den);
+  store_le(p, r.exp);
+  return sig;
+}();
+
+template<typename Out>
+Out write_bytes(const std::byte* first, std::size_t size, Out out)
+{
+  return std::copy(first, first + size, out);
+}
+
+template<Quantity Q, column_header::record_kind Kind, typename Out>
+Out serialize_column(std::span<const Q> qs, Out out)
+{
+  using rep = TYPENAME Q::rep;
+  static_assert(sizeof(Q) == sizeof(rep));
+
+  constexpr auto& sig = serialization_signature<Q, Kind>;
+  out = write_bytes(sig.data(), sig.size(), out);
+  std::array<std::byte, 8> count{};
+  store_le(count.data(), static_cast<std::uint64_t>(qs.size()));
+  out = write_bytes(count.data(), count.size(), out);
+  for (const Q& q : qs) {
+    const auto bytes = bit_cast<std::array<std::byte, sizeof(rep)>>(q.count());
+    out = write_bytes(bytes.data(), bytes.size(), out);
+  }
+  return out;
+}
+
+// unit ratios come from untrusted data so their decimal exponents are limited to the range of `long double`
+inline constexpr std::intmax_t max_unit_ratio_exp = std::numeric_limits<long double>::max_exponent10;
+
+[[nodiscard]] constexpr bool valid_unit_ratio(std::intmax_t num, std::intmax_t den, std::intmax_t exp) noexcept
+{
+  return num != 0 && num != std::numeric_limits<std::intmax_t>::min() && den > 0 && exp >= -max_unit_ratio_exp &&
+         exp <= max_unit_ratio_exp;
+}
+
+// `lhs * rhs` or `std::nullopt` on overflow (none of the arguments may be `INTMAX_MIN`)
+[[nodiscard]] constexpr std::optional<std::intmax_t> checked_multiply(std::intmax_t lhs, std::intmax_t rhs) noexcept
+{
+  if (lhs == 0 || rhs == 0) return 0;
+  if (abs(lhs) > std::numeric_limits<std::intmax_t>::max() / abs(rhs)) return std::nullopt;
+  return lhs * rhs;
+}
+
+// `lhs / rhs` of valid unit ratios or `std::nullopt` if it is not representable
+[[nodiscard]] constexpr std::optional<ratio> unit_ratio_quotient(const ratio& lhs, const ratio& rhs) noexcept
+{
+  const std::intmax_t gcd1 = std::gcd(lhs.num, rhs.num);
+  const std::intmax_t gcd2 = std::gcd(lhs.den, rhs.den);
+  const auto num = checked_multiply(lhs.num / gcd1, rhs.den / gcd2);
+  const auto den = checked_multiply(lhs.den / gcd2, rhs.num / gcd1);
+  const std::intmax_t exp = lhs.exp - rhs.exp;
+  if (!num || !den || !valid_unit_ratio(*num, *den < 0 ? -*den : *den, exp)) return std::nullopt;
+  return ratio(*num, *den, exp);
+}
+
+// `v * 10^exp` as `T` or `std::nullopt` if it does not fit
+template<typename T>
+[[nodiscard]] constexpr std::optional<T> checked_scale(std::intmax_t v, std::intmax_t exp) noexcept
+{
+  for (; exp > 0; --exp) {
+    const auto next = checked_multiply(v, 10);
+    if (!next) return std::nullopt;
+    v = *next;
+  }
+  if constexpr (std::integral<T>)
+    if (!std::in_range<T>(v)) return std::nullopt;
+  return static_cast<T>(v);
+}
+
+// converts `count` values of type `From` stored at `src` to quantities of type `To` with a unit `ratio` times
+// larger than the unit of `To` (the same arithmetic as `quantity_cast` but with a ratio known only at runtime)
+template<typename From, Quantity To>
+void convert_column(const std::byte* src, std::size_t count, const ratio& r, To* dst)
+{
+  using to_rep = TYPENAME To::rep;
+  using c_rep = std::common_type_t<From, to_rep>;
+
+  if constexpr (treat_as_floating_point<c_rep>) {
+    const c_rep factor = static_cast<c_rep>(r.num) / static_cast<c_rep>(r.den) * fpow10<c_rep>(r.exp);
+    if constexpr (std::is_floating_point_v<c_rep>)
+      if (!std::isfinite(factor) || factor == 0) throw serialization_error("units: unit ratio out of range of the representation type");
+    for (std::size_t i = 0; i < count; ++i) {
+      From v;
+      std::memcpy(&v, src + i * sizeof(From), sizeof(From));
+      dst[i] = To(static_cast<to_rep>(static_cast<c_rep>(v) * factor));
+    }
+  } else if constexpr (requires(c_rep v, std::intmax_t i) { { v * i } -> std::convertible_to<c_rep>; { v / i } -> std::convertible_to<c_rep>; }) {
+    // integral types are scaled in their own domain (i.e. to not mix signed and unsigned values)
+    using factor_t = std::conditional_t<std::integral<c_rep>, c_rep, std::intmax_t>;
+    const auto num = checked_scale<factor_t>(r.num, r.exp > 0 ? r.exp : 0);
+    const auto den = checked_scale<factor_t>(r.den, r.exp < 0 ? -r.exp : 0);
+    if (!num || !den) throw serialization_error("units: unit ratio out of range of the representation type");
+    for (std::size_t i = 0; i < count; ++i) {
+      From v;
+      std::memcpy(&v, src + i * sizeof(From), sizeof(From));
+      dst[i] = To(static_cast<to_rep>(static_cast<c_rep>(static_cast<c_rep>(v) * *num) / *den));
+    }
+  } else {
+    throw serialization_error("units: unit conversion is not supported by the representation type");
+  }
+}
+
+template<Quantity Q, column_header::record_kind Kind>
+std::size_t deserialize_column(std::span<const std::byte>& in, std::span<Q> out);
+
+}  // namespace detail
+
+/**
+ * @brief Decodes the header of a record
+ *
+ * @throws serialization_error if the data do not start with a valid header
+ */
+[[nodiscard]] inline column_header read_header(std::span<const std::byte> in)
+{
+  std::size_t pos = 0;
+  const auto need = [&](std::size_t n) {
+    if (in.size() - pos < n) throw serialization_error("units: truncated header");
+  };
+  const auto byte = [&] {
+    need(1);
+    return std::to_integer<std::uint8_t>(in[pos++]);
+  };
+  const auto i64 = [&] {
+    need(8);
+    const auto v = detail::load_le<std::int64_t>(in.data() + pos);
+    pos += 8;
+    return v;
+  };
+
+  need(detail::serialization_magic.size());
+  if (!std::equal(detail::serialization_magic.begin(), detail::serialization_magic.end(), in.begin()))
+    throw serialization_error("units: not a serialized quantity or unsupported format version");
+  pos += detail::serialization_magic.size();
+
+  column_header h;
+  const auto kind = byte();
+  const auto rep = byte();
+  if (kind > 1 || rep > 3) throw serialization_error("units: corrupted header");
+  h.kind = static_cast<column_header::record_kind>(kind);
+  h.rep = static_cast<column_header::rep_kind>(rep);
+  h.rep_size = byte();
+  h.byte_order = byte() == 0 ? std::endian::little : std::endian::big;
+  if (h.rep == column_header::rep_kind::other)
+    for (auto& v : h.rep_id) v = i64();
+
+  const std::size_t n = byte();
+  h.exponents.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::size_t len = byte();
+    need(len);
+    std::string symbol(reinterpret_cast<const char*>(in.data() + pos), len);
+    pos += len;
+    const auto num = i64();
+    const auto den = i64();
+    h.exponents.push_back({std::move(symbol), num, den});
+  }
+
+  const auto num = i64();
+  const auto den = i64();
+  const auto exp = i64();
+  if (!detail::valid_unit_ratio(num, den, exp)) throw serialization_error("units: corrupted unit ratio");
+  h.unit_ratio = ratio(num, den, exp);
+
+  need(8);
+  h.count = detail::load_le<std::uint64_t>(in.data() + pos);
+  pos += 8;
+  h.size = pos;
+  return h;
+}
+
+/**
+ * @brief Serializes a quantity
+ *
+ * @return an iterator past the last byte written
+ */
+template<Quantity Q, std::output_iterator<std::byte> Out>
+  requires std::is_trivially_copyable_v<typename Q::rep>
+Out serialize(const Q& q, Out out)
+{
+  return detail::serialize_column<Q, column_header::record_kind::quantity>(std::span<const Q, 1>(&q, 1), out);
+}
+
+/**
+ * @brief Serializes a quantity point
+ *
+ * @return an iterator past the last byte written
+ */
+template<QuantityPoint QP, std::output_iterator<std::byte> Out>
+  requires std::is_trivially_copyable_v<typename QP::rep>
+Out serialize(const QP& qp, Out out)
+{
+  const typename QP::quantity_type q = qp.relative();
+  return detail::serialize_column<typename QP::quantity_type, column_header::record_kind::quantity_point>(std::span(&q, 1), out);
+}
+
+/**
+ * @brief Serializes a contiguous range of quantities as a single record
+ *
+ * @return an iterator past the last byte written
+ */
+template<typename Q, std::size_t Extent, std::output_iterator<std::byte> Out>
+  requires std::is_trivially_copyable_v<typename std::remove_const_t<Q>::rep>
+Out serialize(quantity_span<Q, Extent> qs, Out out)
+{
+  return detail::serialize_column<std::remove_const_t<Q>, column_header::record_kind::quantity>(std::span<const std::remove_const_t<Q>>(qs), out);
+}
+
+/**
+ * @brief Deserializes a record of quantities
+ *
+ * If the record was written for the same quantity type the values are copied with a single `memcpy`.
+ * Otherwise, the dimensions have to match and values are converted to the unit and representation
+ * type of `Q` in one pass.
+ *
+ * @param in bytes to read from; on return it points past the record
+ * @param out quantities to fill; must be large enough for all the elements of the record
+ * @return the number of quantities read
+ *
+ * @throws serialization_error if the data are malformed or cannot be converted to `Q`
+ */
+template<typename Q, std::size_t Extent>
+  requires std::is_trivially_copyable_v<typename Q::rep>
+std::size_t deserialize(std::span<const std::byte>& in, quantity_span<Q, Extent> out)
+{
+  return detail::deserialize_column<Q, column_header::record_kind::quantity>(in, std::span<Q>(out));
+}
+
+/**
+ * @brief Deserializes a single quantity
+ *
+ * @param in bytes to read from; on return it points past the record
+ *
+ * @throws serialization_error if the data are malformed, cannot be converted to `Q`, or do not hold exactly one element
+ */
+template<Quantity Q>
+  requires std::is_trivially_copyable_v<typename Q::rep>
+[[nodiscard]] Q deserialize(std::span<const std::byte>& in)
+{
+  Q q;
+  if (detail::deserialize_column<Q, column_header::record_kind::quantity>(in, std::span(&q, 1)) != 1)
+    throw serialization_error("units: empty record");
+  return q;
+}
+
+/**
+ * @brief Deserializes a single quantity point
+ *
+ * @param in bytes to read from; on return it points past the record
+ *
+ * @throws serialization_error if the data are malformed, cannot be converted to `QP`, or do not hold exactly one element
+ */
+template<QuantityPoint QP>
+  requires std::is_trivially_copyable_v<typename QP::rep>
+[[nodiscard]] QP deserialize(std::span<const std::byte>& in)
+{
+  typename QP::quantity_type q;
+  if (detail::deserialize_column<typename QP::quantity_type, column_header::record_kind::quantity_point>(in, std::span(&q, 1)) != 1)
+    throw serialization_error("units: empty record");
+  return QP(q);
+}
+
+namespace detail {
+
+template<Quantity Q, column_header::record_kind Kind>
+std::size_t deserialize_column(std::span<const std::byte>& in, std::span<Q> out)
+{
+  using rep = TYPENAME Q::rep;
+  static_assert(sizeof(Q) == sizeof(rep));
+  constexpr auto& sig = serialization_signature<Q, Kind>;
+
+  // fast path: the record was written for exactly the same type
+  if (in.size() >= sig.size() + 8 && std::memcmp(in.data(), sig.data(), sig.size()) == 0) {
+    const auto count = load_le<std::uint64_t>(in.data() + sig.size());
+    const std::size_t header_size = sig.size() + 8;
+    if (count > out.size()) throw serialization_error("units: output range too small");
+    if ((in.size() - header_size) / sizeof(rep) < count) throw serialization_error("units: truncated payload");
+    const auto n = static_cast<std::size_t>(count);
+    if (n > 0) std::memcpy(static_cast<void*>(out.data()), in.data() + header_size, n * sizeof(rep));
+    in = in.subspan(header_size + n * sizeof(rep));
+    return n;
+  }
+
+  const column_header h = read_header(in);
+  // the expected header decoded once per type
+  static const column_header expected = [] {
+    std::array<std::byte, serialization_signature<Q, Kind>.size() + 8> buf{};
+    std::ranges::copy(serialization_signature<Q, Kind>, buf.begin());
+    return read_header(buf);
+  }();
+
+  if (h.kind != expected.kind) throw serialization_error("units: record kind mismatch");
+  if (h.exponents != expected.exponents) throw serialization_error("units: dimension mismatch");
+  if (h.byte_order != std::endian::native) throw serialization_error("units: unsupported byte order");
+  if (h.count > out.size()) throw serialization_error("units: output range too small");
+  if (h.rep_size == 0 || (in.size() - h.size) / h.rep_size < h.count) throw serialization_error("units: truncated payload");
+
+  const auto n = static_cast<std::size_t>(h.count);
+  const std::byte* payload = in.data() + h.size;
+  const auto r = unit_ratio_quotient(h.unit_ratio, expected.unit_ratio);
+  if (!r) throw serialization_error("units: unit ratio out of range");
+
+  using kind = column_header::rep_kind;
+  const auto stored_as = [&](kind k, std::size_t size) { return h.rep == k && h.rep_size == size; };
+  if (stored_as(kind::floating_point, sizeof(double))) convert_column<double>(payload, n, *r, out.data());
+  else if (stored_as(kind::floating_point, sizeof(float))) convert_column<float>(payload, n, *r, out.data());
+  else if (stored_as(kind::signed_integral, 8)) convert_column<std::int64_t>(payload, n, *r, out.data());
+  else if (stored_as(kind::signed_integral, 4)) convert_column<std::int32_t>(payload, n, *r, out.data());
+  else if (stored_as(kind::signed_integral, 2)) convert_column<std::int16_t>(payload, n, *r, out.data());
+  else if (stored_as(kind::signed_integral, 1)) convert_column<std::int8_t>(payload, n, *r, out.data());
+  else if (stored_as(kind::unsigned_integral, 8)) convert_column<std::uint64_t>(payload, n, *r, out.data());
+  else if (stored_as(kind::unsigned_integral, 4)) convert_column<std::uint32_t>(payload, n, *r, out.data());
+  else if (stored_as(kind::unsigned_integral, 2)) convert_column<std::uint16_t>(payload, n, *r, out.data());
+  else if (stored_as(kind::unsigned_integral, 1)) convert_column<std::uint8_t>(payload, n, *r, out.data());
+  else throw serialization_error("units: unsupported representation type conversion");
+
+  in = in.subspan(h.size + n * h.rep_size);
+  return n;
+}
+
+}  // namespace detail
+
+}  // namespace units
@@ -0,0 +1,201 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/generic/angle.h>
+#include <units/math.h>
+#include <units/quantity_cast.h>
+#include <units/quantity_span.h>
+#include <gsl/gsl_assert>
+#include <concepts>
+#include <cstddef>
+#include <experimental/simd>
+
+// SIMD packs as a representation type
+//
+// `std::experimental::simd` (Parallelism TS v2) satisfies `ScalableNumber` so kernels can be
+// written once in terms of quantities of SIMD packs and keep the dimensional analysis:
+//
+//   for (std::size_t i = 0; i + pack_size <= n; i += pack_size) {
+//     const auto d = load(distances, i);            // length<metre, native_simd<double>>
+//     const auto t = load(times, i);                // time<second, native_simd<double>>
+//     store(speed<metre_per_second, native_simd<double>>(d / t), speeds, i);
+//   }
+//
+// Unit conversions multiply every lane by the same constant, comparisons return masks
+// (`simd_mask`) instead of `bool`, and `select()` blends quantities by a mask.
+
+namespace units {
+
+/**
+ * @brief A quantity with a SIMD pack of values of `T` as a representation type
+ */
+template<Dimension D, UnitOf<D> U, typename T, typename Abi = std::experimental::simd_abi::native<T>>
+using quantity_pack = quantity<D, U, std::experimental::simd<T, Abi>>;
+
+/**
+ * @brief Loads consecutive quantities into a quantity of a SIMD pack
+ *
+ * @tparam Abi the ABI of the pack
+ * @param in contiguous quantities
+ * @param offset the index of the first quantity to load; `offset + size()` of the pack must not exceed `in.size()`
+ */
+template<typename Abi, typename Q, std::size_t Extent>
+  requires Quantity<std::remove_const_t<Q>> && std::is_arithmetic_v<typename Q::rep>
+[[nodiscard]] quantity_pack<typename Q::dimension, typename Q::unit, typename Q::rep, Abi> load(quantity_span<Q, Extent> in, std::size_t offset = 0)
+{
+  using pack = std::experimental::simd<typename Q::rep, Abi>;
+  Expects(offset <= in.size() && in.size() - offset >= pack::size());
+  return quantity_pack<typename Q::dimension, typename Q::unit, typename Q::rep, Abi>(
+      pack(as_reps(in).data() + offset, std::experimental::element_aligned));
+}
+
+/**
+ * @brief Loads consecutive quantities into a quantity of a native SIMD pack
+ */
+template<typename Q, std::size_t Extent>
+  requires Quantity<std::remove_const_t<Q>> && std::is_arithmetic_v<typename Q::rep>
+[[nodiscard]] quantity_pack<typename Q::dimension, typename Q::unit, typename Q::rep> load(quantity_span<Q, Extent> in, std::size_t offset = 0)
+{
+  return load<std::experimental::simd_abi::native<typename Q::rep>>(in, offset);
+}
+
+/**
+ * @brief Stores the lanes of a quantity of a SIMD pack to consecutive quantities
+ *
+ * @param q the pack to store
+ * @param out contiguous quantities of the same dimension, unit, and element type
+ * @param offset the index of the first quantity to write; `offset + size()` of the pack must not exceed `out.size()`
+ */
+template<typename D, typename U, typename T, typename Abi, std::size_t Extent>
+void store(const quantity_pack<D, U, T, Abi>& q, quantity_span<quantity<D, U, T>, Extent> out, std::size_t offset = 0)
+{
+  Expects(offset <= out.size() && out.size() - offset >= (std::experimental::simd<T, Abi>::size()));
+  q.count().copy_to(as_reps(out).data() + offset, std::experimental::element_aligned);
+}
+
+/**
+ * @brief Selects lanes of `a` where `mask` is set and lanes of `b` elsewhere
+ */
+template<typename D, typename U, typename T, typename Abi>
+[[nodiscard]] quantity_pack<D, U, T, Abi> select(const std::experimental::simd_mask<T, Abi>& mask, const quantity_pack<D, U, T, Abi>& a,
+                                                 const quantity_pack<D, U, T, Abi>& b)
+{
+  auto v = b.count();
+  where(mask, v) = a.count();
+  return quantity_pack<D, U, T, Abi>(v);
+}
+
+/**
+ * @brief The sum of all the lanes
+ */
+template<typename D, typename U, typename T, typename Abi>
+[[nodiscard]] quantity<D, U, T> reduce(const quantity_pack<D, U, T, Abi>& q)
+{
+  return quantity<D, U, T>(reduce(q.count()));
+}
+
+/**
+ * @brief The smallest of all the lanes
+ */
+template<typename D, typename U, typename T, typename Abi>
+[[nodiscard]] quantity<D, U, T> hmin(const quantity_pack<D, U, T, Abi>& q)
+{
+  return quantity<D, U, T>(hmin(q.count()));
+}
+
+/**
+ * @brief The largest of all the lanes
+ */
+template<typename D, typename U, typename T, typename Abi>
+[[nodiscard]] quantity<D, U, T> hmax(const quantity_pack<D, U, T, Abi>& q)
+{
+  return quantity<D, U, T>(hmax(q.count()));
+}
+
+// element-wise math functions (the ones from <units/math.h> and <units/trigonometry.h> that do not already work with SIMD packs)
+
+template<typename D, typename U, std::floating_point T, typename Abi>
+[[nodiscard]] Quantity auto sqrt(const quantity_pack<D, U, T, Abi>& q)
+{
+  using dim = dimension_sqrt<D>;
+  using unit = downcast_unit<dim, sqrt(U::ratio)>;
+  return quantity_pack<dim, unit, T, Abi>(sqrt(q.count()));
+}
+
+template<typename D, typename U, std::floating_point T, typename Abi>
+[[nodiscard]] Quantity auto cbrt(const quantity_pack<D, U, T, Abi>& q)
+{
+  using dim = dimension_cbrt<D>;
+  using unit = downcast_unit<dim, cbrt(U::ratio)>;
+  return quantity_pack<dim, unit, T, Abi>(cbrt(q.count()));
+}
+
+template<typename D, typename U, typename T, typename Abi>
+[[nodiscard]] quantity_pack<D, U, T, Abi> abs(const quantity_pack<D, U, T, Abi>& q)
+{
+  return quantity_pack<D, U, T, Abi>(abs(q.count()));
+}
+
+template<typename D1, typename U1, typename D2, typename U2, std::floating_point T, typename Abi>
+  requires equivalent<D1, D2>
+[[nodiscard]] Quantity auto hypot(const quantity_pack<D1, U1, T, Abi>& x, const quantity_pack<D2, U2, T, Abi>& y)
+{
+  using type = common_quantity<quantity_pack<D1, U1, T, Abi>, quantity_pack<D2, U2, T, Abi>>;
+  return type(hypot(type(x).count(), type(y).count()));
+}
+
+template<typename U, std::floating_point T, typename Abi>
+[[nodiscard]] quantity_pack<dim_one, one, T, Abi> exp(const quantity_pack<dim_one, U, T, Abi>& q)
+{
+  return quantity_pack<dim_one, one, T, Abi>(exp(q.count() * detail::quantity_scale<dimensionless<U, T>, dimensionless<one, T>>));
+}
+
+template<typename U, std::floating_point T, typename Abi>
+[[nodiscard]] Dimensionless auto sin(const quantity_pack<dim_angle<>, U, T, Abi>& q)
+{
+  return quantity_pack<dim_one, one, T, Abi>(sin(q.count() * detail::quantity_scale<angle<U, T>, angle<radian, T>>));
+}
+
+template<typename U, std::floating_point T, typename Abi>
+[[nodiscard]] Dimensionless auto cos(const quantity_pack<dim_angle<>, U, T, Abi>& q)
+{
+  return quantity_pack<dim_one, one, T, Abi>(cos(q.count() * detail::quantity_scale<angle<U, T>, angle<radian, T>>));
+}
+
+template<typename U, std::floating_point T, typename Abi>
+[[nodiscard]] Dimensionless auto tan(const quantity_pack<dim_angle<>, U, T, Abi>& q)
+{
+  return quantity_pack<dim_one, one, T, Abi>(tan(q.count() * detail::quantity_scale<angle<U, T>, angle<radian, T>>));
+}
+
+template<typename D1, typename U1, typename D2, typename U2, std::floating_point T, typename Abi>
+  requires equivalent<D1, D2>
+[[nodiscard]] Angle auto atan2(const quantity_pack<D1, U1, T, Abi>& y, const quantity_pack<D2, U2, T, Abi>& x)
+{
+  using type = common_quantity<quantity_pack<D1, U1, T, Abi>, quantity_pack<D2, U2, T, Abi>>;
+  return angle<radian, std::experimental::simd<T, Abi>>(atan2(type(y).count(), type(x).count()));
+}
+
+}  // namespace units
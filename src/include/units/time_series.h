@@ -0,0 +1,266 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/physical/bits/time.h>
+#include <units/quantity.h>
+#include <units/quantity_point.h>
+#include <units/quantity_span.h>
+#include <gsl/gsl_assert>
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace units {
+
+/**
+ * @brief Interpolation methods of a `time_series`
+ */
+enum class interpolation {
+  previous,  ///< the value of the last sample at or before the requested time
+  linear,    ///< linear interpolation between the neighbouring samples
+  cubic      ///< cubic Hermite spline with Catmull-Rom tangents (passes through all the samples)
+};
+
+/**
+ * @brief Aggregations of samples in windows of a `time_series`
+ */
+enum class aggregation { mean, min, max, sum };
+
+/**
+ * @brief A sequence of samples of a quantity ordered by time
+ *
+ * Timestamps and values are stored in two separate contiguous columns, both sorted by time.
+ * Lookups of a time are binary searches (O(log n)). `resample()` and `aggregate()` produce
+ * many outputs in a single linear pass over the samples because the requested times are
+ * increasing.
+ *
+ * Interpolation only scales differences of values by ratios of durations so the dimension of
+ * the values is preserved (i.e. interpolating `si::speed` gives `si::speed`). Requests outside
+ * of the sampled range are clamped to the first or the last sample.
+ *
+ * @tparam TimePoint the type of the timestamps (a `quantity_point` of time)
+ * @tparam Value the type of the values
+ */
+template<QuantityPoint TimePoint, Quantity Value>
+  requires physical::Time<typename TimePoint::quantity_type> && std::is_floating_point_v<typename TimePoint::rep> &&
+           std::is_floating_point_v<typename Value::rep>
+class time_series {
+public:
+  using time_point = TimePoint;
+  using duration = TYPENAME TimePoint::quantity_type;
+  using value_type = Value;
+
+  time_series() = default;
+
+  /**
+   * @brief Makes a series from columns of timestamps and values
+   *
+   * @param times timestamps in non-decreasing order
+   * @param values one value per timestamp
+   */
+  time_series(std::span<const TimePoint> times, quantity_span<const Value> values) :
+      times_(times.begin(), times.end()), values_(values.begin(), values.end())
+  {
+    Expects(times.size() == values.size());
+    Expects(std::is_sorted(times.begin(), times.end(), less));
+  }
+
+  /**
+   * @brief Appends a sample that is not older than the last one
+   */
+  void push_back(const TimePoint& t, const Value& v)
+  {
+    Expects(empty() || !less(t, times_.back()));
+    times_.push_back(t);
+    values_.push_back(v);
+  }
+
+  /**
+   * @brief Inserts a sample keeping the series sorted (after the samples with the same time)
+   */
+  void insert(const TimePoint& t, const Value& v)
+  {
+    const auto it = std::upper_bound(times_.begin(), times_.end(), t, less);
+    const auto i = it - times_.begin();
+    times_.insert(it, t);
+    values_.insert(values_.begin() + i, v);
+  }
+
+  void reserve(std::size_t n)
+  {
+    times_.reserve(n);
+    values_.reserve(n);
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return times_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return times_.empty(); }
+
+  [[nodiscard]] std::span<const TimePoint> times() const noexcept { return times_; }
+  [[nodiscard]] quantity_span<const Value> values() const noexcept { return values_; }
+
+  /**
+   * @brief The index of the first sample not older than `t` (`size()` if there is none)
+   */
+  [[nodiscard]] std::size_t lower_bound(const TimePoint& t) const
+  {
+    return static_cast<std::size_t>(std::lower_bound(times_.begin(), times_.end(), t, less) - times_.begin());
+  }
+
+  /**
+   * @brief The value of the series at `t`
+   */
+  [[nodiscard]] Value interpolate(const TimePoint& t, interpolation method = interpolation::linear) const
+  {
+    Expects(!empty());
+    const auto upper = std::upper_bound(times_.begin(), times_.end(), t, less);
+    return at(static_cast<std::size_t>(upper - times_.begin()), t, method);
+  }
+
+  /**
+   * @brief Samples the series at a fixed rate
+   *
+   * @param start the time of the first sample
+   * @param period the time between samples
+   * @param count the number of samples
+   */
+  [[nodiscard]] time_series resample(const TimePoint& start, const duration& period, std::size_t count,
+                                     interpolation method = interpolation::linear) const
+  {
+    Expects(!empty());
+    Expects(period > duration::zero());
+    time_series ret;
+    ret.reserve(count);
+    std::size_t upper = lower_bound(start);
+    for (std::size_t k = 0; k < count; ++k) {
+      const TimePoint t(start.relative() + period * static_cast<TYPENAME duration::rep>(k));
+      while (upper < size() && !less(t, times_[upper])) ++upper;
+      ret.times_.push_back(t);
+      ret.values_.push_back(at(upper, t, method));
+    }
+    return ret;
+  }
+
+  /**
+   * @brief Aggregates the samples in consecutive windows
+   *
+   * The window `k` covers `[start + k * period, start + (k + 1) * period)`. The result has one
+   * sample, timestamped with the start of the window, for every window that is not empty.
+   *
+   * @param start the beginning of the first window
+   * @param period the length of a window
+   * @param count the number of windows
+   */
+  [[nodiscard]] time_series aggregate(const TimePoint& start, const duration& period, std::size_t count,
+                                      aggregation method) const
+  {
+    Expects(period > duration::zero());
+    time_series ret;
+    std::size_t i = lower_bound(start);
+    for (std::size_t k = 0; k < count && i < size(); ++k) {
+      const TimePoint begin(start.relative() + period * static_cast<TYPENAME duration::rep>(k));
+      const TimePoint end(begin.relative() + period);
+      const std::size_t first = i;
+      while (i < size() && less(times_[i], end)) ++i;
+      if (i != first) {
+        ret.times_.push_back(begin);
+        ret.values_.push_back(reduce(first, i, method));
+      }
+    }
+    return ret;
+  }
+
+  /**
+   * @brief Aggregates the samples in `[from, to)`
+   */
+  [[nodiscard]] Value aggregate(const TimePoint& from, const TimePoint& to, aggregation method) const
+  {
+    const std::size_t first = lower_bound(from);
+    const std::size_t last = lower_bound(to);
+    Expects(first < last);
+    return reduce(first, last, method);
+  }
+
+private:
+  std::vector<TimePoint> times_;
+  std::vector<Value> values_;
+
+  static constexpr bool less(const TimePoint& lhs, const TimePoint& rhs) { return lhs.relative() < rhs.relative(); }
+
+  // `upper` is the index of the first sample newer than `t`
+  [[nodiscard]] Value at(std::size_t upper, const TimePoint& t, interpolation method) const
+  {
+    if (upper == 0) return values_.front();
+    if (upper == size()) return values_.back();
+    const std::size_t i = upper - 1;
+    if (method == interpolation::previous) return values_[i];
+
+    using rep = TYPENAME duration::rep;
+    const rep h = (times_[upper] - times_[i]).count();
+    const rep s = (t - times_[i]).count() / h;
+    if (method == interpolation::linear) return values_[i] + (values_[upper] - values_[i]) * s;
+
+    // tangents scaled by the length of the segment
+    const Value m0 = tangent(i) * (h / span(i));
+    const Value m1 = tangent(upper) * (h / span(upper));
+    const rep s2 = s * s;
+    const rep s3 = s2 * s;
+    return values_[i] * (2 * s3 - 3 * s2 + 1) + m0 * (s3 - 2 * s2 + s) + values_[upper] * (3 * s2 - 2 * s3) + m1 * (s3 - s2);
+  }
+
+  // the difference of values and the duration over which the tangent at `i` is computed
+  // (one-sided at the ends of the series)
+  [[nodiscard]] Value tangent(std::size_t i) const
+  {
+    return values_[std::min(i + 1, size() - 1)] - values_[i == 0 ? 0 : i - 1];
+  }
+
+  [[nodiscard]] TYPENAME duration::rep span(std::size_t i) const
+  {
+    return (times_[std::min(i + 1, size() - 1)] - times_[i == 0 ? 0 : i - 1]).count();
+  }
+
+  [[nodiscard]] Value reduce(std::size_t first, std::size_t last, aggregation method) const
+  {
+    const Value* v = values_.data();
+    Value acc = v[first];
+    switch (method) {
+      case aggregation::min:
+        for (std::size_t i = first + 1; i < last; ++i) acc = v[i] < acc ? v[i] : acc;
+        return acc;
+      case aggregation::max:
+        for (std::size_t i = first + 1; i < last; ++i) acc = acc < v[i] ? v[i] : acc;
+        return acc;
+      case aggregation::sum:
+      case aggregation::mean:
+        for (std::size_t i = first + 1; i < last; ++i) acc += v[i];
+        return method == aggregation::sum ? acc : acc / static_cast<TYPENAME Value::rep>(last - first);
+    }
+    return acc;
+  }
+};
+
+}  // namespace units
@@ -0,0 +1,208 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/clock.h>
+#include <units/concepts.h>
+#include <units/quantity_cast.h>
+#include <gsl/gsl_assert>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+
+namespace units {
+
+namespace detail {
+
+// the amount of tokens added during a time by a rate (in floating-point)
+template<Quantity Rate>
+using token_rate_product =
+    decltype(quantity<typename Rate::dimension, typename Rate::unit, double>() * physical::si::time<physical::si::second, double>());
+
+// `ceil(a * b / 2^32)` for a result that fits 64 bits
+[[nodiscard]] constexpr std::uint64_t mul_shr32_ceil(std::uint64_t a, std::uint64_t b) noexcept
+{
+#ifdef __SIZEOF_INT128__
+  __extension__ using u128 = unsigned __int128;
+  return static_cast<std::uint64_t>((static_cast<u128>(a) * b + 0xffff'ffffu) >> 32);
+#else
+  // the partial products of 32-bit halves (the bits lost by wrapping are all above the result)
+  constexpr std::uint64_t low = 0xffff'ffffu;
+  const std::uint64_t lo = (a & low) * (b & low);
+  return ((a >> 32) * (b >> 32) << 32) + (a >> 32) * (b & low) + (a & low) * (b >> 32) + (lo >> 32) + ((lo & low) != 0);
+#endif
+}
+
+// `floor(a * 2^32 / b)` for `0 < b < 2^63` and a result that fits 64 bits
+[[nodiscard]] constexpr std::uint64_t shl32_div(std::uint64_t a, std::uint64_t b) noexcept
+{
+#ifdef __SIZEOF_INT128__
+  __extension__ using u128 = unsigned __int128;
+  return static_cast<std::uint64_t>((static_cast<u128>(a) << 32) / b);
+#else
+  // long division of the lower 32 bits of the dividend one bit at a time
+  std::uint64_t q = a / b;
+  std::uint64_t r = a % b;
+  for (int i = 0; i < 32; ++i) {
+    q <<= 1;
+    r <<= 1;
+    if (r >= b) {
+      r -= b;
+      ++q;
+    }
+  }
+  return q;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @brief A lock-free token bucket rate limiter
+ *
+ * Tokens are amounts of `Amount` (i.e. `data::information<data::byte, std::int64_t>` for
+ * bytes or `dimensionless<one, std::int64_t>` for requests) refilled at a rate of any quantity
+ * of dimension `Amount` per time (i.e. `data::bitrate` or `si::frequency`) up to a capacity.
+ *
+ * The bucket is implemented as the virtual scheduling algorithm (GCRA): the whole state is the
+ * theoretical arrival time of the next token in nanoseconds of `Clock`. Acquiring tokens is one
+ * read of the clock, integer arithmetic, and a single compare-and-swap unless other threads
+ * modify the bucket at the same time. The time cost of an acquisition is rounded up to whole
+ * nanoseconds so the limit is never exceeded.
+ *
+ * @tparam Amount a quantity of tokens with an integral representation
+ * @tparam Clock a clock of the library
+ */
+template<Quantity Amount, typename Clock = clock::fast>
+  requires std::integral<typename Amount::rep>
+class token_bucket {
+public:
+  using amount_type = Amount;
+  using duration = clock::duration;
+
+  /**
+   * @brief Makes a full bucket
+   *
+   * @param rate the amount of tokens added per unit of time
+   * @param capacity the maximum amount of tokens in the bucket
+   */
+  template<Quantity Rate, QuantityOf<typename Amount::dimension> Capacity>
+    requires QuantityOf<detail::token_rate_product<Rate>, typename Amount::dimension>
+  token_bucket(const Rate& rate, const Capacity& capacity) :
+      interval_(interval(rate)), capacity_(quantity_cast<Amount>(capacity)), tau_(cost(capacity_.count())),
+      tat_(now())
+  {
+    Expects(capacity_ > Amount::zero());
+  }
+
+  token_bucket(const token_bucket&) = delete;
+  token_bucket& operator=(const token_bucket&) = delete;
+
+  [[nodiscard]] Amount capacity() const noexcept { return capacity_; }
+
+  /**
+   * @brief Takes `n` tokens from the bucket if there are enough of them
+   *
+   * @return `true` if the tokens were taken
+   */
+  [[nodiscard]] bool try_acquire(const Amount& n) noexcept
+  {
+    Expects(n >= Amount::zero());
+    // never succeeds and the cost of a larger amount may not fit the timestamps
+    if (n > capacity_) return false;
+    const std::int64_t t = now();
+    const std::int64_t c = cost(n.count());
+    std::int64_t tat = tat_.load(std::memory_order_relaxed);
+    for (;;) {
+      const std::int64_t next = (tat > t ? tat : t) + c;
+      if (next - t > tau_) return false;
+      if (tat_.compare_exchange_weak(tat, next, std::memory_order_relaxed)) return true;
+    }
+  }
+
+  template<QuantityOf<typename Amount::dimension> Q>
+  [[nodiscard]] bool try_acquire(const Q& n) noexcept
+  {
+    return try_acquire(quantity_cast<Amount>(n));
+  }
+
+  /**
+   * @brief The time after which `try_acquire(n)` would succeed if no other tokens are taken
+   *
+   * Is zero if the tokens are available now and `duration::max()` if `n` exceeds the capacity.
+   */
+  [[nodiscard]] duration wait_time(const Amount& n) const noexcept
+  {
+    Expects(n >= Amount::zero());
+    if (n > capacity_) return duration::max();
+    const std::int64_t t = now();
+    const std::int64_t tat = tat_.load(std::memory_order_relaxed);
+    const std::int64_t wait = (tat > t ? tat : t) + cost(n.count()) - t - tau_;
+    return duration(wait > 0 ? wait : 0);
+  }
+
+  /**
+   * @brief The amount of tokens in the bucket (rounded down)
+   */
+  [[nodiscard]] Amount available() const noexcept
+  {
+    const std::int64_t t = now();
+    const std::int64_t tat = tat_.load(std::memory_order_relaxed);
+    const std::int64_t left = tau_ - (tat > t ? tat - t : 0);
+    if (left <= 0) return Amount::zero();
+    const auto tokens =
+        static_cast<typename Amount::rep>(detail::shl32_div(static_cast<std::uint64_t>(left), static_cast<std::uint64_t>(interval_)));
+    return Amount(tokens < capacity_.count() ? tokens : capacity_.count());
+  }
+
+private:
+  std::int64_t interval_;  // nanoseconds per token in 32.32 fixed point
+  Amount capacity_;
+  std::int64_t tau_;
+  std::atomic<std::int64_t> tat_;
+
+  [[nodiscard]] static std::int64_t now() noexcept { return Clock::now().relative().count(); }
+
+  template<Quantity Rate>
+  [[nodiscard]] static std::int64_t interval(const Rate& rate)
+  {
+    using per_second = quantity<typename Amount::dimension, typename Amount::unit, double>;
+    const quantity<typename Rate::dimension, typename Rate::unit, double> r(static_cast<double>(rate.count()));
+    const detail::token_rate_product<Rate> product = r * physical::si::time<physical::si::second, double>(1.);
+    const double tokens = product.count() * detail::quantity_scale<detail::token_rate_product<Rate>, per_second>;
+    Expects(tokens > 0);
+    const double ns = std::ceil(1e9 * 4294967296.0 / tokens);
+    Expects(ns < 9.2e18);
+    return static_cast<std::int64_t>(ns);
+  }
+
+  // the time cost of `n` tokens in nanoseconds rounded up
+  [[nodiscard]] std::int64_t cost(typename Amount::rep n) const noexcept
+  {
+    return static_cast<std::int64_t>(detail::mul_shr32_ceil(static_cast<std::uint64_t>(n), static_cast<std::uint64_t>(interval_)));
+  }
+};
+
+}  // namespace units
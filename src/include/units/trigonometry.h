@@ -0,0 +1,267 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <units/bits/fast_trig.h>
+#include <units/bits/pow.h>
+#include <units/concepts.h>
+#include <units/generic/angle.h>
+#include <units/generic/dimensionless.h>
+#include <units/quantity.h>
+#include <units/quantity_cast.h>
+#include <gsl/gsl_assert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+namespace units {
+
+namespace detail {
+
+/**
+ * @brief The factor converting a value of an angle in unit `U` to radians
+ *
+ * Computed at compile time in `long double` so that a conversion from i.e. degrees costs
+ * a single multiplication with a correctly rounded constant.
+ */
+template<typename U, typename T>
+inline constexpr T radian_factor = [] {
+  constexpr ratio r = U::ratio / radian::ratio;
+  return static_cast<T>(static_cast<long double>(r.num) / static_cast<long double>(r.den) * fpow10<long double>(r.exp));
+}();
+
+template<typename T, typename U, typename Rep>
+[[nodiscard]] constexpr T to_radians(const quantity<dim_angle<>, U, Rep>& q) noexcept
+{
+  if constexpr (U::ratio == radian::ratio)
+    return static_cast<T>(q.count());
+  else
+    return static_cast<T>(q.count()) * radian_factor<U, T>;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Computes the sine of an angle
+ *
+ * Angles in any unit (i.e. degrees) are accepted. The conversion to radians is a single
+ * multiplication by a compile-time constant.
+ *
+ * @param q Angle being the base of the operation
+ * @return Dimensionless The sine of the provided angle
+ */
+template<typename U, typename Rep>
+[[nodiscard]] inline Dimensionless auto sin(const quantity<dim_angle<>, U, Rep>& q) noexcept
+  requires requires { std::sin(q.count()); }
+{
+  using rep = decltype(std::sin(q.count()));
+  return dimensionless<one, rep>(std::sin(detail::to_radians<rep>(q)));
+}
+
+/**
+ * @brief Computes the cosine of an angle
+ *
+ * @param q Angle being the base of the operation
+ * @return Dimensionless The cosine of the provided angle
+ */
+template<typename U, typename Rep>
+[[nodiscard]] inline Dimensionless auto cos(const quantity<dim_angle<>, U, Rep>& q) noexcept
+  requires requires { std::cos(q.count()); }
+{
+  using rep = decltype(std::cos(q.count()));
+  return dimensionless<one, rep>(std::cos(detail::to_radians<rep>(q)));
+}
+
+/**
+ * @brief Computes the tangent of an angle
+ *
+ * @param q Angle being the base of the operation
+ * @return Dimensionless The tangent of the provided angle
+ */
+template<typename U, typename Rep>
+[[nodiscard]] inline Dimensionless auto tan(const quantity<dim_angle<>, U, Rep>& q) noexcept
+  requires requires { std::tan(q.count()); }
+{
+  using rep = decltype(std::tan(q.count()));
+  return dimensionless<one, rep>(std::tan(detail::to_radians<rep>(q)));
+}
+
+/**
+ * @brief Computes the arc sine of a dimensionless quantity
+ *
+ * @param q Dimensionless quantity being the base of the operation
+ * @return Angle The principal value of the arc sine in radians
+ */
+template<typename U, typename Rep>
+[[nodiscard]] inline Angle auto asin(const quantity<dim_one, U, Rep>& q) noexcept
+  requires requires { std::asin(quantity_cast<one>(q).count()); }
+{
+  using rep = decltype(std::asin(quantity_cast<one>(q).count()));
+  return angle<radian, rep>(std::asin(quantity_cast<one>(q).count()));
+}
+
+/**
+ * @brief Computes the arc cosine of a dimensionless quantity
+ *
+ * @param q Dimensionless quantity being the base of the operation
+ * @return Angle The principal value of the arc cosine in radians
+ */
+template<typename U, typename Rep>
+[[nodiscard]] inline Angle auto acos(const quantity<dim_one, U, Rep>& q) noexcept
+  requires requires { std::acos(quantity_cast<one>(q).count()); }
+{
+  using rep = decltype(std::acos(quantity_cast<one>(q).count()));
+  return angle<radian, rep>(std::acos(quantity_cast<one>(q).count()));
+}
+
+/**
+ * @brief Computes the arc tangent of a dimensionless quantity
+ *
+ * @param q Dimensionless quantity being the base of the operation
+ * @return Angle The principal value of the arc tangent in radians
+ */
+template<typename U, typename Rep>
+[[nodiscard]] inline Angle auto atan(const quantity<dim_one, U, Rep>& q) noexcept
+  requires requires { std::atan(quantity_cast<one>(q).count()); }
+{
+  using rep = decltype(std::atan(quantity_cast<one>(q).count()));
+  return angle<radian, rep>(std::atan(quantity_cast<one>(q).count()));
+}
+
+/**
+ * @brief Computes the arc tangent of y/x using the signs of arguments to determine the correct quadrant
+ *
+ * Both arguments have to be of equivalent dimensions (i.e. two lengths).
+ *
+ * @return Angle The angle in radians in the range [-pi, pi]
+ */
+template<Quantity Q1, Quantity Q2>
+[[nodiscard]] inline Angle auto atan2(const Q1& y, const Q2& x) noexcept
+  requires requires { typename common_quantity<Q1, Q2>; } &&
+           requires(typename common_quantity<Q1, Q2>::rep v) { std::atan2(v, v); }
+{
+  using type = common_quantity<Q1, Q2>;
+  using rep = decltype(std::atan2(type(y).count(), type(x).count()));
+  return angle<radian, rep>(std::atan2(type(y).count(), type(x).count()));
+}
+
+/**
+ * @brief Computes the sine of every angle in the input range
+ *
+ * The loop runs over contiguous storage with the unit conversion hoisted out of it so it
+ * can be vectorized by the compiler (provided that it has a vectorized `std::sin`).
+ *
+ * @param in Angles being the base of the operation
+ * @param out Dimensionless results (has to be of the same size as `in`)
+ */
+template<typename QIn, std::size_t InExtent, Quantity QOut, std::size_t OutExtent>
+  requires Angle<std::remove_const_t<QIn>> && std::same_as<typename QOut::unit, one>
+inline void sin(std::span<QIn, InExtent> in, std::span<QOut, OutExtent> out) noexcept
+{
+  Expects(in.size() == out.size());
+  using rep = TYPENAME QOut::rep;
+  for (std::size_t i = 0; i < in.size(); ++i)
+    out[i] = QOut(static_cast<rep>(std::sin(detail::to_radians<rep>(in[i]))));
+}
+
+/**
+ * @brief Computes the cosine of every angle in the input range
+ *
+ * @param in Angles being the base of the operation
+ * @param out Dimensionless results (has to be of the same size as `in`)
+ */
+template<typename QIn, std::size_t InExtent, Quantity QOut, std::size_t OutExtent>
+  requires Angle<std::remove_const_t<QIn>> && std::same_as<typename QOut::unit, one>
+inline void cos(std::span<QIn, InExtent> in, std::span<QOut, OutExtent> out) noexcept
+{
+  Expects(in.size() == out.size());
+  using rep = TYPENAME QOut::rep;
+  for (std::size_t i = 0; i < in.size(); ++i)
+    out[i] = QOut(static_cast<rep>(std::cos(detail::to_radians<rep>(in[i]))));
+}
+
+/**
+ * @brief Fast approximations of trigonometric functions
+ *
+ * The functions in this namespace are opt-in replacements for the ones above intended for
+ * real-time loops. They are branch-free polynomial approximations that do not call into
+ * <cmath>, are usable in constant expressions, and vectorize when applied over contiguous
+ * storage. Only floating-point representation types are supported.
+ *
+ * Error bounds (absolute, for `double`; `float` is additionally limited by its own precision):
+ * - `sin`, `cos`: <= 1e-9 for angles in the range [-1e6 rad, 1e6 rad]
+ * - `atan2`: <= 2e-8 rad
+ *
+ * Non-finite arguments and angles outside of the above range are not supported.
+ */
+namespace fast {
+
+template<typename U, std::floating_point Rep>
+[[nodiscard]] constexpr Dimensionless auto sin(const quantity<dim_angle<>, U, Rep>& q) noexcept
+{
+  return dimensionless<one, Rep>(detail::fast::sin(detail::to_radians<Rep>(q)));
+}
+
+template<typename U, std::floating_point Rep>
+[[nodiscard]] constexpr Dimensionless auto cos(const quantity<dim_angle<>, U, Rep>& q) noexcept
+{
+  return dimensionless<one, Rep>(detail::fast::cos(detail::to_radians<Rep>(q)));
+}
+
+template<Quantity Q1, Quantity Q2>
+  requires requires { typename common_quantity<Q1, Q2>; } &&
+           std::floating_point<typename common_quantity<Q1, Q2>::rep>
+[[nodiscard]] constexpr Angle auto atan2(const Q1& y, const Q2& x) noexcept
+{
+  using type = common_quantity<Q1, Q2>;
+  using rep = TYPENAME type::rep;
+  return angle<radian, rep>(detail::fast::atan2(type(y).count(), type(x).count()));
+}
+
+template<typename QIn, std::size_t InExtent, Quantity QOut, std::size_t OutExtent>
+  requires Angle<std::remove_const_t<QIn>> && std::same_as<typename QOut::unit, one> &&
+           std::floating_point<typename QOut::rep>
+constexpr void sin(std::span<QIn, InExtent> in, std::span<QOut, OutExtent> out) noexcept
+{
+  Expects(in.size() == out.size());
+  using rep = TYPENAME QOut::rep;
+  for (std::size_t i = 0; i < in.size(); ++i)
+    out[i] = QOut(detail::fast::sin(detail::to_radians<rep>(in[i])));
+}
+
+template<typename QIn, std::size_t InExtent, Quantity QOut, std::size_t OutExtent>
+  requires Angle<std::remove_const_t<QIn>> && std::same_as<typename QOut::unit, one> &&
+           std::floating_point<typename QOut::rep>
+constexpr void cos(std::span<QIn, InExtent> in, std::span<QOut, OutExtent> out) noexcept
+{
+  Expects(in.size() == out.size());
+  using rep = TYPENAME QOut::rep;
+  for (std::size_t i = 0; i < in.size(); ++i)
+    out[i] = QOut(detail::fast::cos(detail::to_radians<rep>(in[i])));
+}
+
+}  // namespace fast
+
+}  // namespace units
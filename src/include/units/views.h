@@ -0,0 +1,171 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <units/quantity.h>
+#include <units/quantity_cast.h>
+#include <units/quantity_span.h>
+#include <concepts>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+// Lazy range adaptors for quantities
+//
+//   auto km = readings | views::as_quantity<si::length<si::metre>> | views::quantity_cast<si::kilometre>;
+//
+// `views::as_quantity` and `views::strip_units` reinterpret borrowed contiguous ranges in place
+// and return spans so the result is still contiguous. Otherwise, as well as for
+// `views::quantity_cast`, they are `std::views::transform` views which keep the range sized and
+// random access. Unit conversions multiply by a factor computed at compile time.
+
+namespace units {
+
+namespace detail {
+
+// a minimal replacement of C++23 `std::ranges::range_adaptor_closure` supporting `range | adaptor`
+template<typename Derived>
+struct range_adaptor_closure {
+  template<std::ranges::viewable_range R>
+    requires std::invocable<const Derived&, R>
+  [[nodiscard]] friend constexpr auto operator|(R&& r, const Derived& adaptor)
+  {
+    return adaptor(std::forward<R>(r));
+  }
+};
+
+// ranges that can be reinterpreted in place without dangling
+template<typename R>
+concept reinterpretable_range = std::ranges::contiguous_range<R> && std::ranges::sized_range<R> && std::ranges::borrowed_range<R>;
+
+template<typename R>
+using range_element_t = std::remove_reference_t<std::ranges::range_reference_t<R>>;
+
+template<typename To, typename From>
+struct cast_target;
+
+template<Quantity To, typename From>
+struct cast_target<To, From> {
+  using type = To;
+};
+
+template<Unit To, typename From>
+  requires UnitOf<To, typename From::dimension>
+struct cast_target<To, From> {
+  using type = quantity<typename From::dimension, To, typename From::rep>;
+};
+
+template<Quantity To>
+struct quantity_cast_view_fn : range_adaptor_closure<quantity_cast_view_fn<To>> {
+  template<std::ranges::viewable_range R>
+    requires Quantity<std::ranges::range_value_t<R>> && QuantityOf<To, typename std::ranges::range_value_t<R>::dimension>
+  [[nodiscard]] constexpr auto operator()(R&& r) const
+  {
+    using from = std::ranges::range_value_t<R>;
+    using to_rep = TYPENAME To::rep;
+    if constexpr (std::same_as<from, To>) {
+      return std::views::all(std::forward<R>(r));
+    } else if constexpr (treat_as_floating_point<to_rep>) {
+      return std::views::transform(std::forward<R>(r), [](const from& q) {
+        constexpr auto factor = quantity_scale<quantity<typename from::dimension, typename from::unit, to_rep>, To>;
+        return To(static_cast<to_rep>(q.count()) * factor);
+      });
+    } else {
+      return std::views::transform(std::forward<R>(r), [](const from& q) { return units::quantity_cast<To>(q); });
+    }
+  }
+};
+
+template<typename To>
+struct deferred_quantity_cast_view_fn : range_adaptor_closure<deferred_quantity_cast_view_fn<To>> {
+  template<std::ranges::viewable_range R>
+    requires Quantity<std::ranges::range_value_t<R>> && requires { typename cast_target<To, std::ranges::range_value_t<R>>::type; }
+  [[nodiscard]] constexpr auto operator()(R&& r) const
+  {
+    using to = TYPENAME cast_target<To, std::ranges::range_value_t<R>>::type;
+    return quantity_cast_view_fn<to>{}(std::forward<R>(r));
+  }
+};
+
+template<Quantity Q>
+struct as_quantity_view_fn : range_adaptor_closure<as_quantity_view_fn<Q>> {
+  template<std::ranges::viewable_range R>
+    requires std::is_arithmetic_v<std::ranges::range_value_t<R>> && safe_convertible<std::ranges::range_value_t<R>, typename Q::rep>
+  [[nodiscard]] constexpr auto operator()(R&& r) const
+  {
+    using rep = TYPENAME Q::rep;
+    if constexpr (reinterpretable_range<R> && std::same_as<std::remove_const_t<range_element_t<R>>, rep>) {
+      return as_quantities<Q>(std::span<range_element_t<R>>(std::ranges::data(r), std::ranges::size(r)));
+    } else {
+      return std::views::transform(std::forward<R>(r), [](const auto& v) { return Q(static_cast<rep>(v)); });
+    }
+  }
+};
+
+struct strip_units_view_fn : range_adaptor_closure<strip_units_view_fn> {
+  template<std::ranges::viewable_range R>
+    requires Quantity<std::ranges::range_value_t<R>>
+  [[nodiscard]] constexpr auto operator()(R&& r) const
+  {
+    if constexpr (reinterpretable_range<R>) {
+      return as_reps(quantity_span<range_element_t<R>>(std::ranges::data(r), std::ranges::size(r)));
+    } else {
+      return std::views::transform(std::forward<R>(r), [](const auto& q) { return q.count(); });
+    }
+  }
+};
+
+}  // namespace detail
+
+namespace views {
+
+/**
+ * @brief A view of quantities converted to `To`
+ *
+ * `To` is either a quantity type or a unit (the representation type is preserved then).
+ * Every element is converted on access with `quantity_cast` semantics.
+ */
+template<typename To>
+inline constexpr detail::deferred_quantity_cast_view_fn<To> quantity_cast{};
+
+/**
+ * @brief A view of arithmetic values as quantities of type `Q`
+ *
+ * Values are interpreted in the unit of `Q`. Borrowed contiguous ranges of `Q::rep` are
+ * reinterpreted in place (see `as_quantities()`).
+ */
+template<Quantity Q>
+inline constexpr detail::as_quantity_view_fn<Q> as_quantity{};
+
+/**
+ * @brief A view of the values of quantities expressed in their own units
+ *
+ * Borrowed contiguous ranges are reinterpreted in place (see `as_reps()`).
+ */
+inline constexpr detail::strip_units_view_fn strip_units{};
+
+}  // namespace views
+
+}  // namespace units
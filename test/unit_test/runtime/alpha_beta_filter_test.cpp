@@ -0,0 +1,105 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/alpha_beta_filter.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+using namespace units;
+using namespace units::physical;
+
+namespace {
+
+using m = si::length<si::metre>;
+using m_per_s = si::speed<si::metre_per_second>;
+using s = si::time<si::second>;
+using filter = alpha_beta_filter_batch<m, s>;
+
+static_assert(std::is_same_v<filter::rate_type::dimension, si::dim_speed>);
+
+}  // namespace
+
+TEST_CASE("alpha_beta_filter_batch tracks a single target", "[alpha_beta_filter]")
+{
+  // 1d aircraft example from https://www.kalmanfilter.net/alphabeta.html#ex2
+  filter f;
+  REQUIRE(f.add_track(m(30'000.), m_per_s(40.), 0.2, 0.1) == 0);
+  f.predict(s(5.));
+  CHECK(f.predicted_positions()[0] == m(30'200.));
+  CHECK(f.predicted_rates()[0] == m_per_s(40.));
+
+  const std::array z = {m(30'110.)};
+  f.estimate(z, s(5.));
+  CHECK(f.estimated_positions()[0] == m(30'182.));
+  CHECK(f.estimated_rates()[0] == m_per_s(38.2));
+
+  f.predict(s(5.));
+  CHECK(f.predicted_positions()[0] == m(30'373.));
+  CHECK(f.predicted_rates()[0] == m_per_s(38.2));
+}
+
+TEST_CASE("alpha_beta_filter_batch gives the same results for every batch size and thread count", "[alpha_beta_filter]")
+{
+  constexpr std::size_t n = 3 * filter::min_tracks_per_thread + 7;
+  filter single;
+  filter multi(4);
+  single.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto alpha = 0.1 + 0.5 * static_cast<double>(i % 7) / 7;
+    const auto beta = 0.05 + 0.2 * static_cast<double>(i % 5) / 5;
+    single.add_track(m(1000. * static_cast<double>(i)), m_per_s(static_cast<double>(i % 13)), alpha, beta);
+    multi.add_track(m(1000. * static_cast<double>(i)), m_per_s(static_cast<double>(i % 13)), alpha, beta);
+  }
+  REQUIRE(multi.size() == n);
+  CHECK(multi.alphas()[8] == single.alphas()[8]);
+
+  std::vector<m> z(n);
+  for (int step = 1; step <= 10; ++step) {
+    single.predict(s(2.));
+    multi.predict(s(2.));
+    for (std::size_t i = 0; i < n; ++i) z[i] = m(1000. * static_cast<double>(i) + 10. * step * static_cast<double>(i % 11));
+    single.estimate(z, s(2.));
+    multi.estimate(z, s(2.));
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    REQUIRE(multi.estimated_positions()[i] == single.estimated_positions()[i]);
+    REQUIRE(multi.estimated_rates()[i] == single.estimated_rates()[i]);
+  }
+
+  // the scalar steps for one of the tracks
+  const std::size_t i = n - 1;
+  m x(1000. * static_cast<double>(i));
+  m_per_s v(static_cast<double>(i % 13));
+  const double alpha = single.alphas()[i], beta = single.betas()[i];
+  for (int step = 1; step <= 10; ++step) {
+    const m xp = x + v * s(2.);
+    const m innovation = m(1000. * static_cast<double>(i) + 10. * step * static_cast<double>(i % 11)) - xp;
+    x = xp + alpha * innovation;
+    v = v + beta * innovation / s(2.);
+  }
+  CHECK(single.estimated_positions()[i].count() == Approx(x.count()));
+  CHECK(single.estimated_rates()[i].count() == Approx(v.count()));
+}
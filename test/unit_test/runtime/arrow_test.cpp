@@ -0,0 +1,169 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/arrow.h"
+#include "units/physical/si/si.h"
+#include "units/physical/si/us/base/length.h"
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace units;
+using namespace units::physical;
+using namespace units::physical::si;
+
+namespace {
+
+using kmph = speed<kilometre_per_hour>;
+
+struct exported_column {
+  ArrowSchema schema;
+  ArrowArray array;
+
+  template<typename Q>
+  explicit exported_column(std::vector<Q>& v)
+  {
+    export_arrow_schema<Q>(schema, "column");
+    export_arrow_array(quantity_span<Q>(v), array);
+  }
+  ~exported_column()
+  {
+    if (array.release) array.release(&array);
+    if (schema.release) schema.release(&schema);
+  }
+};
+
+}  // namespace
+
+TEST_CASE("arrow export describes the quantity type", "[arrow]")
+{
+  std::vector<kmph> v{36_q_km_per_h, 72_q_km_per_h};
+  exported_column c(v);
+
+  CHECK(std::string(c.schema.format) == "g");
+  CHECK(std::string(c.schema.name) == "column");
+  CHECK(c.array.length == 2);
+  CHECK(c.array.null_count == 0);
+  CHECK(c.array.buffers[1] == v.data());
+
+  const arrow_quantity_metadata m = read_arrow_metadata(c.schema);
+  CHECK(m.exponents == std::vector<column_header::exponent_entry>{{"L", 1, 1}, {"T", -1, 1}});
+  CHECK(m.unit_ratio / ratio(5, 18) == ratio(1));
+  CHECK(m.unit == "km/h");
+
+  c.schema.release(&c.schema);
+  CHECK(c.schema.release == nullptr);
+}
+
+TEST_CASE("arrow_quantity_span maps the Arrow buffer without copying", "[arrow]")
+{
+  std::vector<kmph> v{36_q_km_per_h, 72_q_km_per_h, 108_q_km_per_h};
+  exported_column c(v);
+
+  const auto qs = arrow_quantity_span<kmph>(c.schema, c.array);
+  CHECK(qs.data() == v.data());
+  CHECK(qs.size() == 3);
+
+  SECTION("array offset is taken into account")
+  {
+    c.array.offset = 1;
+    c.array.length = 2;
+    const auto sub = arrow_quantity_span<kmph>(c.schema, c.array);
+    CHECK(sub.data() == v.data() + 1);
+    CHECK(sub[1] == 108_q_km_per_h);
+  }
+
+  SECTION("other types are rejected")
+  {
+    REQUIRE_THROWS_AS(arrow_quantity_span<speed<metre_per_second>>(c.schema, c.array), arrow_error);
+    REQUIRE_THROWS_AS(arrow_quantity_span<length<kilometre>>(c.schema, c.array), arrow_error);
+    REQUIRE_THROWS_AS((arrow_quantity_span<speed<kilometre_per_hour, float>>(c.schema, c.array)), arrow_error);
+  }
+}
+
+TEST_CASE("arrow_quantity_cast converts directly from the Arrow buffer", "[arrow]")
+{
+  std::vector<length<metre, std::int32_t>> v{1500_q_m, -250_q_m};
+  exported_column c(v);
+
+  std::vector<length<kilometre>> out(2);
+  REQUIRE(arrow_quantity_cast(c.schema, c.array, quantity_span<length<kilometre>>(out)) == 2);
+  CHECK(out[0] == 1.5_q_km);
+  CHECK(out[1] == -0.25_q_km);
+
+  std::vector<si::time<second>> wrong(2);
+  REQUIRE_THROWS_AS(arrow_quantity_cast(c.schema, c.array, quantity_span<si::time<second>>(wrong)), arrow_error);
+  std::vector<length<kilometre>> small(1);
+  REQUIRE_THROWS_AS(arrow_quantity_cast(c.schema, c.array, quantity_span<length<kilometre>>(small)), arrow_error);
+}
+
+TEST_CASE("arrow export keeps the owner alive until released", "[arrow]")
+{
+  auto v = std::make_shared<std::vector<length<metre>>>(2);
+  std::weak_ptr<std::vector<length<metre>>> weak = v;
+  ArrowArray array;
+  export_arrow_array(quantity_span<length<metre>>(*v), array, v);
+  v.reset();
+  CHECK_FALSE(weak.expired());
+  array.release(&array);
+  CHECK(weak.expired());
+}
+
+TEST_CASE("read_arrow_metadata rejects other columns", "[arrow]")
+{
+  ArrowSchema schema{"g", "", nullptr, 0, 0, nullptr, nullptr, nullptr, nullptr};
+  REQUIRE_THROWS_AS(read_arrow_metadata(schema), arrow_error);
+
+  const std::string metadata = detail::encode_arrow_metadata(
+      {{"ARROW:extension:name", arrow_extension_name}, {"ARROW:extension:metadata", R"({"dimension":{"L":[1,1]}})"}});
+  schema.metadata = metadata.c_str();
+  REQUIRE_THROWS_AS(read_arrow_metadata(schema), arrow_error);
+}
+
+TEST_CASE("unit ratios of Arrow columns are bounds-checked", "[arrow]")
+{
+  std::vector<length<metre, std::int64_t>> v{1_q_m};
+  exported_column c(v);
+  const auto schema_with_ratio = [](std::string& metadata, const std::string& ratio) {
+    metadata = detail::encode_arrow_metadata({{"ARROW:extension:name", arrow_extension_name},
+                                              {"ARROW:extension:metadata", R"({"dimension":{"L":[1,1]},"ratio":)" + ratio + "}"}});
+    return ArrowSchema{"l", "", metadata.c_str(), 0, 0, nullptr, nullptr, nullptr, nullptr};
+  };
+  std::string huge_exp, min_num, huge_num, large_exp;
+
+  REQUIRE_THROWS_AS(read_arrow_metadata(schema_with_ratio(huge_exp, "[1,1,1099511627776]")), arrow_error);
+  REQUIRE_THROWS_AS(read_arrow_metadata(schema_with_ratio(min_num, "[-9223372036854775808,1,0]")), arrow_error);
+
+  // the ratio is valid but its quotient with the one of the target unit overflows
+  const ArrowSchema huge = schema_with_ratio(huge_num, "[9223372036854775807,1,0]");
+  using foot = length<us::foot, std::int64_t>;
+  REQUIRE_THROWS_AS(arrow_quantity_span<foot>(huge, c.array), arrow_error);
+  std::vector<foot> out(1);
+  REQUIRE_THROWS_AS(arrow_quantity_cast(huge, c.array, quantity_span<foot>(out)), arrow_error);
+
+  // the conversion factor does not fit the representation type
+  const ArrowSchema scaled = schema_with_ratio(large_exp, "[1,1,100]");
+  std::vector<length<metre, std::int64_t>> ints(1);
+  REQUIRE_THROWS_AS(arrow_quantity_cast(scaled, c.array, quantity_span<length<metre, std::int64_t>>(ints)), arrow_error);
+}
@@ -0,0 +1,102 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/clock.h"
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+using namespace units;
+using namespace units::physical;
+using namespace units::physical::si;
+
+namespace {
+
+static_assert(std::is_same_v<decltype(clock::steady::now()), quantity_point<si::dim_time, nanosecond, std::int64_t>>);
+static_assert(std::is_same_v<decltype(clock::system::now() - clock::system::now()), si::time<nanosecond, std::int64_t>>);
+static_assert(clock::steady::is_steady);
+
+template<typename Clock>
+void check_monotonic()
+{
+  auto prev = Clock::now();
+  for (int i = 0; i < 1000; ++i) {
+    const auto t = Clock::now();
+    REQUIRE(t >= prev);
+    prev = t;
+  }
+}
+
+}  // namespace
+
+TEST_CASE("steady clock", "[clock]")
+{
+  check_monotonic<clock::steady>();
+
+  const auto before = std::chrono::steady_clock::now();
+  const auto t = clock::steady::now();
+  const auto after = std::chrono::steady_clock::now();
+  CHECK(to_chrono_time_point<std::chrono::steady_clock>(t) >= before);
+  CHECK(to_chrono_time_point<std::chrono::steady_clock>(t) <= after);
+}
+
+TEST_CASE("system clock", "[clock]")
+{
+  const auto before = from_chrono_time_point<clock::time_point>(std::chrono::system_clock::now());
+  const auto t = clock::system::now();
+  const auto after = from_chrono_time_point<clock::time_point>(std::chrono::system_clock::now());
+  CHECK(t >= before);
+  CHECK(t <= after);
+}
+
+#if UNITS_HAS_TSC_CLOCK
+
+TEST_CASE("TSC clock", "[clock]")
+{
+  CHECK(clock::tsc::calibrate() > 0);
+  check_monotonic<clock::tsc>();
+
+  // the bounds are generous because the readings of both clocks may be far apart on a loaded machine
+  SECTION("shares the epoch of the steady clock")
+  {
+    const auto s0 = clock::steady::now();
+    const auto t = clock::tsc::now();
+    const auto s1 = clock::steady::now();
+    CHECK(t > s0 - 1_q_s);
+    CHECK(t < s1 + 1_q_s);
+  }
+
+  SECTION("measures the same durations as the steady clock")
+  {
+    const auto s0 = clock::steady::now();
+    const auto t0 = clock::tsc::now();
+    auto s1 = s0;
+    while (s1 - s0 < 50_q_ms) s1 = clock::steady::now();
+    const auto t1 = clock::tsc::now();
+    const double ratio = static_cast<double>((t1 - t0).count()) / static_cast<double>((s1 - s0).count());
+    CHECK(ratio > 0.5);
+    CHECK(ratio < 2.);
+  }
+}
+
+#endif
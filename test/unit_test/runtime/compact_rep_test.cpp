@@ -0,0 +1,130 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "units/compact_rep.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace units;
+using namespace units::physical::si;
+
+TEST_CASE("float16 stores IEEE binary16 values", "[compact_rep][float16]")
+{
+  SECTION("every non-NaN bit pattern survives a round trip through float") {
+    for (std::uint32_t b = 0; b <= 0xffff; ++b) {
+      const auto h = float16::from_bits(static_cast<std::uint16_t>(b));
+      const float f = h;
+      if (std::isnan(f)) continue;
+      REQUIRE(float16(f).bits() == b);
+    }
+  }
+
+  SECTION("values are rounded to nearest even") {
+    CHECK(float16(1.f).bits() == 0x3c00);
+    CHECK(float16(-2.f).bits() == 0xc000);
+    CHECK(float16(65504.f).bits() == 0x7bff);
+    CHECK(float16(1.f + 0x1p-11f).bits() == 0x3c00);                // tie, rounds to even
+    CHECK(float16(1.f + 0x1p-11f + 0x1p-20f).bits() == 0x3c01);
+    CHECK(float16(1.f + 3 * 0x1p-11f).bits() == 0x3c02);              // tie, rounds to even
+    CHECK(float16(0x1p-24f).bits() == 0x0001);                        // smallest subnormal
+    CHECK(float16(0x1p-25f).bits() == 0x0000);                        // tie, rounds to even
+    CHECK(float16(0x1.8p-25f).bits() == 0x0001);
+    CHECK(float16(0x1.ff8p-15f).bits() == 0x03ff);                    // largest subnormal
+  }
+
+  SECTION("out of range values become infinities and NaN stays NaN") {
+    CHECK(float16(65520.f).bits() == 0x7c00);
+    CHECK(float16(-1e10).bits() == 0xfc00);
+    CHECK(float16(std::numeric_limits<float>::infinity()).bits() == 0x7c00);
+    CHECK(std::isnan(float(float16(std::numeric_limits<float>::quiet_NaN()))));
+  }
+
+  SECTION("arithmetic widens to float") {
+    const float16 a = 1.5, b = 0.25;
+    CHECK(a + b == 1.75f);
+    CHECK(a * b == 0.375f);
+  }
+}
+
+TEST_CASE("bfloat16 stores the upper half of a float", "[compact_rep][bfloat16]")
+{
+  CHECK(bfloat16(1.f).bits() == 0x3f80);
+  CHECK(bfloat16(-2.f).bits() == 0xc000);
+  CHECK(bfloat16(1.f + 0x1p-8f).bits() == 0x3f80);                   // tie, rounds to even
+  CHECK(bfloat16(1.f + 3 * 0x1p-8f).bits() == 0x3f82);               // tie, rounds to even
+  CHECK(float(bfloat16(3.0e38f)) == Approx(3.0e38f).epsilon(1e-2));
+  CHECK(std::isnan(float(bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+  CHECK(std::isinf(float(bfloat16(std::numeric_limits<float>::infinity()))));
+}
+
+TEST_CASE("scaled_int16 counts steps of its scale", "[compact_rep][scaled_int16]")
+{
+  using centi = scaled_int16<ratio(1, 100)>;
+
+  CHECK(centi(1.234).raw() == 123);
+  CHECK(centi(-1.235).raw() == -124);
+  CHECK(double(centi(2.5)) == Approx(2.5));
+  CHECK(centi(1000.).raw() == 32767);
+  CHECK(centi(-1000.).raw() == -32768);
+  CHECK(centi(std::numeric_limits<double>::quiet_NaN()).raw() == 0);
+  CHECK(scaled_int16<ratio(5, 1, 1)>(1234.).raw() == 25);
+}
+
+TEST_CASE("quantities with compact representations", "[compact_rep]")
+{
+  SECTION("use a quarter of the storage") {
+    STATIC_REQUIRE(sizeof(length<metre, float16>) == 2);
+    STATIC_REQUIRE(sizeof(length<metre, bfloat16>) == 2);
+    STATIC_REQUIRE(sizeof(length<metre, scaled_int16<ratio(1, 1000)>>) == 2);
+  }
+
+  SECTION("compute in the wide type") {
+    const length<metre, float16> d(float16(3.));
+    const physical::si::time<second, float16> t(float16(2.));
+    const auto v = d / t;
+    CHECK(v.count() == 1.5f);
+    CHECK((d + length<metre>(1.)).count() == 4.);
+  }
+
+  SECTION("bulk pack and unpack") {
+    const std::array<length<metre>, 5> in{length<metre>(0.), length<metre>(1.), length<metre>(-2.5),
+                                          length<metre>(0.1), length<metre>(1e-6)};
+    std::array<length<millimetre, scaled_int16<ratio(1, 10)>>, 5> packed_mm;
+    std::array<length<metre, float16>, 5> packed_h;
+    std::array<length<metre>, 5> out;
+
+    pack(quantity_span<const length<metre>>(in), quantity_span<length<millimetre, scaled_int16<ratio(1, 10)>>>(packed_mm));
+    CHECK(packed_mm[2].count().raw() == -25000);
+    unpack(quantity_span<const length<millimetre, scaled_int16<ratio(1, 10)>>>(packed_mm), quantity_span<length<metre>>(out));
+    for (std::size_t i = 0; i < in.size(); ++i)
+      CHECK(out[i].count() == Approx(in[i].count()).margin(0.5e-4));
+
+    pack(std::span(in), std::span(packed_h));
+    unpack(std::span(packed_h), std::span(out));
+    for (std::size_t i = 0; i < in.size(); ++i)
+      CHECK(out[i].count() == Approx(in[i].count()).epsilon(0x1p-11).margin(0x1p-25));
+  }
+}
@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/csv.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+using namespace units;
+using namespace units::physical::si;
+
+namespace {
+
+using speed_column = csv_column<speed<metre_per_second>, kilometre_per_hour>;
+using length_column = csv_column<length<metre, std::int64_t>, kilometre>;
+
+std::string make_input(int rows, char delimiter)
+{
+  std::string txt = std::string("time[s]") + delimiter + "note" + delimiter + "speed [km/h]\n";
+  for (int i = 0; i < rows; ++i) {
+    txt += std::to_string(i) + delimiter + "x" + delimiter + std::to_string(i * 36) + ".0";
+    txt += i % 2 ? "\r\n" : "\n";
+  }
+  return txt;
+}
+
+}  // namespace
+
+TEST_CASE("csv columns are converted from the units of the header", "[csv]")
+{
+  std::istringstream in("time[s],speed[km/h],distance[km]\n1.5,72,2\n\n+2.5, 36 ,-3\n");
+  csv_reader<physical::si::time<second>, speed_column, length_column> reader(in, {"time", "speed", "distance"});
+
+  REQUIRE(reader.next());
+  REQUIRE(reader.size() == 2);
+  CHECK(reader.column<0>()[0].count() == 1.5);
+  CHECK(reader.column<0>()[1].count() == 2.5);
+  CHECK(reader.column<1>()[0].count() == Approx(20.));
+  CHECK(reader.column<1>()[1].count() == Approx(10.));
+  CHECK(reader.column<2>()[0].count() == 2000);
+  CHECK(reader.column<2>()[1].count() == -3000);
+  CHECK_FALSE(reader.next());
+}
+
+TEST_CASE("csv fields without a unit annotation use the unit of the column", "[csv]")
+{
+  std::istringstream in("\"distance\",other\n5,7\n");
+  csv_reader<length_column> reader(in, {"distance"});
+  REQUIRE(reader.next());
+  CHECK(reader.column<0>()[0].count() == 5);
+}
+
+TEST_CASE("csv input is read in chunks of bounded size", "[csv]")
+{
+  const int rows = 10'000;
+  for (const char delimiter : {',', '\t'}) {
+    for (const unsigned threads : {1u, 3u}) {
+      std::istringstream in(make_input(rows, delimiter));
+      csv_reader<speed_column, physical::si::time<second, int>> reader(in, {"speed", "time"}, {delimiter, 1000, threads});
+
+      int expected = 0;
+      std::size_t chunks = 0;
+      while (reader.next()) {
+        ++chunks;
+        CHECK(reader.size() < 100);
+        for (std::size_t i = 0; i < reader.size(); ++i, ++expected) {
+          REQUIRE(reader.column<1>()[i].count() == expected);
+          REQUIRE(reader.column<0>()[i].count() == Approx(expected * 10.));
+        }
+      }
+      CHECK(expected == rows);
+      CHECK(chunks > 100);
+    }
+  }
+}
+
+TEST_CASE("csv lines longer than the chunk are read", "[csv]")
+{
+  std::istringstream in("a,b\n" + std::string(100, ' ') + "1," + std::string(100, ' ') + "2");
+  csv_reader<length<metre, int>, length<metre, int>> reader(in, {"b", "a"}, {',', 16});
+  REQUIRE(reader.next());
+  CHECK(reader.column<0>()[0].count() == 2);
+  CHECK(reader.column<1>()[0].count() == 1);
+}
+
+TEST_CASE("csv errors are reported", "[csv]")
+{
+  using reader = csv_reader<speed_column>;
+
+  SECTION("missing column") {
+    std::istringstream in("time[s]\n1\n");
+    CHECK_THROWS_WITH(reader(in, {"speed"}), "csv: column 'speed' not found");
+  }
+
+  SECTION("unsupported unit") {
+    std::istringstream in("speed[m]\n1\n");
+    CHECK_THROWS_WITH(reader(in, {"speed"}), "csv: unsupported unit 'm' of column 'speed'");
+  }
+
+  SECTION("invalid value") {
+    for (const unsigned threads : {1u, 2u}) {
+      std::istringstream in("speed[m/s],x\n1,2\n2,3\n3x,4\n");
+      reader r(in, {"speed"}, {',', 1024, threads});
+      CHECK_THROWS_WITH(r.next(), "csv: invalid value of column 'speed' at line 4");
+    }
+  }
+
+  SECTION("missing value") {
+    std::istringstream in("x,speed\n1,2\n1\n");
+    reader r(in, {"speed"});
+    CHECK_THROWS_WITH(r.next(), "csv: missing value of column 'speed' at line 3");
+  }
+}
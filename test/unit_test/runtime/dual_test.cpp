@@ -0,0 +1,138 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/dual.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <sstream>
+
+using namespace units;
+using namespace units::physical;
+
+namespace {
+
+using D = dual<double>;
+using D3 = dual<double, 3>;
+
+static_assert(ScalableNumber<D>);
+static_assert(ScalableNumber<D3>);
+static_assert(treat_as_floating_point<D3>);
+
+// constant evaluation
+static_assert(pow<3>(D::variable(2., 0)) == D(8., {12.}));
+static_assert((D::variable(2., 0) * D::variable(2., 0) + 3. * D::variable(2., 0)).partial(0) == 7.);
+
+void check(const D& actual, double value, double derivative)
+{
+  CHECK(actual.value() == Approx(value));
+  CHECK(actual.partial(0) == Approx(derivative).margin(1e-12));
+}
+
+}  // namespace
+
+TEST_CASE("dual arithmetic computes derivatives", "[dual]")
+{
+  const D x = D::variable(2., 0);
+  check(x + 1., 3., 1.);
+  check(1. - x, -1., -1.);
+  check(x * x * x, 8., 12.);
+  check(x / (x + 1.), 2. / 3, 1. / 9);
+  check(1. / x, 0.5, -0.25);
+  check(x / 4., 0.5, 0.25);
+  check(-x, -2., -1.);
+
+  D acc = x;
+  acc *= x;
+  acc -= D(1.);
+  check(acc, 3., 4.);
+}
+
+TEST_CASE("dual functions apply the chain rule", "[dual]")
+{
+  const D x = D::variable(0.5, 0);
+  check(pow<2>(x), 0.25, 1.);
+  check(pow<-2>(x), 4., -16.);
+  check(sqrt(x), std::sqrt(0.5), 0.5 / std::sqrt(0.5));
+  check(cbrt(x), std::cbrt(0.5), 1. / (3. * std::cbrt(0.25)));
+  check(exp(x), std::exp(0.5), std::exp(0.5));
+  check(log(x), std::log(0.5), 2.);
+  check(sin(x), std::sin(0.5), std::cos(0.5));
+  check(cos(x), std::cos(0.5), -std::sin(0.5));
+  check(tan(x), std::tan(0.5), 1. / (std::cos(0.5) * std::cos(0.5)));
+  check(asin(x), std::asin(0.5), 1. / std::sqrt(0.75));
+  check(acos(x), std::acos(0.5), -1. / std::sqrt(0.75));
+  check(atan(x), std::atan(0.5), 0.8);
+  check(abs(-x), 0.5, 1.);
+  check(atan2(x, D(1.)), std::atan2(0.5, 1.), 0.8);
+  check(atan2(D(1.), x), std::atan2(1., 0.5), -0.8);
+}
+
+TEST_CASE("vector dual computes all the partials in one pass", "[dual]")
+{
+  const D3 x = D3::variable(1., 0);
+  const D3 y = D3::variable(2., 1);
+  const D3 z = D3::variable(3., 2);
+  const D3 f = x * y * z + sin(x);
+  CHECK(f.value() == Approx(6. + std::sin(1.)));
+  CHECK(f.partial(0) == Approx(6. + std::cos(1.)));
+  CHECK(f.partial(1) == Approx(3.));
+  CHECK(f.partial(2) == Approx(2.));
+
+  std::ostringstream os;
+  os << x * 2.;
+  CHECK(os.str() == "2 [2, 0, 0]");
+}
+
+TEST_CASE("derivatives of quantities have proper dimensions", "[dual]")
+{
+  // elastic potential energy: dE/dx is the force
+  const auto x = make_dual<0>(si::length<si::metre>(0.2));
+  const auto k = si::force<si::newton>(300.) / si::length<si::metre>(1.);
+  const auto e = k * pow<2>(x) / 2;
+  static_assert(std::is_same_v<decltype(derivative(e, x)), si::force<si::newton>>);
+  CHECK(primal(e).count() == Approx(6.));
+  CHECK(derivative(e, x) == si::force<si::newton>(60.));
+
+  // the unit of the variable is taken into account
+  const auto x_km = make_dual<0>(si::length<si::kilometre>(0.0002));
+  const auto e_km = k * x_km * x_km / 2;
+  CHECK(quantity_cast<si::force<si::newton>>(derivative(e_km, x_km)).count() == Approx(60.));
+
+  // kinetic energy: the gradient with respect to mass and speed
+  const auto m = make_dual<0, 2>(si::mass<si::kilogram>(4.));
+  const auto v = make_dual<1, 2>(si::speed<si::metre_per_second>(3.));
+  const auto ek = m * v * v / 2;
+  CHECK(primal(ek) == si::energy<si::joule>(18.));
+  CHECK(derivative<0>(ek, m) == si::speed<si::metre_per_second>(3.) * si::speed<si::metre_per_second>(3.) / 2);
+  CHECK(derivative<1>(ek, v) == si::mass<si::kilogram>(4.) * si::speed<si::metre_per_second>(3.));
+
+  // math functions
+  const auto a = make_dual<0>(angle<degree>(60.));
+  const auto s = sin(a);
+  CHECK(primal(s).count() == Approx(std::sqrt(3.) / 2));
+  CHECK(derivative(s, a).count() == Approx(0.5 * std::acos(-1.) / 180.));
+
+  const auto r = sqrt(pow<2>(x) + pow<2>(make_dual<0>(si::length<si::metre>(0.))));
+  CHECK(primal(r) == si::length<si::metre>(0.2));
+  CHECK(derivative(r, x).count() == Approx(1.));
+}
@@ -0,0 +1,108 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/engineering.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <limits>
+#include <sstream>
+
+using namespace units;
+using namespace units::physical::si;
+
+TEST_CASE("to_engineering picks the prefix bringing the value into [1, 1000)", "[engineering]")
+{
+  SECTION("smaller prefix")
+  {
+    const auto e = to_engineering(0.00123_q_V);
+    CHECK(e.value == Approx(1.23));
+    CHECK(e.exponent == -3);
+    CHECK(e.prefix.standard == "m");
+    CHECK(e.symbol.standard == "V");
+  }
+
+  SECTION("larger prefix of a prefixed unit")
+  {
+    const auto e = to_engineering(12345_q_mV);
+    CHECK(e.value == Approx(12.345));
+    CHECK(e.exponent == 0);
+    CHECK(e.prefix.standard.empty());
+  }
+
+  SECTION("exact powers of 1000")
+  {
+    CHECK(to_engineering(1000._q_Hz).prefix.standard == "k");
+    CHECK(to_engineering(1000._q_Hz).value == 1.);
+    CHECK(to_engineering(0.001_q_m).prefix.standard == "m");
+    CHECK(to_engineering(0.001_q_m).value == Approx(1.));
+  }
+
+  SECTION("negative values")
+  {
+    const auto e = to_engineering(-4700._q_R);
+    CHECK(e.value == Approx(-4.7));
+    CHECK(e.prefix.standard == "k");
+    CHECK(e.symbol.standard == "Ω");
+    CHECK(e.symbol.ascii == "ohm");
+  }
+
+  SECTION("unit with a prefixed reference")
+  {
+    CHECK(to_engineering(0.0005_q_kg).prefix.standard == "m");
+    CHECK(to_engineering(0.0005_q_kg).symbol.standard == "g");
+    CHECK(to_engineering(0.0005_q_kg).value == Approx(500.));
+  }
+
+  SECTION("Unicode prefix")
+  {
+    const auto e = to_engineering(12.5_q_us);
+    CHECK(e.prefix.standard == "µ");
+    CHECK(e.prefix.ascii == "u");
+  }
+
+  SECTION("out of the range of prefixes")
+  {
+    CHECK(to_engineering(1e30_q_m).prefix.standard == "Y");
+    CHECK(to_engineering(1e30_q_m).value == Approx(1e6));
+    CHECK(to_engineering(1e-30_q_m).prefix.standard == "y");
+  }
+
+  SECTION("zero and non-finite values are not rescaled")
+  {
+    CHECK(to_engineering(0._q_km).exponent == 0);
+    CHECK(to_engineering(length<kilometre>(std::numeric_limits<double>::infinity())).exponent == 0);
+  }
+
+  SECTION("units that are not decimal multiples of a prefixable unit are not rescaled")
+  {
+    CHECK(to_engineering(2._q_h).value == 2.);
+    CHECK(to_engineering(2._q_h).symbol.standard == "h");
+    CHECK(to_engineering(2000._q_m_per_s).symbol.standard == "m/s");
+  }
+}
+
+TEST_CASE("engineering_quantity stream output", "[engineering]")
+{
+  std::ostringstream os;
+  os << to_engineering(4.7e-9_q_F);
+  CHECK(os.str() == "4.7 nF");
+}
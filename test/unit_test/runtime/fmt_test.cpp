@@ -846,6 +846,34 @@ TEST_CASE("format string with only %q should print quantity unit symbol only", "
   }
 }
 
+TEST_CASE("%aq rescales the value and the unit to an engineering prefix", "[text][fmt]")
+{
+  SECTION("prefix smaller than the one of the unit")
+  {
+    CHECK(fmt::format("{:%Q %aq}", 0.00123_q_V) == "1.23 mV");
+  }
+
+  SECTION("prefix larger than the one of the unit")
+  {
+    CHECK(fmt::format("{:%Q %aq}", 4700_q_R) == "4.7 kΩ");
+  }
+
+  SECTION("ASCII-only symbols")
+  {
+    CHECK(fmt::format("{:%Q %aAq}", 0.0000125_q_s) == "12.5 us");
+  }
+
+  SECTION("value precision")
+  {
+    CHECK(fmt::format("{:%.1Q %aq}", 1234.5_q_m) == "1.2 km");
+  }
+
+  SECTION("unit without a prefix family")
+  {
+    CHECK(fmt::format("{:%Q %aq}", 123_q_km_per_h) == "123 km/h");
+  }
+}
+
 TEST_CASE("%q and %Q can be put anywhere in a format string", "[text][fmt]")
 {
   SECTION("no space")
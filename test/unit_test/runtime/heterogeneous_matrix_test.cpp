@@ -0,0 +1,148 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/heterogeneous_matrix.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <sstream>
+
+using namespace units;
+using namespace units::physical::si;
+
+namespace {
+
+using m = length<metre>;
+using m_per_s = speed<metre_per_second>;
+using s = physical::si::time<second>;
+using one_q = dimensionless<one, double>;
+
+using state = hvec<m, m_per_s>;
+using measurement = hvec<m>;
+using covariance = hmat<state, state>;
+using transition = linear_map<state, state>;
+using observation = linear_map<measurement, state>;
+
+static_assert(std::is_same_v<covariance::cell_type<0, 1>, decltype(m() * m_per_s())>);
+static_assert(std::is_same_v<transition::cell_type<0, 0>, one_q>);
+static_assert(std::is_same_v<transition::cell_type<0, 1>, s>);
+static_assert(std::is_same_v<decltype(inverse(covariance())), hmat<hvec<decltype(1. / m()), decltype(1. / m_per_s())>, hvec<decltype(1. / m()), decltype(1. / m_per_s())>>>);
+
+// mismatching dimensions of the contracted cells are rejected at compile time
+template<typename A, typename B>
+concept multipliable = requires(A a, B b) { a * b; };
+static_assert(multipliable<transition, covariance>);
+static_assert(multipliable<transition, state>);
+static_assert(!multipliable<covariance, covariance>);
+static_assert(!multipliable<covariance, state>);
+
+constexpr transition make_transition(s dt)
+{
+  transition f = transition::identity();
+  f.set<0, 1>(dt);
+  return f;
+}
+
+}  // namespace
+
+TEST_CASE("heterogeneous vectors and matrices propagate the dimensions of cells", "[heterogeneous_matrix]")
+{
+  const transition f = make_transition(s(5.));
+  const state x(m(30'000.), m_per_s(40.));
+
+  const state predicted = f * x;
+  CHECK(predicted.get<0>() == m(30'200.));
+  CHECK(predicted.get<1>() == m_per_s(40.));
+
+  covariance p;
+  p.set<0, 0>(area<square_metre>(100.));
+  p.set<1, 1>(decltype(m_per_s() * m_per_s())(4.));
+  const covariance p2 = f * p * f.transpose();
+  CHECK(p2.get<0, 0>().count() == 200.);  // 100 + 25 * 4
+  CHECK(p2.get<0, 1>().count() == 20.);
+  CHECK(p2.get<1, 0>() == p2.get<0, 1>());
+  CHECK(p2.get<1, 1>().count() == 4.);
+
+  const auto o = outer(x, x);
+  STATIC_REQUIRE(std::is_same_v<decltype(o), const covariance>);
+  CHECK(o.get<0, 1>().count() == 30'000. * 40.);
+
+  // units are converted when cells are assigned
+  p.set<0, 0>(area<square_kilometre>(1.));
+  CHECK(p.get<0, 0>().count() == 1e6);
+}
+
+TEST_CASE("inverse of a heterogeneous matrix", "[heterogeneous_matrix]")
+{
+  covariance p;
+  p.set<0, 0>(area<square_metre>(4.));
+  p.set<0, 1>(decltype(m() * m_per_s())(2.));
+  p.set<1, 0>(decltype(m() * m_per_s())(2.));
+  p.set<1, 1>(decltype(m_per_s() * m_per_s())(3.));
+
+  const auto inv = inverse(p);
+  const auto id = p * inv;
+  STATIC_REQUIRE(std::is_same_v<decltype(id)::cell_type<0, 1>, decltype(m() / m_per_s())>);
+  CHECK(id.get<0, 0>().count() == Approx(1.));
+  CHECK(id.get<0, 1>().count() == Approx(0.).margin(1e-12));
+  CHECK(id.get<1, 0>().count() == Approx(0.).margin(1e-12));
+  CHECK(id.get<1, 1>().count() == Approx(1.));
+  CHECK(inv.get<0, 0>().count() == Approx(3. / 8.));
+}
+
+TEST_CASE("a Kalman filter step with heterogeneous matrices", "[heterogeneous_matrix]")
+{
+  const transition f = make_transition(s(5.));
+  observation h;
+  h.set<0, 0>(one_q(1.));
+  hmat<measurement, measurement> r;
+  r.set<0, 0>(area<square_metre>(25.));
+
+  state x(m(30'000.), m_per_s(40.));
+  covariance p;
+  p.set<0, 0>(area<square_metre>(100.));
+  p.set<1, 1>(decltype(m_per_s() * m_per_s())(25.));
+
+  // predict
+  x = f * x;
+  p = f * p * f.transpose();
+
+  // update
+  const measurement z(m(30'110.));
+  const auto innovation_cov = h * p * h.transpose() + r;
+  const linear_map<state, measurement> k = p * h.transpose() * inverse(innovation_cov);
+  x += k * (z - h * x);
+  p = (transition::identity() - k * h) * p;
+
+  // P = [[725, 125], [125, 25]], S = 750
+  CHECK(k.get<0, 0>().count() == Approx(725. / 750.));
+  CHECK(k.get<1, 0>().count() == Approx(125. / 750.));
+  CHECK(x.get<0>().count() == Approx(30'200. + (725. / 750.) * -90.));
+  CHECK(x.get<1>().count() == Approx(40. + (125. / 750.) * -90.));
+  CHECK(p.get<0, 0>().count() == Approx(725. - 725. * 725. / 750.));
+}
+
+TEST_CASE("heterogeneous vectors and matrices are printed", "[heterogeneous_matrix]")
+{
+  std::ostringstream os;
+  os << state(m(1.), m_per_s(2.)) << ' ' << make_transition(s(5.));
+  CHECK(os.str() == "[1 m, 2 m/s] [[1, 5 s], [0 Hz, 1]]");
+}
@@ -0,0 +1,167 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/interval.h"
+#include "units/physical/si/international/base/length.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+using namespace units;
+using namespace units::physical;
+
+namespace {
+
+using I = interval<double>;
+
+static_assert(ScalableNumber<I>);
+static_assert(treat_as_floating_point<I>);
+
+// constant evaluation
+static_assert((I(1., 2.) + I(3., 4.)).contains(4.));
+static_assert(pow<2>(I(-1., 2.)).lower() == 0.);
+static_assert(abs(I(-3., 2.)) == I(0., 3.));
+
+constexpr double inf = std::numeric_limits<double>::infinity();
+
+// `v` is within `ulps` steps of `expected`
+bool near(double v, double expected, int ulps = 4)
+{
+  const double d = v > expected ? v - expected : expected - v;
+  return d <= ulps * std::numeric_limits<double>::epsilon() * (expected < 0 ? -expected : expected);
+}
+
+}  // namespace
+
+TEST_CASE("interval arithmetic contains the exact result", "[interval]")
+{
+  const I third = I(1.) / I(3.);
+  CHECK(third.lower() < third.upper());
+  CHECK(static_cast<long double>(third.lower()) <= 1.0L / 3);
+  CHECK(static_cast<long double>(third.upper()) >= 1.0L / 3);
+  CHECK((third * I(3.)).contains(1.));
+  CHECK((I(0.1) + I(0.2) - I(0.3)).contains(0.1 + 0.2 - 0.3));
+
+  const I p = I(-1., 2.) * I(-3., 4.);
+  CHECK(near(p.lower(), -6.));
+  CHECK(near(p.upper(), 8.));
+  CHECK(p.contains(-6.));
+  CHECK(p.contains(8.));
+
+  const I d = I(1., 2.) - I(-1., 3.);
+  CHECK(d.contains(-2.));
+  CHECK(d.contains(3.));
+  CHECK(near(d.width(), 5.));
+  CHECK(-I(1., 2.) == I(-2., -1.));
+}
+
+TEST_CASE("interval division by an interval containing zero is unbounded", "[interval]")
+{
+  CHECK(I(1., 2.) / I(-1., 1.) == I(-inf, inf));
+  CHECK(I(1., 2.) / I(0., 1.) == I(-inf, inf));
+  const I q = I(1., 2.) / I(4., 8.);
+  CHECK(q.contains(0.125));
+  CHECK(q.contains(0.5));
+}
+
+TEST_CASE("interval bounds survive overflow to infinity", "[interval]")
+{
+  const double max = std::numeric_limits<double>::max();
+  const I big = I(max) + I(max);
+  CHECK(big.upper() == inf);
+  CHECK(big.lower() <= max * 2);
+  CHECK((I(-inf, inf) + I(1.)) == I(-inf, inf));
+}
+
+TEST_CASE("interval functions", "[interval]")
+{
+  CHECK(pow<2>(I(-1., 2.)).lower() == 0.);
+  CHECK(pow<2>(I(-1., 2.)).contains(4.));
+  CHECK(pow<3>(I(-1., 2.)).contains(-1.));
+  CHECK(pow<3>(I(-1., 2.)).contains(8.));
+  CHECK(pow<-1>(I(2., 4.)).contains(0.25));
+  CHECK(pow<-1>(I(2., 4.)).contains(0.5));
+  CHECK(sqrt(I(4., 9.)).contains(2.));
+  CHECK(sqrt(I(4., 9.)).contains(3.));
+  CHECK(sqrt(I(-1., 4.)).lower() == 0.);
+  CHECK(cbrt(I(-8., 27.)).contains(-2.));
+  CHECK(cbrt(I(-8., 27.)).contains(3.));
+  CHECK(abs(I(-3., -2.)) == I(2., 3.));
+  CHECK(hull(I(1., 2.), I(4., 5.)) == I(1., 5.));
+  CHECK(certainly_less(I(1., 2.), I(3., 4.)));
+  CHECK_FALSE(certainly_less(I(1., 3.), I(2., 4.)));
+  CHECK(possibly_less(I(1., 3.), I(2., 4.)));
+  CHECK_FALSE(possibly_less(I(3., 4.), I(1., 2.)));
+}
+
+TEST_CASE("interval is a representation type of quantities", "[interval]")
+{
+  using m = si::length<si::metre, I>;
+  using km = si::length<si::kilometre, I>;
+  using ft = si::length<si::international::foot, I>;
+
+  // conversions scale both bounds with an interval containing the exact factor
+  const m a = quantity_cast<m>(km(I(1.2, 1.3)));
+  CHECK(a.count().contains(1200.));
+  CHECK(a.count().contains(1300.));
+  const m f = ft(I(1.));
+  CHECK(f.count().contains(0.3048));
+  CHECK(f.count().width() < 1e-15);
+
+  const auto area = m(I(2., 3.)) * m(I(4., 5.));
+  static_assert(std::is_same_v<decltype(area)::dimension, si::dim_area>);
+  CHECK(area.count().contains(8.));
+  CHECK(area.count().contains(15.));
+  CHECK(sqrt(area).count().contains(3.));
+  CHECK(pow<2>(m(I(-1., 2.))).count().lower() == 0.);
+  CHECK(abs(m(I(-2., 1.))) == m(I(0., 2.)));
+  CHECK((2. * m(I(1., 2.))).count().contains(4.));
+
+  // minimum height above ground with uncertain altitude and terrain elevation
+  const km altitude(I(1.05, 1.10));
+  const m terrain(I(700., 760.));
+  const m min_agl(I(250.));
+  CHECK(certainly_less(min_agl, altitude - terrain));
+  CHECK_FALSE(certainly_less(m(I(300.)), altitude - terrain));
+  CHECK(possibly_less(m(I(300.)), altitude - terrain));
+
+  std::ostringstream os;
+  os << I(1., 2.);
+  CHECK(os.str() == "[1, 2]");
+}
+
+TEST_CASE("interval bounds of batches", "[interval]")
+{
+  using m = si::length<si::metre, I>;
+  std::vector<m> a, b, out(1000);
+  for (int i = 0; i < 1000; ++i) {
+    a.emplace_back(I(i * 0.1, i * 0.1 + 0.05));
+    b.emplace_back(I(i * 0.3, i * 0.3 + 0.01));
+  }
+  for (std::size_t i = 0; i < out.size(); ++i) out[i] = a[i] + b[i];
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    REQUIRE(out[i].count().contains(a[i].count().lower() + b[i].count().lower()));
+    REQUIRE(out[i].count().contains(a[i].count().upper() + b[i].count().upper()));
+  }
+}
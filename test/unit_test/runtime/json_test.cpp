@@ -0,0 +1,141 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/json.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace units;
+using namespace units::physical::si;
+
+namespace {
+
+struct sample {
+  speed<metre_per_second> v;
+  length<millimetre, std::int64_t> d;
+};
+
+}  // namespace
+
+TEST_CASE("quantities are encoded as JSON values", "[json]")
+{
+  std::string txt;
+  json_encode(std::back_inserter(txt), speed<kilometre_per_hour>(12.5));
+  CHECK(txt == R"({"value":12.5,"unit":"km/h"})");
+
+  txt.clear();
+  json_encode(std::back_inserter(txt), length<micrometre, int>(3), json_style::string);
+  CHECK(txt == "\"3 \xC2\xB5m\"");
+
+  txt.clear();
+  const sample s{speed<metre_per_second>(2.5), length<millimetre, std::int64_t>(-7)};
+  json_encode_object(std::back_inserter(txt), json_style::string, json_field("v", s.v), json_field("d", s.d));
+  CHECK(txt == R"({"v":"2.5 m/s","d":"-7 mm"})");
+
+  // JSON has no representation of infinities and NaNs
+  CHECK_THROWS_AS(json_encode(std::back_inserter(txt), speed<metre_per_second>(std::numeric_limits<double>::infinity())), json_error);
+  CHECK_THROWS_AS(json_encode(std::back_inserter(txt), length<metre, float>(std::numeric_limits<float>::quiet_NaN()), json_style::string), json_error);
+}
+
+TEST_CASE("JSON objects are decoded into bound quantities", "[json]")
+{
+  sample s{};
+
+  SECTION("object style with unit conversion") {
+    json_decode(R"( {"other": [1, {"a": "}"}], "v": {"unit": "km/h", "value": 36}, "d": {"value": 5, "unit": "m"}} )",
+                json_field<kilometre_per_hour>("v", s.v), json_field<metre>("d", s.d));
+    CHECK(s.v.count() == Approx(10.));
+    CHECK(s.d.count() == 5000);
+  }
+
+  SECTION("string style with escaped unit symbols") {
+    json_decode(R"({"d": "3000 \u00b5m", "v": "7.5m/s"})", json_field<micrometre>("d", s.d), json_field("v", s.v));
+    CHECK(s.v.count() == 7.5);
+    CHECK(s.d.count() == 3);
+  }
+
+  SECTION("plain numbers use the unit of the bound quantity") {
+    json_decode(R"({"v": 1e3, "d": 42})", json_field("v", s.v), json_field("d", s.d));
+    CHECK(s.v.count() == 1000.);
+    CHECK(s.d.count() == 42);
+  }
+
+  SECTION("encoded values round-trip") {
+    std::string txt;
+    const sample in{speed<metre_per_second>(0.1), length<millimetre, std::int64_t>(123456789012)};
+    json_encode_object(std::back_inserter(txt), json_style::object, json_field("v", in.v), json_field("d", in.d));
+    json_decode(txt, json_field("v", s.v), json_field("d", s.d));
+    CHECK(s.v == in.v);
+    CHECK(s.d == in.d);
+  }
+
+  SECTION("names are escaped") {
+    std::string txt;
+    const length<metre> in(2.);
+    json_encode_object(std::back_inserter(txt), json_style::object, json_field("a \"b\"\\c\n", in));
+    CHECK(txt == R"({"a \"b\"\\c\n":{"value":2,"unit":"m"}})");
+    length<metre> out;
+    json_decode(txt, json_field("a \"b\"\\c\n", out));
+    CHECK(out == in);
+  }
+}
+
+TEST_CASE("JSON decoding errors are reported", "[json]")
+{
+  speed<metre_per_second> v;
+  CHECK_THROWS_WITH(json_decode(R"({"x": 1})", json_field("v", v)), "json: missing field 'v' at offset 8");
+  CHECK_THROWS_WITH(json_decode(R"({"v": "1 m"})", json_field("v", v)), "json: unsupported unit 'm' of field 'v' at offset 11");
+  CHECK_THROWS_WITH(json_decode(R"({"v": "1 km/h"})", json_field("v", v)), "json: unsupported unit 'km/h' of field 'v' at offset 14");
+  CHECK_THROWS_WITH(json_decode(R"({"v": true})", json_field("v", v)), "json: invalid value of field 'v' at offset 10");
+  // JSON has no representation of infinities and NaNs
+  CHECK_THROWS_WITH(json_decode(R"({"v": nan})", json_field("v", v)), "json: invalid value of field 'v' at offset 9");
+  CHECK_THROWS_WITH(json_decode(R"({"v": -infinity})", json_field("v", v)), "json: invalid value of field 'v' at offset 15");
+  CHECK_THROWS_AS(json_decode(R"({"v": "inf m/s"})", json_field("v", v)), json_error);
+  CHECK_THROWS_AS(json_decode(R"({"v": {"value": INF, "unit": "m/s"}})", json_field("v", v)), json_error);
+  CHECK_THROWS_WITH(json_decode(R"({"v": 1)", json_field("v", v)), "json: unexpected end of input at offset 7");
+  CHECK_THROWS_WITH(json_decode(R"({"v": 1} x)", json_field("v", v)), "json: unexpected trailing characters at offset 9");
+}
+
+TEST_CASE("newline-delimited JSON records are decoded one by one", "[json]")
+{
+  const std::string_view txt = "{\"t\": 1, \"v\": \"36 km/h\"}\n\n{\"v\": 2, \"t\": {\"value\": 2000, \"unit\": \"ms\"}}\r\n{\"t\": 3, \"v\": 3}";
+  physical::si::time<second> t;
+  speed<metre_per_second> v;
+  std::vector<double> times;
+  std::vector<double> speeds;
+  const std::size_t count = ndjson_decode(txt, [&] { times.push_back(t.count()); speeds.push_back(v.count()); },
+                                          json_field<millisecond>("t", t), json_field<kilometre_per_hour>("v", v));
+  CHECK(count == 3);
+  CHECK(times == std::vector{1., 2., 3.});
+  REQUIRE(speeds.size() == 3);
+  CHECK(speeds[0] == Approx(10.));
+  CHECK(speeds[1] == 2.);
+  CHECK(speeds[2] == 3.);
+
+  CHECK_THROWS_WITH(ndjson_decode("{\"t\": 1, \"v\": 1}\n{\"t\": 1}", [] {}, json_field("t", t), json_field("v", v)),
+                    "json: missing field 'v' at offset 25");
+}
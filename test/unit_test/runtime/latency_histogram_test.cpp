@@ -0,0 +1,158 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/latency_histogram.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace units;
+using namespace units::physical;
+using namespace units::physical::si;
+
+namespace {
+
+using histogram = latency_histogram;
+
+struct manual_clock {
+  using duration = clock::duration;
+  using time_point = clock::time_point;
+  static inline time_point current{};
+  static time_point now() noexcept { return current; }
+  static void advance(const duration& d) noexcept { current += d; }
+};
+
+static_assert(histogram::bucket_index(histogram::duration::max()) == histogram::bucket_count - 1);
+static_assert(histogram::bucket_lower_bound(histogram::bucket_index(1000_q_ns)) <= 1000_q_ns);
+static_assert(std::is_same_v<decltype(histogram{}.percentile(50)), si::time<microsecond>>);
+
+}  // namespace
+
+TEST_CASE("latency_histogram buckets", "[latency_histogram]")
+{
+  SECTION("boundaries are consistent with the indices")
+  {
+    for (std::size_t i = 0; i < histogram::bucket_count; ++i) {
+      REQUIRE(histogram::bucket_index(histogram::bucket_lower_bound(i)) == i);
+      REQUIRE(histogram::bucket_index(histogram::bucket_upper_bound(i)) == i);
+    }
+  }
+
+  SECTION("relative width of buckets is bounded")
+  {
+    for (std::size_t i = 128; i + 1 < histogram::bucket_count; ++i) {
+      const auto lower = histogram::bucket_lower_bound(i);
+      const auto width = histogram::bucket_lower_bound(i + 1) - lower;
+      REQUIRE(width * 64 <= lower);
+    }
+  }
+
+  SECTION("negative durations are counted as zero")
+  {
+    CHECK(histogram::bucket_index(histogram::duration(-5)) == 0);
+  }
+}
+
+TEST_CASE("latency_histogram statistics", "[latency_histogram]")
+{
+  histogram h;
+  CHECK(h.percentile(99) == 0_q_us);
+
+  // 1 us ... 10000 us
+  for (int i = 1; i <= 10'000; ++i) h.record(si::time<microsecond, int>(i));
+  h.record(2_q_s);
+
+  CHECK(h.count() == 10'001);
+  CHECK(h.max_recorded() == 2_q_s);
+  CHECK(h.percentile(50).count() == Approx(5'000.).epsilon(1. / 64));
+  CHECK(h.percentile(99).count() == Approx(9'901.).epsilon(1. / 64));
+  CHECK(h.percentile(99) >= 9'900_q_us);
+  CHECK(h.percentile(100) == 2_q_s);
+  CHECK(h.mean().count() == Approx((10'000. * 10'001. / 2. + 2'000'000.) / 10'001.));
+
+  h.reset();
+  CHECK(h.count() == 0);
+  CHECK(h.max_recorded() == 0_q_ns);
+}
+
+TEST_CASE("latency_histogram percentiles use the nearest rank", "[latency_histogram]")
+{
+  histogram h;
+  // 1 ns ... 10 ns (each in its own bucket)
+  for (int i = 1; i <= 10; ++i) h.record(histogram::duration(i));
+
+  const auto ns = [&](double p) { return quantity_cast<nanosecond>(h.percentile(p)).count(); };
+  CHECK(ns(0) == Approx(1.));
+  CHECK(ns(10) == Approx(1.));
+  CHECK(ns(11) == Approx(2.));
+  CHECK(ns(50) == Approx(5.));
+  CHECK(ns(54) == Approx(6.));
+  CHECK(ns(70) == Approx(7.));
+  CHECK(ns(91) == Approx(10.));
+  CHECK(ns(100) == Approx(10.));
+}
+
+TEST_CASE("latency_histogram merge across threads", "[latency_histogram]")
+{
+  constexpr std::size_t threads = 4;
+  constexpr int samples = 100'000;
+  std::vector<histogram> local(threads);
+  histogram total;
+
+  {
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t)
+      workers.emplace_back([&h = local[t], t] {
+        for (int i = 0; i < samples; ++i) h.record(histogram::duration(static_cast<std::int64_t>(t) * 1000 + i % 1000));
+      });
+    // merging while the workers are still recording is allowed
+    for (const auto& h : local) {
+      histogram snapshot;
+      snapshot.merge(h);
+      CHECK(snapshot.count() <= static_cast<std::uint64_t>(samples));
+    }
+    for (auto& w : workers) w.join();
+  }
+
+  for (const auto& h : local) total.merge(h);
+  CHECK(total.count() == threads * samples);
+  CHECK(total.max_recorded() == histogram::duration(3'999));
+  std::uint64_t buckets = 0;
+  for (std::size_t i = 0; i < histogram::bucket_count; ++i) buckets += total.count(i);
+  CHECK(buckets == total.count());
+}
+
+TEST_CASE("scoped_timer records the lifetime of a scope", "[latency_histogram]")
+{
+  histogram h;
+  {
+    scoped_timer<histogram, manual_clock> t(h);
+    manual_clock::advance(2_q_ms);
+    CHECK(t.elapsed() == 2_q_ms);
+  }
+  REQUIRE(h.count() == 1);
+  CHECK(h.max_recorded() == 2_q_ms);
+  CHECK(h.percentile(50) >= 1'900_q_us);
+  CHECK(h.percentile(50) <= 2'100_q_us);
+}
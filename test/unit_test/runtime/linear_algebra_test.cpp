@@ -0,0 +1,128 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/linear_algebra.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <sstream>
+
+using namespace units;
+using namespace units::physical::si;
+
+namespace {
+
+using m = length<metre>;
+using N = force<newton>;
+
+static_assert(sizeof(vec<m, 3>) == 3 * sizeof(double));
+static_assert(sizeof(mat<m, 3, 3>) == 9 * sizeof(double));
+
+// constant evaluation uses the scalar kernels
+constexpr vec<m, 3> cv(m(1.), m(2.), m(3.));
+static_assert(dot(cv, cv) == area<square_metre>(14.));
+static_assert(cross(cv, vec<m, 3>(m(0.), m(0.), m(1.))) == vec<area<square_metre>, 3>(area<square_metre>(2.), area<square_metre>(-1.), area<square_metre>(0.)));
+static_assert(norm(vec<length<metre, int>, 2>(length<metre, int>(3), length<metre, int>(4))) == length<metre, int>(5));
+
+}  // namespace
+
+TEST_CASE("vectors of quantities support arithmetic with unit conversions", "[linear_algebra]")
+{
+  const vec<m, 3> v(m(1.), m(2.), m(3.));
+  const vec<length<kilometre>, 3> t(length<kilometre>(3.), length<kilometre>(2.), length<kilometre>(1.));
+
+  CHECK(v + v == vec<m, 3>(m(2.), m(4.), m(6.)));
+  CHECK(v - v == vec<m, 3>(m(0.), m(0.), m(0.)));
+  CHECK(-v == vec<m, 3>(m(-1.), m(-2.), m(-3.)));
+  CHECK(v + t == vec<m, 3>(m(3001.), m(2002.), m(1003.)));
+  CHECK(vec<m, 3>(t)[0].count() == 3000.);
+  CHECK(2 * v == v + v);
+  CHECK((v * 2).reps() == (v + v).reps());
+
+  // division by quantities and scalars
+  const auto speed = v / physical::si::time<second>(2.);
+  STATIC_REQUIRE(std::is_same_v<decltype(speed)::value_type::dimension, dim_speed>);
+  CHECK(speed[2].count() == 1.5);
+  CHECK((v / 2)[1].count() == 1.);
+
+  vec<length<metre, int>, 4> iv(length<metre, int>(4), length<metre, int>(8), length<metre, int>(12), length<metre, int>(-16));
+  iv /= 4;
+  CHECK(iv.reps() == std::array{1, 2, 3, -4});
+}
+
+TEST_CASE("products of vectors of different quantities", "[linear_algebra]")
+{
+  const vec<N, 3> f(N(1.), N(2.), N(3.));
+  const vec<m, 3> d(m(3.), m(2.), m(1.));
+
+  const auto w = dot(f, d);
+  STATIC_REQUIRE(std::is_same_v<decltype(w)::dimension, dim_energy>);
+  CHECK(w.count() == 10.);
+
+  const auto torque = cross(d, f);
+  CHECK(torque.reps() == std::array{4., -8., 4.});
+  CHECK(dot(torque, d).count() == 0.);
+
+  const auto scaled = f * m(2.);
+  STATIC_REQUIRE(std::is_same_v<decltype(scaled)::value_type::dimension, dim_energy>);
+  CHECK(scaled.reps() == std::array{2., 4., 6.});
+
+  CHECK(norm(vec<m, 2>(m(3.), m(4.))) == m(5.));
+  CHECK(norm(vec<length<kilometre>, 4>(length<kilometre>(1.), length<kilometre>(1.), length<kilometre>(1.), length<kilometre>(1.))).count() == 2.);
+}
+
+TEST_CASE("matrices of quantities", "[linear_algebra]")
+{
+  const mat<m, 2, 3> a{{m(1.), m(2.), m(3.)}, {m(4.), m(5.), m(6.)}};
+  const vec<N, 3> f(N(1.), N(0.), N(-1.));
+
+  CHECK(a(1, 2) == m(6.));
+  CHECK(a.row(0) == vec<m, 3>(m(1.), m(2.), m(3.)));
+  CHECK(a.transpose()(2, 1) == m(6.));
+
+  const auto af = a * f;
+  STATIC_REQUIRE(std::is_same_v<decltype(af)::value_type::dimension, dim_energy>);
+  CHECK(af.reps() == std::array{-2., -2.});
+
+  const auto aat = a * a.transpose();
+  STATIC_REQUIRE(decltype(aat)::rows() == 2 && decltype(aat)::columns() == 2);
+  CHECK(aat.reps() == std::array{14., 32., 32., 77.});
+
+  const mat<length<millimetre>, 2, 3> b = a;
+  CHECK(b(1, 0).count() == 4000.);
+  CHECK((a * 1000)(1, 0) == m(4000.));
+  CHECK(mat<m, 2, 3>(a + b)(0, 0) == m(2.));
+  CHECK((a - a) == mat<m, 2, 3>{{m(0.), m(0.), m(0.)}, {m(0.), m(0.), m(0.)}});
+
+  const mat<length<metre, std::int64_t>, 4, 4> id{{length<metre, std::int64_t>(1), length<metre, std::int64_t>(0), length<metre, std::int64_t>(0), length<metre, std::int64_t>(0)},
+                                                  {length<metre, std::int64_t>(0), length<metre, std::int64_t>(1), length<metre, std::int64_t>(0), length<metre, std::int64_t>(0)},
+                                                  {length<metre, std::int64_t>(0), length<metre, std::int64_t>(0), length<metre, std::int64_t>(1), length<metre, std::int64_t>(0)},
+                                                  {length<metre, std::int64_t>(2), length<metre, std::int64_t>(0), length<metre, std::int64_t>(0), length<metre, std::int64_t>(1)}};
+  CHECK((id * id).reps() == std::array<std::int64_t, 16>{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 4, 0, 0, 1});
+}
+
+TEST_CASE("vectors and matrices are printed", "[linear_algebra]")
+{
+  std::ostringstream os;
+  os << vec<m, 2>(m(1.), m(2.)) << ' ' << mat<m, 2, 1>{{m(3.)}, {m(4.)}};
+  CHECK(os.str() == "[1 m, 2 m] [[3 m], [4 m]]");
+}
@@ -0,0 +1,137 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "units/mapped_column.h"
+#include "units/compact_rep.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <array>
+#include <filesystem>
+#include <numeric>
+#include <utility>
+
+using namespace units;
+using namespace units::physical::si;
+
+namespace {
+
+struct temp_file {
+  std::filesystem::path path;
+  explicit temp_file(const char* name = "units_mapped_column_test.col") : path(std::filesystem::temp_directory_path() / name) {}
+  ~temp_file() { std::filesystem::remove(path); }
+};
+
+}  // namespace
+
+TEST_CASE("column files are written in chunks and mapped without copies", "[mapped_column]")
+{
+  const temp_file file;
+  using q = length<millimetre, std::int32_t>;
+
+  {
+    column_writer<q> writer(file.path, column_writer<q>::open_mode::create, 100);
+    for (std::int32_t i = 0; i < 250; ++i) writer.append(q(i));
+    CHECK(writer.size() == 250);
+
+    // only full chunks are visible to readers before the flush
+    const mapped_column<q> column(file.path);
+    CHECK(column.size() == 200);
+  }
+
+  const mapped_column<q> column(file.path, mapped_column<q>::access_hint::sequential);
+  REQUIRE(column.size() == 250);
+  const quantity_span<const q> data = column.quantities();
+  CHECK(reinterpret_cast<std::uintptr_t>(data.data()) % column_data_alignment == 0);
+  CHECK(data[0].count() == 0);
+  CHECK(data[249].count() == 249);
+  CHECK(std::accumulate(data.begin(), data.end(), q(0)).count() == 249 * 250 / 2);
+}
+
+TEST_CASE("column files can be appended to", "[mapped_column]")
+{
+  const temp_file file;
+  using q = physical::si::time<second>;
+
+  {
+    column_writer<q> writer(file.path);
+    const std::array<q, 2> values{q(1.), q(2.)};
+    writer.append(quantity_span<const q>(values));
+  }
+  {
+    column_writer<q> writer(file.path, column_writer<q>::open_mode::append);
+    CHECK(writer.size() == 2);
+    writer.append(q(3.));
+  }
+
+  const mapped_column<q> column(file.path);
+  REQUIRE(column.size() == 3);
+  CHECK(column.quantities()[2].count() == 3.);
+}
+
+TEST_CASE("move-assigned column writers flush their buffered quantities", "[mapped_column]")
+{
+  const temp_file file_a, file_b("units_mapped_column_test_b.col");
+  using q = length<metre>;
+
+  {
+    column_writer<q> a(file_a.path);
+    a.append(q(1.));
+    a.append(q(2.));
+    column_writer<q> b(file_b.path);
+    b.append(q(3.));
+    a = std::move(b);
+    CHECK(a.size() == 1);
+  }
+
+  const mapped_column<q> column_a(file_a.path);
+  REQUIRE(column_a.size() == 2);
+  CHECK(column_a.quantities()[1].count() == 2.);
+  const mapped_column<q> column_b(file_b.path);
+  REQUIRE(column_b.size() == 1);
+  CHECK(column_b.quantities()[0].count() == 3.);
+}
+
+TEST_CASE("column files are checked when opened", "[mapped_column]")
+{
+  const temp_file file;
+  {
+    column_writer<length<metre>> writer(file.path);
+    writer.append(length<metre>(1.));
+  }
+
+  CHECK_THROWS_AS(mapped_column<physical::si::time<second>>(file.path), serialization_error);
+  CHECK_THROWS_AS(mapped_column<length<kilometre>>(file.path), serialization_error);
+  using float_writer = column_writer<length<metre, float>>;
+  CHECK_THROWS_AS(float_writer(file.path, float_writer::open_mode::append), serialization_error);
+  CHECK_THROWS_AS(mapped_column<length<metre>>(file.path.string() + ".missing"), std::system_error);
+}
+
+TEST_CASE("column files of custom representation types are not opened as other types", "[mapped_column]")
+{
+  const temp_file file;
+  {
+    column_writer<length<metre, float16>> writer(file.path);
+    writer.append(length<metre, float16>(1.5f));
+  }
+
+  CHECK(float(mapped_column<length<metre, float16>>(file.path).quantities()[0].count()) == 1.5f);
+  CHECK_THROWS_AS((mapped_column<length<metre, bfloat16>>(file.path)), serialization_error);
+}
@@ -21,8 +21,11 @@
 // SOFTWARE.
 
 #include "units/math.h"
+#include "units/trigonometry.h"
 #include "units/physical/si/si.h"
 #include <catch2/catch.hpp>
+#include <array>
+#include <span>
 
 using namespace units;
 using namespace units::physical::si;
@@ -53,6 +56,58 @@ TEST_CASE("'sqrt()' on quantity changes the value and the dimension accordingly"
   REQUIRE(sqrt(4_q_m2) == 2_q_m);
 }
 
+TEST_CASE("'cbrt()' on quantity changes the value and the dimension accordingly", "[math][cbrt]")
+{
+  SECTION ("integral representation") {
+    REQUIRE(cbrt(27_q_m3) == 3_q_m);
+  }
+
+  SECTION ("floating-point representation") {
+    REQUIRE(cbrt(8._q_m3) == 2._q_m);
+  }
+}
+
+TEST_CASE("'hypot()' on quantities returns the magnitude in a common unit", "[math][hypot]")
+{
+  SECTION ("two arguments") {
+    REQUIRE(hypot(3._q_m, 4._q_m) == 5._q_m);
+  }
+
+  SECTION ("three arguments") {
+    REQUIRE(hypot(2._q_m, 4._q_m, 4._q_m) == 6._q_m);
+  }
+
+  SECTION ("different units") {
+    REQUIRE(hypot(3_q_km, 4000_q_m) == 5_q_km);
+  }
+}
+
+TEST_CASE("'fma()' on quantities computes 'a * x + b'", "[math][fma]")
+{
+  REQUIRE(fma(2._q_m_per_s, 3._q_s, 4._q_m) == 10._q_m);
+  REQUIRE(fma(2._q_km_per_h, 3._q_h, 400._q_m) == 6400._q_m);
+}
+
+TEST_CASE("rounding functions round to the target unit", "[math][floor][ceil][round]")
+{
+  SECTION ("'floor()'") {
+    REQUIRE(floor<second>(1500_q_ms) == 1_q_s);
+    REQUIRE(floor<second>(-1500_q_ms) == -2_q_s);
+    REQUIRE(floor<second>(-1.5_q_s) == -2._q_s);
+  }
+
+  SECTION ("'ceil()'") {
+    REQUIRE(ceil<second>(1500_q_ms) == 2_q_s);
+    REQUIRE(ceil<second>(-1.5_q_s) == -1._q_s);
+  }
+
+  SECTION ("'round()'") {
+    REQUIRE(round<second>(1500_q_ms) == 2_q_s);
+    REQUIRE(round<second>(2500_q_ms) == 2_q_s);
+    REQUIRE(round<second>(2500._q_ms) == 3._q_s);
+  }
+}
+
 TEST_CASE("absolute functions on quantity returns the absolute value", "[math][abs][fabs]")
 {
   SECTION ("'abs()' on a negative quantity returns the abs")
@@ -98,3 +153,67 @@ TEST_CASE("numeric_limits functions", "[limits]")
     REQUIRE(epsilon<decltype(1_q_m)>().count() != std::numeric_limits<decltype(1._q_m)::rep>::epsilon());
   }
 }
+
+TEST_CASE("trigonometric functions on angles", "[math][trig]")
+{
+  using namespace units::literals;
+
+  SECTION ("'sin()', 'cos()', and 'tan()' return dimensionless quantities") {
+    REQUIRE(sin(0._q_rad).count() == 0);
+    REQUIRE(cos(0._q_rad).count() == 1);
+    REQUIRE(sin(1._q_rad).count() == Approx(std::sin(1.)));
+    REQUIRE(tan(1._q_rad).count() == Approx(std::tan(1.)));
+  }
+
+  SECTION ("angles in degrees are accepted directly") {
+    REQUIRE(sin(30._q_deg).count() == Approx(0.5));
+    REQUIRE(cos(60._q_deg).count() == Approx(0.5));
+    REQUIRE(tan(45._q_deg).count() == Approx(1.));
+    REQUIRE(sin(90_q_deg).count() == Approx(1.));
+  }
+
+  SECTION ("inverse functions return angles in radians") {
+    REQUIRE(asin(dimensionless<one>(1.)).count() == Approx(std::asin(1.)));
+    REQUIRE(acos(dimensionless<one>(0.)).count() == Approx(std::acos(0.)));
+    REQUIRE(atan(dimensionless<one>(1.)).count() == Approx(std::atan(1.)));
+    REQUIRE(atan2(1._q_m, 1._q_m).count() == Approx(std::atan2(1., 1.)));
+    REQUIRE(atan2(1._q_km, -1000._q_m).count() == Approx(std::atan2(1., -1.)));
+  }
+
+  SECTION ("span versions") {
+    const std::array<angle<degree>, 3> in = {angle<degree>(0.), angle<degree>(90.), angle<degree>(180.)};
+    std::array<dimensionless<one>, 3> out{};
+
+    sin(std::span(in), std::span(out));
+    CHECK(out[1].count() == Approx(1.));
+    CHECK(out[2].count() == Approx(0.).margin(1e-12));
+
+    cos(std::span(in), std::span(out));
+    CHECK(out[0].count() == Approx(1.));
+    CHECK(out[2].count() == Approx(-1.));
+  }
+}
+
+TEST_CASE("fast trigonometric approximations stay within the documented error bounds", "[math][trig][fast]")
+{
+  double sin_cos_error = 0;
+  double atan2_error = 0;
+  for (int i = -100'000; i <= 100'000; ++i) {
+    const angle<radian> a(i * 1e-3);
+    sin_cos_error = std::max(sin_cos_error, std::abs(fast::sin(a).count() - std::sin(a.count())));
+    sin_cos_error = std::max(sin_cos_error, std::abs(fast::cos(a).count() - std::cos(a.count())));
+    const auto y = length<metre>(2 * std::sin(a.count()));
+    const auto x = length<metre>(2 * std::cos(a.count()));
+    atan2_error = std::max(atan2_error, std::abs(fast::atan2(y, x).count() - std::atan2(y.count(), x.count())));
+  }
+  CHECK(sin_cos_error <= 1e-9);
+  CHECK(atan2_error <= 2e-8);
+
+  const std::array<angle<degree>, 4> in = {angle<degree>(0.), angle<degree>(90.), angle<degree>(-90.), angle<degree>(720.)};
+  std::array<dimensionless<one>, 4> out{};
+  fast::sin(std::span(in), std::span(out));
+  CHECK(out[0].count() == Approx(0.).margin(1e-9));
+  CHECK(out[1].count() == Approx(1.).margin(1e-9));
+  CHECK(out[2].count() == Approx(-1.).margin(1e-9));
+  CHECK(out[3].count() == Approx(0.).margin(1e-9));
+}
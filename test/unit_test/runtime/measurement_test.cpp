@@ -0,0 +1,158 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/measurement.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using namespace units;
+using namespace units::physical;
+
+namespace {
+
+using M = measurement<double>;
+
+static_assert(ScalableNumber<M>);
+static_assert(treat_as_floating_point<M>);
+
+// constant evaluation
+static_assert((M(3., 0.3) + M(4., 0.4)).uncertainty() == 0.5);
+static_assert(pow<2>(M(2., 0.5)) == M(4., 2.));
+static_assert(sqrt(M(4., 0.4)) == M(2., 0.1));
+
+void check(const M& actual, const M& expected)
+{
+  CHECK(actual.value() == Approx(expected.value()).margin(1e-12));
+  CHECK(actual.uncertainty() == Approx(expected.uncertainty()).margin(1e-12));
+}
+
+}  // namespace
+
+TEST_CASE("measurement propagates uncertainties of uncorrelated operands", "[measurement]")
+{
+  check(M(3., 0.3) - M(4., 0.4), M(-1., 0.5));
+  check(M(2., 0.1) * M(3., 0.2), M(6., 0.5));
+  check(M(6., 0.5) / M(3., 0.2), M(2., std::sqrt(0.5 * 0.5 + 0.4 * 0.4) / 3.));
+  check(10. * M(2., 0.1), M(20., 1.));
+  check(M(2., 0.1) / 4., M(0.5, 0.025));
+  check(1. / M(2., 0.1), M(0.5, 0.025));
+  check(-M(2., 0.1), M(-2., 0.1));
+  CHECK(M(2., -0.1).uncertainty() == 0.1);
+  CHECK(M(2., 0.1).lower_bound() == 1.9);
+}
+
+TEST_CASE("measurement supports correlated operands", "[measurement]")
+{
+  const M a(2., 0.1);
+  check(correlated_add(a, a, 1.), a * 2.);
+  check(correlated_subtract(a, a, 1.), M(0., 0.));
+  check(correlated_multiply(a, a, 1.), pow<2>(a));
+  check(correlated_divide(a, a, 1.), M(1., 0.));
+  check(correlated_add(a, a, 0.), a + a);
+  check(correlated_add(M(3., 0.3), M(4., 0.4), -1.), M(7., 0.1));
+}
+
+TEST_CASE("measurement functions use first-order propagation", "[measurement]")
+{
+  check(pow<3>(M(2., 0.1)), M(8., 1.2));
+  check(pow<-1>(M(2., 0.1)), M(0.5, 0.025));
+  check(pow<0>(M(2., 0.1)), M(1., 0.));
+  check(sqrt(M(4., 0.4)), M(2., 0.1));
+  check(sin(M(0., 0.1)), M(0., 0.1));
+  check(cos(M(0., 0.1)), M(1., 0.));
+  check(tan(M(0., 0.1)), M(0., 0.1));
+  check(asin(M(0.5, 0.01)), M(std::asin(0.5), 0.01 / std::sqrt(0.75)));
+  check(acos(M(0.5, 0.01)), M(std::acos(0.5), 0.01 / std::sqrt(0.75)));
+  check(atan(M(1., 0.1)), M(std::atan(1.), 0.05));
+  check(atan2(M(1., 0.1), M(1., 0.)), M(std::atan2(1., 1.), 0.05));
+}
+
+TEST_CASE("measurement is a representation type of quantities", "[measurement]")
+{
+  const si::length<si::metre, M> l(M(6., 0.3));
+  const si::time<si::second, M> t(M(2., 0.1));
+
+  const Speed auto v = l / t;
+  check(v.count(), M(3., std::sqrt(2.) * 0.15));
+  check((l + si::length<si::kilometre, M>(M(0.001, 0.0004))).count(), M(7., 0.5));
+  check((10 * l).count(), M(60., 3.));
+
+  check(pow<2>(l).count(), M(36., 3.6));
+  static_assert(std::is_same_v<decltype(pow<2>(l))::dimension, si::dim_area>);
+  check(sqrt(pow<2>(l)).count(), l.count());
+  check(correlated_subtract(l, l, 1.).count(), M(0., 0.));
+  check(correlated_multiply(l, t, 0.).count(), (l * t).count());
+
+  check(sin(angle<degree, M>(M(90., 1.))).count(), M(1., 0.));
+  check(cos(angle<degree, M>(M(90., 1.))).count(), M(0., std::acos(-1.) / 180.));
+  check(asin(dimensionless<percent, M>(M(50., 1.))).count(), M(std::asin(0.5), 0.01 / std::sqrt(0.75)));
+}
+
+TEST_CASE("measurement_span processes structure of arrays columns", "[measurement]")
+{
+  using m = si::length<si::metre>;
+  using km = si::length<si::kilometre>;
+  using m2 = si::area<si::square_metre>;
+  using s = si::time<si::second>;
+  using mps = si::speed<si::metre_per_second>;
+  constexpr std::size_t n = 37;
+
+  std::vector<m> v1(n), s1(n);
+  std::vector<km> v2(n), s2(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    v1[i] = m(1. + static_cast<double>(i));
+    s1[i] = m(0.1 + 0.01 * static_cast<double>(i));
+    v2[i] = km(0.5 + 0.001 * static_cast<double>(i));
+    s2[i] = km(0.0002 * static_cast<double>(i));
+  }
+  const measurement_span<m> a(v1, s1);
+  const measurement_span<const km> b(v2, s2);
+  REQUIRE(a.size() == n);
+
+  std::vector<m> v(n), u(n);
+  const measurement_span<m> out(v, u);
+  add(measurement_span<const m>(a), b, out);
+  for (std::size_t i = 0; i < n; ++i) check(out[i].count(), (a[i] + si::length<si::metre, M>(b[i])).count());
+  subtract(a, b, out, 0.5);
+  for (std::size_t i = 0; i < n; ++i) check(out[i].count(), correlated_subtract(a[i], si::length<si::metre, M>(b[i]), 0.5).count());
+
+  std::vector<m2> va(n), ua(n);
+  const measurement_span<m2> area_out(va, ua);
+  multiply(a, b, area_out, -0.3);
+  for (std::size_t i = 0; i < n; ++i)
+    check(area_out[i].count(), correlated_multiply(a[i].count(), b[i].count() * 1000., -0.3));
+
+  std::vector<s> vt(n, s(2.)), ut(n, s(0.1));
+  std::vector<mps> vs(n), us(n);
+  divide(a, measurement_span<const s>(vt, ut), measurement_span<mps>(vs, us));
+  for (std::size_t i = 0; i < n; ++i) check(M(vs[i].count(), us[i].count()), a[i].count() / M(2., 0.1));
+
+  units::sqrt(measurement_span<const m2>(va, ua), out);
+  for (std::size_t i = 0; i < n; ++i) check(out[i].count(), sqrt(area_out[i]).count());
+
+  out.set(0, si::length<si::metre, M>(M(5., 0.5)));
+  CHECK(v[0] == m(5.));
+  CHECK(u[0] == m(0.5));
+}
@@ -0,0 +1,121 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/packed_quantity.h"
+#include "units/physical/si/international/base/length.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+using namespace units;
+using namespace units::physical;
+using namespace units::physical::si;
+
+namespace {
+
+// altitude in steps of 0.25 ft as a big-endian signed 24-bit integer
+using altitude = packed_quantity<length<international::foot>, std::endian::big, 24, ratio(1, 4)>;
+// ground speed in steps of 0.01 m/s as a big-endian unsigned 16-bit integer
+using ground_speed = packed_quantity<speed<metre_per_second>, std::endian::big, 16, ratio(1, 100), false>;
+// temperature offset in steps of 1 mK as a little-endian signed 32-bit integer
+using temperature = packed_quantity<thermodynamic_temperature<kelvin>, std::endian::little, 32, ratio(1, 1, -3)>;
+
+struct message {
+  std::uint8_t type;
+  altitude alt;
+  ground_speed gs;
+};
+
+static_assert(sizeof(altitude) == 3 && alignof(altitude) == 1);
+static_assert(sizeof(ground_speed) == 2 && alignof(ground_speed) == 1);
+static_assert(sizeof(temperature) == 4 && alignof(temperature) == 1);
+static_assert(std::is_trivially_copyable_v<altitude> && std::is_standard_layout_v<altitude>);
+static_assert(sizeof(message) == 6);
+
+static_assert(altitude::raw_min == -8'388'608 && altitude::raw_max == 8'388'607);
+static_assert(ground_speed::raw_min == 0 && ground_speed::raw_max == 65'535);
+static_assert(altitude(length<international::foot>(10'000.)).raw() == 40'000);
+static_assert(altitude::from_raw(-4).get() == length<international::foot>(-1.));
+
+}  // namespace
+
+TEST_CASE("packed_quantity byte order", "[packed_quantity]")
+{
+  const auto t = temperature::from_raw(0x01020304);
+  std::array<unsigned char, 4> le{};
+  std::memcpy(le.data(), &t, sizeof(t));
+  CHECK(le == std::array<unsigned char, 4>{0x04, 0x03, 0x02, 0x01});
+
+  const auto a = altitude::from_raw(0x010203);
+  std::array<unsigned char, 3> be{};
+  std::memcpy(be.data(), &a, sizeof(a));
+  CHECK(be == std::array<unsigned char, 3>{0x01, 0x02, 0x03});
+}
+
+TEST_CASE("packed_quantity overlays a packet buffer", "[packed_quantity]")
+{
+  const unsigned char buffer[] = {1, 0x00, 0x9c, 0x40, 0x01, 0xf4,   // 10000 ft, 5 m/s
+                                  2, 0xff, 0xff, 0xfc, 0xff, 0xff};  // -1 ft, 655.35 m/s
+  std::array<message, 2> msgs{};
+  std::memcpy(msgs.data(), buffer, sizeof(buffer));
+
+  CHECK(msgs[0].type == 1);
+  CHECK(msgs[0].alt.get() == length<international::foot>(10'000.));
+  CHECK(msgs[0].gs.get().count() == Approx(5.));
+  CHECK(msgs[1].alt.get() == length<international::foot>(-1.));
+  CHECK(msgs[1].gs.get().count() == Approx(655.35));
+
+  SECTION("unpack of a field converts to the requested unit")
+  {
+    std::vector<length<metre>> out(msgs.size());
+    unpack(std::span(msgs), &message::alt, quantity_span<length<metre>>(out));
+    CHECK(out[0].count() == Approx(3048.));
+    CHECK(out[1].count() == Approx(-0.3048));
+  }
+}
+
+TEST_CASE("packed_quantity rounds and saturates on write", "[packed_quantity]")
+{
+  CHECK(altitude(length<international::foot>(-1234.3)).raw() == -4937);
+  CHECK(altitude(length<international::foot>(1e9)).raw() == altitude::raw_max);
+  CHECK(altitude(length<international::foot>(-1e9)).raw() == altitude::raw_min);
+  CHECK(ground_speed(speed<metre_per_second>(-3.)).raw() == 0);
+  CHECK(ground_speed(speed<metre_per_second>(std::numeric_limits<double>::quiet_NaN())).raw() == 0);
+  CHECK(temperature(thermodynamic_temperature<kelvin>(-2.5)).raw() == -2500);
+}
+
+TEST_CASE("packed_quantity bulk pack and unpack", "[packed_quantity]")
+{
+  const std::vector<length<metre>> in{0_q_m, 1_q_m, -1_q_m, 1.5_q_km};
+  std::vector<altitude> packed(in.size());
+  pack(quantity_span<const length<metre>>(in), std::span(packed));
+  CHECK(packed[1].raw() == 13);  // 1 m == 3.28 ft
+
+  std::vector<length<metre>> out(in.size());
+  unpack(std::span<const altitude>(packed), quantity_span<length<metre>>(out));
+  for (std::size_t i = 0; i < in.size(); ++i) CHECK(out[i].count() == Approx(in[i].count()).margin(0.0381));
+}
@@ -0,0 +1,75 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/quantity_span.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <array>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+using namespace units;
+using namespace units::physical;
+using namespace units::physical::si;
+
+namespace {
+
+template<typename Q, typename Rep>
+concept reinterpretable = requires(std::span<Rep> reps) { as_quantities<Q>(reps); };
+
+static_assert(reinterpretable<length<metre>, double>);
+static_assert(reinterpretable<length<metre>, const double>);
+static_assert(!reinterpretable<length<metre>, float>);
+static_assert(!reinterpretable<length<metre, int>, long>);
+
+static_assert(std::is_same_v<decltype(as_reps(std::declval<quantity_span<length<metre>>>())), std::span<double>>);
+static_assert(std::is_same_v<decltype(as_reps(std::declval<quantity_span<const length<metre>, 3>>())), std::span<const double, 3>>);
+static_assert(std::is_same_v<decltype(as_quantities<length<metre>>(std::declval<std::span<const double>>())),
+                             quantity_span<const length<metre>>>);
+
+}  // namespace
+
+TEST_CASE("as_reps views quantities as values", "[quantity_span]")
+{
+  std::vector<length<kilometre>> qs{1._q_km, 2._q_km, 3._q_km};
+  const auto reps = as_reps(quantity_span<length<kilometre>>(qs));
+  REQUIRE(reps.size() == qs.size());
+  CHECK(static_cast<const void*>(reps.data()) == static_cast<const void*>(qs.data()));
+  CHECK(std::accumulate(reps.begin(), reps.end(), 0.) == 6.);
+
+  // writes through the view modify the quantities
+  for (double& v : reps) v *= 2;
+  CHECK(qs[2] == 6._q_km);
+}
+
+TEST_CASE("as_quantities views values as quantities", "[quantity_span]")
+{
+  const std::array<double, 3> values{0.5, 1.5, 2.5};
+  const auto qs = as_quantities<si::time<second>>(std::span(values));
+  static_assert(decltype(qs)::extent == 3);
+  CHECK(qs[1] == 1.5_q_s);
+
+  const auto round_trip = as_reps(qs);
+  CHECK(round_trip.data() == values.data());
+}
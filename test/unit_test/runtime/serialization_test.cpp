@@ -0,0 +1,197 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "units/serialization.h"
+#include "units/compact_rep.h"
+#include "units/fixed_point.h"
+#include "units/physical/si/si.h"
+#include "units/physical/si/cgs/cgs.h"
+#include "units/physical/si/us/base/length.h"
+#include <catch2/catch.hpp>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+using namespace units;
+using namespace units::physical::si;
+
+TEST_CASE("serialized header describes the quantity type", "[serialization]")
+{
+  std::vector<std::byte> buf;
+  serialize(speed<kilometre_per_hour, std::int32_t>(90), std::back_inserter(buf));
+
+  const column_header h = read_header(buf);
+  CHECK(h.kind == column_header::record_kind::quantity);
+  CHECK(h.rep == column_header::rep_kind::signed_integral);
+  CHECK(h.rep_size == 4);
+  CHECK(h.byte_order == std::endian::native);
+  REQUIRE(h.exponents.size() == 2);
+  CHECK(h.exponents[0] == column_header::exponent_entry{"L", 1, 1});
+  CHECK(h.exponents[1] == column_header::exponent_entry{"T", -1, 1});
+  CHECK(static_cast<double>(h.unit_ratio.num) / static_cast<double>(h.unit_ratio.den) * std::pow(10., static_cast<double>(h.unit_ratio.exp)) == Approx(5. / 18.));
+  CHECK(h.count == 1);
+  CHECK(buf.size() == h.size + 4);
+}
+
+TEST_CASE("quantities survive a round trip", "[serialization]")
+{
+  std::vector<std::byte> buf;
+  auto out = std::back_inserter(buf);
+  out = serialize(length<kilometre, std::int64_t>(42), out);
+  out = serialize(quantity_point(thermodynamic_temperature<kelvin>(293.15)), out);
+  const std::array<mass<gram, float>, 3> masses{mass<gram, float>(1.f), mass<gram, float>(2.5f), mass<gram, float>(-3.f)};
+  out = serialize(quantity_span<const mass<gram, float>>(masses), out);
+  serialize(dimensionless<percent, fixed_point<std::int32_t, 8>>(fixed_point<std::int32_t, 8>(12.5)), out);
+
+  std::span<const std::byte> in(buf);
+  CHECK(deserialize<length<kilometre, std::int64_t>>(in).count() == 42);
+  CHECK(deserialize<quantity_point<dim_thermodynamic_temperature, kelvin>>(in).relative().count() == 293.15);
+  std::array<mass<gram, float>, 3> m{};
+  REQUIRE(deserialize(in, quantity_span<mass<gram, float>>(m)) == 3);
+  CHECK(m[1].count() == 2.5f);
+  CHECK(m[2].count() == -3.f);
+  CHECK(deserialize<dimensionless<percent, fixed_point<std::int32_t, 8>>>(in).count() == fixed_point<std::int32_t, 8>(12.5));
+  CHECK(in.empty());
+}
+
+TEST_CASE("deserializing into a different unit or representation converts the values", "[serialization]")
+{
+  std::vector<std::byte> buf;
+  const std::array<length<millimetre, std::int32_t>, 3> d{length<millimetre, std::int32_t>(1500),
+                                                         length<millimetre, std::int32_t>(-20),
+                                                         length<millimetre, std::int32_t>(7)};
+  serialize(quantity_span<const length<millimetre, std::int32_t>>(d), std::back_inserter(buf));
+
+  SECTION("floating-point target") {
+    std::span<const std::byte> in(buf);
+    std::array<length<metre>, 3> out{};
+    REQUIRE(deserialize(in, quantity_span<length<metre>>(out)) == 3);
+    CHECK(out[0].count() == Approx(1.5));
+    CHECK(out[1].count() == Approx(-0.02));
+    CHECK(in.empty());
+  }
+
+  SECTION("integral target") {
+    std::span<const std::byte> in(buf);
+    std::array<length<micrometre, std::int64_t>, 3> out{};
+    REQUIRE(deserialize(in, quantity_span<length<micrometre, std::int64_t>>(out)) == 3);
+    CHECK(out[0].count() == 1'500'000);
+    CHECK(out[2].count() == 7'000);
+  }
+
+  SECTION("other system of units") {
+    std::span<const std::byte> in(buf);
+    std::array<length<cgs::centimetre>, 3> out{};
+    REQUIRE(deserialize(in, quantity_span<length<cgs::centimetre>>(out)) == 3);
+    CHECK(out[0].count() == Approx(150.));
+  }
+}
+
+TEST_CASE("custom representation types are identified in the header", "[serialization]")
+{
+  std::vector<std::byte> buf;
+  auto out = std::back_inserter(buf);
+  out = serialize(length<metre, float16>(1.5f), out);
+  serialize(length<metre, fixed_point<std::int32_t, 8>>(fixed_point<std::int32_t, 8>(1.5)), out);
+
+  const column_header h = read_header(buf);
+  CHECK(h.rep == column_header::rep_kind::other);
+  CHECK(h.rep_size == 2);
+  CHECK(h.rep_id == serialization_rep_id<float16>);
+
+  SECTION("the same representation type is read back") {
+    std::span<const std::byte> in(buf);
+    CHECK(float(deserialize<length<metre, float16>>(in).count()) == 1.5f);
+    CHECK(deserialize<length<metre, fixed_point<std::int32_t, 8>>>(in).count() == fixed_point<std::int32_t, 8>(1.5));
+    CHECK(in.empty());
+  }
+
+  SECTION("a different representation type of the same size is rejected") {
+    std::span<const std::byte> in(buf);
+    CHECK_THROWS_AS((deserialize<length<metre, bfloat16>>(in)), serialization_error);
+    in = std::span<const std::byte>(buf).subspan(h.size + h.rep_size);
+    CHECK_THROWS_AS((deserialize<length<metre, fixed_point<std::int32_t, 16>>>(in)), serialization_error);
+  }
+}
+
+TEST_CASE("malformed or mismatching records are rejected", "[serialization]")
+{
+  std::vector<std::byte> buf;
+  serialize(length<metre>(1.), std::back_inserter(buf));
+
+  SECTION("dimension mismatch") {
+    std::span<const std::byte> in(buf);
+    CHECK_THROWS_AS(deserialize<physical::si::time<second>>(in), serialization_error);
+  }
+
+  SECTION("record kind mismatch") {
+    std::span<const std::byte> in(buf);
+    using point = quantity_point<dim_length, metre>;
+    CHECK_THROWS_AS(deserialize<point>(in), serialization_error);
+  }
+
+  SECTION("truncated data") {
+    std::span<const std::byte> in(buf.data(), buf.size() - 1);
+    CHECK_THROWS_AS(deserialize<length<metre>>(in), serialization_error);
+    std::span<const std::byte> header(buf.data(), 10);
+    CHECK_THROWS_AS(read_header(header), serialization_error);
+  }
+
+  SECTION("output range too small") {
+    std::vector<std::byte> col;
+    const std::array<length<metre>, 2> d{};
+    serialize(quantity_span<const length<metre>>(d), std::back_inserter(col));
+    std::span<const std::byte> in(col);
+    std::array<length<metre>, 1> out{};
+    CHECK_THROWS_AS(deserialize(in, quantity_span<length<metre>>(out)), serialization_error);
+  }
+
+  SECTION("corrupted unit ratio") {
+    std::vector<std::byte> ints;
+    serialize(length<metre, std::int64_t>(1), std::back_inserter(ints));
+    const auto patched = [](std::vector<std::byte> col, std::size_t index, std::int64_t value) {
+      // the unit ratio precedes the element count at the end of the header
+      detail::store_le(col.data() + read_header(col).size - 32 + index * 8, value);
+      return col;
+    };
+    const auto rejected = [](const std::vector<std::byte>& col, auto target) {
+      std::span<const std::byte> in(col);
+      CHECK_THROWS_AS(deserialize<decltype(target)>(in), serialization_error);
+    };
+
+    const auto huge_exp = patched(buf, 2, std::int64_t{1} << 40);
+    CHECK_THROWS_AS(read_header(huge_exp), serialization_error);
+    rejected(huge_exp, length<metre>());
+    rejected(patched(buf, 0, std::numeric_limits<std::int64_t>::min()), length<metre>());
+    rejected(patched(buf, 2, 400), length<metre, float>());
+    rejected(patched(ints, 2, 100), length<metre, std::int64_t>());
+    rejected(patched(ints, 0, std::numeric_limits<std::int64_t>::max()), length<us::foot, std::int64_t>());
+  }
+
+  SECTION("not serialized data") {
+    const std::array<std::byte, 64> garbage{};
+    std::span<const std::byte> in(garbage);
+    CHECK_THROWS_AS(deserialize<length<metre>>(in), serialization_error);
+  }
+}
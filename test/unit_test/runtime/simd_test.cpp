@@ -0,0 +1,132 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#if __has_include(<experimental/simd>)
+
+#include "units/simd.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <experimental/simd>
+#include <vector>
+
+using namespace units;
+using namespace units::physical;
+using namespace units::physical::si;
+
+namespace {
+
+namespace stdx = std::experimental;
+
+using pack = stdx::native_simd<double>;
+constexpr std::size_t lanes = pack::size();
+
+static_assert(ScalableNumber<pack>);
+static_assert(ScalableNumber<stdx::fixed_size_simd<int, 4>>);
+static_assert(treat_as_floating_point<pack>);
+static_assert(!treat_as_floating_point<stdx::native_simd<int>>);
+static_assert(std::is_same_v<common_quantity<quantity_pack<si::dim_length, metre, double>, quantity_pack<si::dim_length, kilometre, double>>,
+                             quantity_pack<si::dim_length, metre, double>>);
+
+// lanes equal to 0, 1, 2, ...
+template<typename Q>
+Q iota_pack()
+{
+  return Q(typename Q::rep([](auto i) { return static_cast<typename Q::rep::value_type>(i); }));
+}
+
+}  // namespace
+
+TEST_CASE("quantities of SIMD packs convert units in every lane", "[simd]")
+{
+  const auto d = iota_pack<quantity_pack<si::dim_length, kilometre, double>>();
+  const length<metre, pack> m = d;
+  const auto v = d / quantity_pack<si::dim_time, hour, double>(2.);
+  const speed<metre_per_second, pack> v_si = v;
+  const quantity_pack<si::dim_length, metre, int, stdx::simd_abi::fixed_size<4>> mi =
+      quantity_pack<si::dim_length, kilometre, int, stdx::simd_abi::fixed_size<4>>(3);
+
+  for (std::size_t i = 0; i < lanes; ++i) {
+    CHECK(m.count()[i] == 1000. * static_cast<double>(i));
+    CHECK(v_si.count()[i] == Approx(static_cast<double>(i) / 7.2));
+  }
+  CHECK(stdx::all_of(mi.count() == 3000));
+  CHECK(stdx::all_of(quantity_cast<length<kilometre, pack>>(m).count() == d.count()));
+}
+
+TEST_CASE("comparisons of quantities of SIMD packs return masks", "[simd]")
+{
+  const auto d = iota_pack<quantity_pack<si::dim_length, kilometre, double>>();
+  const length<metre, pack> threshold(500.);
+
+  const auto gt = d > threshold;
+  static_assert(std::is_same_v<std::remove_const_t<decltype(gt)>, pack::mask_type>);
+  CHECK(stdx::popcount(gt) == static_cast<int>(lanes) - 1);
+  CHECK(stdx::all_of((d <= threshold) == !gt));
+  CHECK(stdx::all_of(d == d));
+  CHECK(stdx::none_of(d != d));
+  CHECK(stdx::all_of(d >= d && !(d < d)));
+
+  const auto clamped = select(gt, quantity_pack<si::dim_length, kilometre, double>(threshold), d);
+  CHECK(hmax(clamped) == 0.5_q_km);
+  CHECK(hmin(clamped) == 0._q_km);
+}
+
+TEST_CASE("quantities of SIMD packs are loaded from and stored to contiguous storage", "[simd]")
+{
+  std::vector<length<metre>> distances;
+  std::vector<si::time<second>> times;
+  for (std::size_t i = 0; i < 4 * lanes; ++i) {
+    distances.emplace_back(10. * static_cast<double>(i));
+    times.emplace_back(2.);
+  }
+  std::vector<speed<metre_per_second>> speeds(distances.size());
+
+  for (std::size_t i = 0; i < distances.size(); i += lanes) {
+    const auto d = load(quantity_span<const length<metre>>(distances), i);
+    const auto t = load(quantity_span<const si::time<second>>(times), i);
+    store(speed<metre_per_second, pack>(d / t), quantity_span<speed<metre_per_second>>(speeds), i);
+  }
+  for (std::size_t i = 0; i < speeds.size(); ++i) CHECK(speeds[i] == speed<metre_per_second>(5. * static_cast<double>(i)));
+
+  const auto first4 = load<stdx::simd_abi::fixed_size<4>>(quantity_span<const length<metre>>(distances));
+  CHECK(reduce(first4) == 60._q_m);
+}
+
+TEST_CASE("math functions work element-wise on quantities of SIMD packs", "[simd]")
+{
+  const auto x = iota_pack<quantity_pack<si::dim_length, metre, double>>();
+  const auto area = x * x;
+
+  CHECK(stdx::all_of(sqrt(area).count() == x.count()));
+  CHECK(stdx::all_of(pow<2>(x).count() == area.count()));
+  CHECK(stdx::all_of(abs(-x).count() == x.count()));
+  CHECK(stdx::all_of(hypot(x, x).count() == stdx::sqrt(2. * x.count() * x.count())));
+
+  const auto a = quantity_pack<dim_angle<>, degree, double>(90.);
+  CHECK(stdx::all_of(stdx::abs(sin(a).count() - 1.) < 1e-12));
+  CHECK(stdx::all_of(stdx::abs(cos(a).count()) < 1e-12));
+  const auto right = atan2(x + length<metre, pack>(1.), length<metre, pack>(0.));
+  CHECK(stdx::all_of(stdx::abs(right.count() - std::acos(-1.) / 2) < 1e-12));
+}
+
+#endif  // __has_include(<experimental/simd>)
@@ -0,0 +1,93 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <units/data/throughput_meter.h>
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace units;
+using namespace units::data;
+
+namespace {
+
+using s = physical::si::time<physical::si::second>;
+using Mib_per_s = bitrate<mebibit_per_second>;
+
+clock::time_point at(double seconds) { return clock::time_point(clock::duration(static_cast<std::int64_t>(seconds * 1e9))); }
+
+}  // namespace
+
+TEST_CASE("throughput_meter accounts data from many threads", "[throughput_meter]")
+{
+  constexpr std::size_t threads = 8;
+  constexpr int chunks = 10'000;
+  throughput_meter m;
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < threads; ++t)
+    workers.emplace_back([&m] {
+      for (int i = 0; i < chunks; ++i) m.add(4_q_KiB);
+    });
+  for (auto& w : workers) w.join();
+  CHECK(m.total() == information<kibibyte, std::int64_t>(4 * threads * chunks));
+}
+
+TEST_CASE("throughput_meter sliding window rate", "[throughput_meter]")
+{
+  throughput_meter m;
+  CHECK(m.rate(s(1.)) == bitrate<bit_per_second>(0.));
+
+  // 1 MiB/s for 10 s then 3 MiB/s for 5 s sampled every 0.5 s
+  m.sample(at(0));
+  for (int i = 1; i <= 30; ++i) {
+    m.add(i <= 20 ? 512_q_KiB : 1536_q_KiB);
+    m.sample(at(0.5 * i));
+  }
+  CHECK(Mib_per_s(m.rate(s(2.))).count() == Approx(24.));
+  CHECK(Mib_per_s(m.rate(physical::si::time<physical::si::millisecond, int>(10'000))).count() == Approx(16.));
+
+  SECTION("window longer than the history")
+  {
+    CHECK(Mib_per_s(m.rate(s(100.))).count() == Approx((10. * 8 + 5. * 24) / 15.));
+  }
+}
+
+TEST_CASE("throughput_meter exponentially weighted moving average", "[throughput_meter]")
+{
+  throughput_meter m(s(1.));
+  m.sample(at(0));
+  m.add(1_q_MiB);
+  m.sample(at(1));
+  CHECK(Mib_per_s(m.ewma()).count() == Approx(8.));
+
+  // converges to the new rate
+  for (int i = 2; i <= 20; ++i) {
+    m.add(2_q_MiB);
+    m.sample(at(i));
+  }
+  CHECK(Mib_per_s(m.ewma()).count() == Approx(16.).epsilon(1e-6));
+
+  // a single step moves by 1 - e^-1 of the difference
+  m.sample(at(21));
+  CHECK(Mib_per_s(m.ewma()).count() == Approx(16. * std::exp(-1.)));
+}
@@ -0,0 +1,146 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/time_series.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <cstddef>
+
+using namespace units;
+using namespace units::physical;
+
+namespace {
+
+using s = si::time<si::second>;
+using ms = si::time<si::millisecond>;
+using tp = quantity_point<si::dim_time, si::second, double>;
+using m_per_s = si::speed<si::metre_per_second>;
+using series = time_series<tp, m_per_s>;
+
+static_assert(std::is_same_v<decltype(series{}.interpolate(tp{})), m_per_s>);
+
+series make_series()
+{
+  series ts;
+  ts.push_back(tp(s(0.)), m_per_s(0.));
+  ts.push_back(tp(s(1.)), m_per_s(10.));
+  ts.push_back(tp(s(3.)), m_per_s(30.));
+  ts.push_back(tp(s(4.)), m_per_s(20.));
+  return ts;
+}
+
+}  // namespace
+
+TEST_CASE("time_series lookup", "[time_series]")
+{
+  auto ts = make_series();
+  CHECK(ts.size() == 4);
+  CHECK(ts.lower_bound(tp(s(-1.))) == 0);
+  CHECK(ts.lower_bound(tp(s(1.))) == 1);
+  CHECK(ts.lower_bound(tp(s(2.))) == 2);
+  CHECK(ts.lower_bound(tp(s(5.))) == 4);
+
+  ts.insert(tp(s(2.)), m_per_s(15.));
+  REQUIRE(ts.size() == 5);
+  CHECK(ts.times()[2] == tp(s(2.)));
+  CHECK(ts.values()[2] == m_per_s(15.));
+  CHECK(ts.values()[3] == m_per_s(30.));
+}
+
+TEST_CASE("time_series interpolation", "[time_series]")
+{
+  const auto ts = make_series();
+
+  SECTION("previous")
+  {
+    CHECK(ts.interpolate(tp(s(2.9)), interpolation::previous) == m_per_s(10.));
+    CHECK(ts.interpolate(tp(s(3.)), interpolation::previous) == m_per_s(30.));
+  }
+
+  SECTION("linear")
+  {
+    CHECK(ts.interpolate(tp(s(0.5))).count() == Approx(5.));
+    CHECK(ts.interpolate(tp(s(2.))).count() == Approx(20.));
+    CHECK(ts.interpolate(tp(s(3.5))).count() == Approx(25.));
+  }
+
+  SECTION("cubic passes through samples and preserves lines")
+  {
+    for (std::size_t i = 0; i < ts.size(); ++i)
+      CHECK(ts.interpolate(ts.times()[i], interpolation::cubic).count() == Approx(ts.values()[i].count()));
+    // the first three samples lie on v = 10 m/s^2 * t
+    CHECK(ts.interpolate(tp(s(0.5)), interpolation::cubic).count() == Approx(5.));
+  }
+
+  SECTION("clamped outside of the range")
+  {
+    CHECK(ts.interpolate(tp(s(-1.)), interpolation::cubic) == m_per_s(0.));
+    CHECK(ts.interpolate(tp(s(10.))) == m_per_s(20.));
+  }
+}
+
+TEST_CASE("time_series resample", "[time_series]")
+{
+  constexpr std::size_t n = 1'000'000;
+  series ts;
+  ts.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const double t = static_cast<double>(i) * 0.001;
+    ts.push_back(tp(s(t)), m_per_s(2. * t + 1.));
+  }
+
+  const auto r = ts.resample(tp(s(0.0005)), s(ms(2.5)), 399'999);
+  REQUIRE(r.size() == 399'999);
+  for (std::size_t k = 0; k < r.size(); k += 997) {
+    const double t = 0.0005 + static_cast<double>(k) * 0.0025;
+    CHECK(r.times()[k].relative().count() == Approx(t));
+    CHECK(r.values()[k].count() == Approx(2. * t + 1.));
+  }
+
+  const auto c = ts.resample(tp(s(0.0005)), s(0.25), 100, interpolation::cubic);
+  CHECK(c.values()[40].count() == Approx(2. * 10.0005 + 1.));
+}
+
+TEST_CASE("time_series window aggregation", "[time_series]")
+{
+  const auto ts = make_series();
+  const auto start = tp(s(0.));
+
+  const auto mean = ts.aggregate(start, s(2.), 3, aggregation::mean);
+  REQUIRE(mean.size() == 3);
+  CHECK(mean.times()[0] == tp(s(0.)));
+  CHECK(mean.values()[0] == m_per_s(5.));
+  CHECK(mean.times()[1] == tp(s(2.)));
+  CHECK(mean.values()[1] == m_per_s(30.));
+  CHECK(mean.times()[2] == tp(s(4.)));
+  CHECK(mean.values()[2] == m_per_s(20.));
+
+  // windows without samples are skipped
+  const auto max = ts.aggregate(start, s(1.5), 3, aggregation::max);
+  REQUIRE(max.size() == 2);
+  CHECK(max.values()[0] == m_per_s(10.));
+  CHECK(max.times()[1] == tp(s(3.)));
+  CHECK(max.values()[1] == m_per_s(30.));
+
+  CHECK(ts.aggregate(tp(s(0.5)), tp(s(4.)), aggregation::min) == m_per_s(10.));
+  CHECK(ts.aggregate(tp(s(0.)), tp(s(5.)), aggregation::sum) == m_per_s(60.));
+}
@@ -0,0 +1,142 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/token_bucket.h"
+#include "units/data/data.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace units;
+using namespace units::data;
+
+namespace {
+
+struct manual_clock {
+  using duration = clock::duration;
+  using time_point = clock::time_point;
+  static inline time_point current{};
+  static time_point now() noexcept { return current; }
+  static void advance(const duration& d) noexcept { current += d; }
+};
+
+using bytes = information<byte, std::int64_t>;
+using requests = dimensionless<one, std::int64_t>;
+using ns = physical::si::time<physical::si::nanosecond, std::int64_t>;
+
+}  // namespace
+
+TEST_CASE("token_bucket limits a data rate", "[token_bucket]")
+{
+  // 8 Mib/s == 1 MiB/s
+  token_bucket<bytes, manual_clock> b(8_q_Mib_per_s, 64_q_KiB);
+  CHECK(b.capacity() == 64_q_KiB);
+  CHECK(b.available() == 64_q_KiB);
+
+  REQUIRE(b.try_acquire(64_q_KiB));
+  CHECK_FALSE(b.try_acquire(1_q_B));
+  CHECK(b.available() == 0_q_B);
+
+  // 1 KiB needs 1/1024 s
+  const auto wait = b.wait_time(1_q_KiB);
+  CHECK(wait >= ns(976'562));
+  CHECK(wait <= ns(976'564));
+  manual_clock::advance(wait - ns(1));
+  CHECK_FALSE(b.try_acquire(1_q_KiB));
+  manual_clock::advance(ns(1));
+  CHECK(b.try_acquire(1_q_KiB));
+
+  SECTION("refills up to the capacity only")
+  {
+    manual_clock::advance(ns(10'000'000'000));
+    CHECK(b.available() == 64_q_KiB);
+    CHECK_FALSE(b.try_acquire(bytes(64 * 1024 + 1)));
+    CHECK(b.wait_time(bytes(64 * 1024 + 1)) == clock::duration::max());
+  }
+
+  SECTION("never exceeds the rate")
+  {
+    std::int64_t taken = 0;
+    for (int i = 0; i < 100'000; ++i) {
+      if (b.try_acquire(1500_q_B)) taken += 1500;
+      manual_clock::advance(ns(1'000));
+    }
+    // 0.1 s at 1 MiB/s
+    CHECK(taken <= 1024 * 1024 / 10 + 1500);
+    CHECK(taken >= 1024 * 1024 / 10 - 1500);
+  }
+}
+
+TEST_CASE("token_bucket limits a request rate", "[token_bucket]")
+{
+  token_bucket<requests, manual_clock> b(physical::si::frequency<physical::si::hertz, int>(100), requests(5));
+  for (int i = 0; i < 5; ++i) REQUIRE(b.try_acquire(requests(1)));
+  CHECK_FALSE(b.try_acquire(requests(1)));
+  manual_clock::advance(ns(10'000'000));
+  CHECK(b.try_acquire(requests(1)));
+  CHECK_FALSE(b.try_acquire(requests(1)));
+}
+
+TEST_CASE("token_bucket rejects amounts above its capacity", "[token_bucket]")
+{
+  token_bucket<requests, manual_clock> b(physical::si::frequency<physical::si::hertz, int>(1), requests(10));
+  // the cost of 2^34 requests does not fit the timestamps and must not wrap around
+  CHECK_FALSE(b.try_acquire(requests(1LL << 34)));
+  CHECK_FALSE(b.try_acquire(requests(11)));
+  CHECK(b.available().count() == 10);
+  CHECK(b.try_acquire(requests(10)));
+  CHECK_FALSE(b.try_acquire(requests(1)));
+}
+
+TEST_CASE("token_bucket costs wider than 64 bits in fixed point", "[token_bucket]")
+{
+  // 10'000 tokens at 1 ms each are 2^32 * 10^10 in the 32.32 fixed point
+  static_assert(detail::mul_shr32_ceil(10'000, 1'000'000ull << 32) == 10'000'000'000);
+  static_assert(detail::mul_shr32_ceil(3, (1ull << 32) + 1) == 4);
+  static_assert(detail::shl32_div(10'000'000'000, 1'000'000ull << 32) == 10'000);
+
+  token_bucket<requests, manual_clock> b(physical::si::frequency<physical::si::hertz, int>(1'000), requests(10'000));
+  CHECK(b.available().count() == 10'000);
+  REQUIRE(b.try_acquire(requests(10'000)));
+  CHECK(b.available().count() == 0);
+  CHECK(b.wait_time(requests(1'000)) == ns(1'000'000'000));
+  manual_clock::advance(ns(1'000'000'000));
+  CHECK(b.available().count() == 1'000);
+}
+
+TEST_CASE("token_bucket is safe to use from many threads", "[token_bucket]")
+{
+  constexpr int threads = 8;
+  token_bucket<requests, manual_clock> b(physical::si::frequency<physical::si::hertz, int>(1), requests(10'000));
+  std::atomic<int> granted{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t)
+    workers.emplace_back([&] {
+      for (int i = 0; i < 5'000; ++i)
+        if (b.try_acquire(requests(1))) granted.fetch_add(1, std::memory_order_relaxed);
+    });
+  for (auto& w : workers) w.join();
+  CHECK(granted == 10'000);
+}
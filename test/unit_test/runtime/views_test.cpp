@@ -0,0 +1,90 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "units/views.h"
+#include "units/physical/si/si.h"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <list>
+#include <ranges>
+#include <vector>
+
+using namespace units;
+using namespace units::physical;
+using namespace units::physical::si;
+
+TEST_CASE("views::as_quantity wraps numeric ranges", "[views]")
+{
+  std::vector<double> raw{1000., 2500., 3000.};
+
+  SECTION("contiguous ranges of the representation type are reinterpreted in place")
+  {
+    auto m = raw | views::as_quantity<length<metre>>;
+    static_assert(std::ranges::contiguous_range<decltype(m)>);
+    REQUIRE(m.size() == raw.size());
+    CHECK(static_cast<const void*>(m.data()) == static_cast<const void*>(raw.data()));
+    CHECK(m[1] == 2500._q_m);
+  }
+
+  SECTION("other ranges are converted on access")
+  {
+    const std::list<int> ints{1, 2, 3};
+    auto t = ints | views::as_quantity<si::time<second>>;
+    static_assert(std::ranges::bidirectional_range<decltype(t)> && std::ranges::sized_range<decltype(t)>);
+    CHECK(std::ranges::equal(t, std::vector{1._q_s, 2._q_s, 3._q_s}));
+  }
+}
+
+TEST_CASE("views::quantity_cast converts lazily", "[views]")
+{
+  std::vector<length<metre>> m{1000._q_m, 2500._q_m, 3000._q_m};
+
+  auto km = m | views::quantity_cast<kilometre>;
+  static_assert(std::ranges::random_access_range<decltype(km)> && std::ranges::sized_range<decltype(km)>);
+  static_assert(std::is_same_v<std::ranges::range_value_t<decltype(km)>, length<kilometre>>);
+  CHECK(std::ranges::equal(km, std::vector{1._q_km, 2.5_q_km, 3._q_km}));
+
+  auto cm = m | views::quantity_cast<length<centimetre, float>>;
+  static_assert(std::is_same_v<std::ranges::range_value_t<decltype(cm)>, length<centimetre, float>>);
+  CHECK(cm[2].count() == 300'000.f);
+
+  // the same type is passed through so contiguity is preserved
+  auto same = m | views::quantity_cast<metre>;
+  static_assert(std::ranges::contiguous_range<decltype(same)>);
+  CHECK(std::ranges::data(same) == m.data());
+
+  m[0] = 500._q_m;
+  CHECK(km[0] == 0.5_q_km);
+}
+
+TEST_CASE("views::strip_units exposes the values", "[views]")
+{
+  std::vector<speed<kilometre_per_hour>> v{36._q_km_per_h, 72._q_km_per_h};
+
+  auto values = v | views::strip_units;
+  static_assert(std::ranges::contiguous_range<decltype(values)>);
+  CHECK(static_cast<const void*>(values.data()) == static_cast<const void*>(v.data()));
+  CHECK(std::ranges::equal(values, std::vector{36., 72.}));
+
+  auto si_values = v | views::quantity_cast<metre_per_second> | views::strip_units;
+  CHECK(std::ranges::equal(si_values, std::vector{10., 20.}));
+}
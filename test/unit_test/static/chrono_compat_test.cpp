@@ -20,6 +20,7 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include <units/clock.h>
 #include <units/physical/si/base/time.h>
 #include <utility>
 
@@ -52,6 +53,15 @@ static_assert(same(from_chrono_duration(t3), time<millisecond, decltype(t3)::rep
 static_assert(same(from_chrono_duration<time<second, int>>(t3), time<second, int>{123456}));
 static_assert(same(from_chrono_duration<time<second>>(t3), time<second>{123456.789}));
 
+constexpr static auto qp1 = units::quantity_point(123456789_q_us);
+static_assert(to_chrono_time_point<std::chrono::system_clock>(qp1) == std::chrono::sys_time<std::chrono::microseconds>(std::chrono::microseconds{123456789}));
+static_assert(to_chrono_time_point<std::chrono::steady_clock, std::chrono::seconds>(qp1).time_since_epoch() == std::chrono::seconds{123});
+
+constexpr static auto tp1 = std::chrono::sys_time<std::chrono::milliseconds>(t3);
+static_assert(same(from_chrono_time_point(tp1).relative(), time<millisecond, decltype(t3)::rep>{123456789}));
+static_assert(same(from_chrono_time_point<units::clock::time_point>(tp1).relative(), time<nanosecond, std::int64_t>{123456789000000}));
+static_assert(from_chrono_time_point(to_chrono_time_point<std::chrono::system_clock>(qp1)) == qp1);
+
 }
 
 
@@ -0,0 +1,98 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "units/fixed_point.h"
+#include "test_tools.h"
+#include "units/physical/si/si.h"
+#include "units/physical/si/international/base/length.h"
+#include <cstdint>
+
+namespace {
+
+using namespace units;
+using namespace units::physical::si;
+
+using q8 = fixed_point<std::int32_t, 8>;
+using q16 = fixed_point<std::int32_t, 16>;
+
+// representation type requirements
+static_assert(ScalableNumber<q8>);
+static_assert(ScalableNumber<fixed_point<std::int64_t, 32>>);
+static_assert(!treat_as_floating_point<q8>);
+static_assert(sizeof(q8) == sizeof(std::int32_t));
+static_assert(sizeof(length<millimetre, q8>) == sizeof(std::int32_t));
+static_assert(sizeof(length<metre, q16>) == sizeof(std::int32_t));
+static_assert(sizeof(length<kilometre, q16>) == sizeof(std::int32_t));
+
+// construction and conversion
+static_assert(q8(3).raw() == 3 * 256);
+static_assert(q8(1.5).raw() == 384);
+static_assert(q8(-1.5).raw() == -384);
+static_assert(q8::from_raw(1).raw() == 1);
+static_assert(static_cast<double>(q8(2.25)) == 2.25);
+static_assert(static_cast<int>(q8(-2.75)) == -2);
+static_assert(q16(q8(1.5)) == q16(1.5));
+static_assert(q8(q16::from_raw(0x18001)) == q8(1.5));
+
+// arithmetic
+static_assert(q8(1.5) + q8(2) == q8(3.5));
+static_assert(q8(1.5) - q8(2) == q8(-0.5));
+static_assert(q8(1.5) * q8(-2) == q8(-3));
+static_assert(q8(3) / q8(2) == q8(1.5));
+static_assert(q8(1.5) * 3 == q8(4.5));
+static_assert(q8(4.5) / 3 == q8(1.5));
+static_assert(q8(1) < q8(1.5));
+static_assert(q8::from_raw(-1) * q8(0.5) == q8(0));  // truncation toward zero
+static_assert(fixed_point<std::int64_t, 32>(1e8) * fixed_point<std::int64_t, 32>(2.5) == fixed_point<std::int64_t, 32>(2.5e8));
+
+// common types
+static_assert(compare<std::common_type_t<q8, q16>, q16>);
+static_assert(compare<std::common_type_t<q8, int>, q8>);
+static_assert(compare<std::common_type_t<double, q8>, double>);
+
+// quantity_values
+static_assert(length<metre, q8>::zero().count() == q8(0));
+static_assert(length<metre, q8>::one().count() == q8(1));
+static_assert(length<metre, q8>::max().count().raw() == std::numeric_limits<std::int32_t>::max());
+
+// quantities
+static_assert(length<metre, q8>(q8(1.5)) + length<metre, q8>(q8(2)) == length<metre, q8>(q8(3.5)));
+static_assert((length<metre, q8>(q8(3)) * 2).count() == q8(6));
+static_assert(compare<decltype(length<metre, q8>() / physical::si::time<second, q8>()), speed<metre_per_second, q8>>);
+static_assert((length<metre, q8>(q8(3)) / physical::si::time<second, q8>(q8(2))).count() == q8(1.5));
+
+// unit conversions keep the fractional bits
+static_assert(quantity_cast<length<millimetre, q8>>(length<metre, q8>(q8(1.5))).count() == q8(1500));
+static_assert(quantity_cast<length<metre, q16>>(length<millimetre, q16>(q16(1500))).count() == q16(1.5));
+static_assert(quantity_cast<length<metre, q16>>(length<millimetre, q16>(q16(-250))).count() == q16(-0.25));
+static_assert(quantity_cast<length<kilometre, q16>>(length<metre, q16>(q16(1))).count() == q16::from_raw(65));  // 65.536 truncated
+static_assert(quantity_cast<length<metre, q16>>(length<international::foot, q16>(q16(1))).count() == q16::from_raw(19975));  // 0.3048 m
+static_assert(quantity_cast<length<millimetre, q8>>(length<metre, q8>(q8(1.5)) + length<millimetre, q8>(q8(1))).count() == q8(1501));
+static_assert(length<millimetre, q8>(length<metre, q8>(q8(1.5))).count() == q8(1500));
+
+// conversions from and to other representation types
+static_assert(quantity_cast<length<metre, q8>>(length<metre, int>(2)).count() == q8(2));
+static_assert(quantity_cast<length<metre, q8>>(length<metre>(2.5)).count() == q8(2.5));
+static_assert(quantity_cast<length<metre, double>>(length<metre, q8>(q8(2.5))).count() == 2.5);
+static_assert(quantity_cast<length<metre, double>>(length<millimetre, q8>(q8(250))).count() == 0.25);
+static_assert(quantity_cast<length<millimetre, q8>>(length<metre, int>(2)).count() == q8(2000));
+
+}  // namespace
@@ -21,13 +21,17 @@
 // SOFTWARE.
 
 #include "units/math.h"
+#include "units/trigonometry.h"
 #include "test_tools.h"
 #include "units/physical/si/si.h"
 #include "units/physical/si/international/international.h"
+#include <array>
 
 namespace {
 
 using namespace units;
+using namespace units::physical;
+using namespace units::literals;
 using namespace units::physical::si::literals;
 using namespace units::physical::si::international::literals;
 
@@ -39,5 +43,60 @@ static_assert(compare<decltype(pow<2>(2_q_ft)), decltype(4_q_ft2)>);
 static_assert(compare<decltype(sqrt(4_q_m2)), decltype(2_q_m)>);
 static_assert(compare<decltype(sqrt(4_q_km2)), decltype(2_q_km)>);
 static_assert(compare<decltype(sqrt(4_q_ft2)), decltype(2_q_ft)>);
+static_assert(compare<decltype(cbrt(8_q_m3)), decltype(2_q_m)>);
+static_assert(compare<decltype(cbrt(8_q_km3)), decltype(2_q_km)>);
+static_assert(compare<decltype(hypot(3_q_m, 4_q_m)), decltype(5_q_m)>);
+static_assert(compare<decltype(hypot(3_q_km, 4_q_m)), decltype(5_q_m)>);
+
+// constexpr evaluation
+static_assert(pow<3>(2_q_m) == 8_q_m3);
+static_assert(pow<2>(3._q_m) == 9._q_m2);
+static_assert(sqrt(16_q_m2) == 4_q_m);
+static_assert(sqrt(17_q_m2) == 4_q_m);
+static_assert(sqrt(2.25_q_m2) == 1.5_q_m);
+static_assert(units::detail::sqrt(2.) == 1.4142135623730951);
+static_assert(units::detail::sqrt(3.) == 1.7320508075688772);
+static_assert(units::detail::sqrt(0.5) == 0.7071067811865476);
+static_assert(units::detail::sqrt(10.) == 3.1622776601683795);
+static_assert(units::detail::sqrt(2.f) == 1.41421354f);
+static_assert(units::detail::sqrt(1e300) == 1e150);
+static_assert(cbrt(27_q_m3) == 3_q_m);
+static_assert(cbrt(3.375_q_m3) == 1.5_q_m);
+static_assert(hypot(3_q_m, 4_q_m) == 5_q_m);
+static_assert(hypot(3._q_km, 4000._q_m) == 5._q_km);
+static_assert(hypot(2._q_m, 4._q_m, 4._q_m) == 6._q_m);
+static_assert(fma(2_q_m, 3_q_m, 4_q_m2) == 10_q_m2);
+static_assert(fma(2._q_m, 3._q_m, 4._q_m2) == 10._q_m2);
+
+static_assert(floor<si::second>(1500_q_ms) == 1_q_s);
+static_assert(floor<si::second>(-1500_q_ms) == -2_q_s);
+static_assert(floor<si::second>(1.5_q_s) == 1._q_s);
+static_assert(floor<si::second>(-1.5_q_s) == -2._q_s);
+static_assert(ceil<si::second>(1500_q_ms) == 2_q_s);
+static_assert(ceil<si::second>(-1500_q_ms) == -1_q_s);
+static_assert(ceil<si::second>(1.5_q_s) == 2._q_s);
+static_assert(round<si::second>(1499_q_ms) == 1_q_s);
+static_assert(round<si::second>(1500_q_ms) == 2_q_s);
+static_assert(round<si::second>(2500_q_ms) == 2_q_s);
+static_assert(round<si::second>(2500._q_ms) == 3._q_s);
+static_assert(round<si::second>(-2500._q_ms) == -3._q_s);
+
+// compile-time lookup tables
+constexpr auto squares = [] {
+  std::array<si::area<si::square_metre, std::int64_t>, 4> table{};
+  for (std::int64_t i = 0; i < 4; ++i)
+    table[static_cast<std::size_t>(i)] = pow<2>(si::length<si::metre, std::int64_t>(i));
+  return table;
+}();
+static_assert(squares[3] == 9_q_m2);
+
+// trigonometry
+static_assert(compare<decltype(sin(1._q_rad)), dimensionless<one, long double>>);
+static_assert(compare<decltype(sin(1_q_deg)), dimensionless<one, double>>);
+static_assert(compare<decltype(asin(dimensionless<one>(1.))), angle<radian, double>>);
+static_assert(compare<decltype(atan2(1_q_m, 1_q_km)), angle<radian, double>>);
+static_assert(fast::sin(angle<radian>(0.)) == dimensionless<one>(0.));
+static_assert(fast::cos(angle<degree>(0.)) == dimensionless<one>(1.));
+static_assert(fast::atan2(0._q_m, 1._q_m) == angle<radian, long double>(0.));
 
 }  // namespace
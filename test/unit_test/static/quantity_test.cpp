@@ -24,7 +24,9 @@
 #include "units/math.h"
 #include "units/physical/si/si.h"
 #include "units/physical/si/us/us.h"
+#include "units/quantity_span.h"
 #include <chrono>
+#include <cstdint>
 #include <utility>
 
 namespace {
@@ -44,6 +46,16 @@ concept invalid_types = requires
 
 static_assert(invalid_types<dim_length>);
 
+// layout
+
+static_assert(std::is_standard_layout_v<length<metre, int>>);
+static_assert(std::is_standard_layout_v<length<metre, double>>);
+static_assert(std::is_trivially_copyable_v<length<metre, double>>);
+static_assert(sizeof(length<metre, int>) == sizeof(int));
+static_assert(sizeof(speed<kilometre_per_hour, double>) == sizeof(double));
+static_assert(alignof(length<metre, std::int8_t>) == alignof(std::int8_t));
+static_assert(detail::rep_layout_compatible<length<metre, float>>);
+
 // member types
 
 static_assert(is_same_v<length<metre, int>::rep, int>);